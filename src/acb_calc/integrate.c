@@ -9,6 +9,8 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
+#include "thread_support.h"
 #include "acb.h"
 #include "arb_calc.h"
 #include "acb_calc.h"
@@ -52,9 +54,9 @@ quad_simple(acb_t res, acb_calc_func_t f, void * param,
 }
 
 static void
-heap_up(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
+heap_up(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong * rs, slong n)
 {
-    slong i, max, l, r;
+    slong i, max, l, r, t;
     i = 0;
     for (;;)
     {
@@ -71,6 +73,7 @@ heap_up(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
             acb_swap(bs + i, bs + max);
             acb_swap(vs + i, vs + max);
             mag_swap(ms + i, ms + max);
+            t = rs[i]; rs[i] = rs[max]; rs[max] = t;
             i = max;
         }
         else
@@ -81,9 +84,9 @@ heap_up(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
 }
 
 static void
-heap_down(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
+heap_down(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong * rs, slong n)
 {
-    slong j, k;
+    slong j, k, t;
 
     k = n - 1;
     j = (k - 1) / 2;
@@ -94,6 +97,7 @@ heap_down(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
         acb_swap(bs + j, bs + k);
         acb_swap(vs + j, vs + k);
         mag_swap(ms + j, ms + k);
+        t = rs[j]; rs[j] = rs[k]; rs[k] = t;
         k = j;
         j = (j - 1) / 2;
     }
@@ -106,6 +110,202 @@ _acb_overlaps(acb_t tmp, const acb_t a, const acb_t b, slong prec)
     return acb_contains_zero(tmp);
 }
 
+/*
+    The expensive part of processing a subinterval is the Gauss-Legendre
+    attempt, and the crude estimates on both halves if it fails. This work
+    is done by _integrate_prefetch, which stores the results in a record
+    attached to the queue entry. Subintervals are otherwise taken from the
+    queue one at a time, and the sum, the tolerance, the evaluation count
+    and the queue are only updated by the calling thread.
+
+    With one thread, only the next subinterval is processed. With several
+    threads, other queued subintervals likely to be taken soon are processed
+    at the same time, using the current tolerance. The halves do not depend
+    on the tolerance, but a Gauss-Legendre attempt made with a tolerance
+    that has since been raised is made again, so the result does not depend
+    on the number of threads.
+*/
+
+typedef struct
+{
+    acb_srcptr as;
+    acb_srcptr bs;
+    acb_srcptr vs;
+    const slong * rs;   /* record of each queue entry, or -1 */
+    const slong * sel;  /* queue entries to process */
+    mag_ptr rtol;       /* tolerance used for the Gauss-Legendre attempt */
+    int * rstatus;
+    slong * rfeval;
+    acb_ptr rus;        /* Gauss-Legendre results */
+    int * rsplit;       /* whether the halves have been computed */
+    acb_ptr rcas;       /* halves [a, mid] and [mid, b], two per record */
+    acb_ptr rcbs;
+    acb_ptr rcvs;
+    mag_ptr rcms;
+    slong * rfree;
+    slong rnum_free;
+    slong ralloc;
+    acb_calc_func_t f;
+    void * param;
+    mag_srcptr tol;
+    slong deg_limit;
+    int verbose;
+    slong prec;
+}
+_integrate_prefetch_arg_t;
+
+static void
+_integrate_prefetch_worker(slong k, void * arg_ptr)
+{
+    _integrate_prefetch_arg_t * arg = (_integrate_prefetch_arg_t *) arg_ptr;
+    slong i = arg->sel[k];
+    slong r = arg->rs[i];
+    acb_srcptr a = arg->as + i;
+    acb_srcptr b = arg->bs + i;
+    slong prec = arg->prec;
+    int nw;
+
+    /* Keep nested parallelism off so that the outcome does not depend
+       on which thread handles the subinterval. */
+    nw = flint_set_num_workers(0);
+
+    /* Attempt using Gauss-Legendre rule. */
+    mag_set(arg->rtol + r, arg->tol);
+    arg->rstatus[r] = ARB_CALC_NO_CONVERGENCE;
+    arg->rfeval[r] = 0;
+
+    if (acb_is_finite(arg->vs + i))
+        arg->rstatus[r] = acb_calc_integrate_gl_auto_deg(arg->rus + r,
+            arg->rfeval + r, arg->f, arg->param, a, b, arg->tol,
+            arg->deg_limit, arg->verbose > 1, prec);
+
+    /* Evaluate on [a, mid] and [mid, b] for the bisection. */
+    if (arg->rstatus[r] != ARB_CALC_SUCCESS && !arg->rsplit[r])
+    {
+        acb_ptr ca = arg->rcas + 2 * r;
+        acb_ptr cb = arg->rcbs + 2 * r;
+        acb_ptr cv = arg->rcvs + 2 * r;
+        mag_ptr cm = arg->rcms + 2 * r;
+
+        acb_add(ca + 1, a, b, prec);
+        acb_mul_2exp_si(ca + 1, ca + 1, -1);
+        acb_set(ca, a);
+        acb_set(cb, ca + 1);
+        acb_set(cb + 1, b);
+
+        quad_simple(cv, arg->f, arg->param, ca, cb, prec);
+        mag_hypot(cm, arb_radref(acb_realref(cv)), arb_radref(acb_imagref(cv)));
+        quad_simple(cv + 1, arg->f, arg->param, ca + 1, cb + 1, prec);
+        mag_hypot(cm + 1, arb_radref(acb_realref(cv + 1)), arb_radref(acb_imagref(cv + 1)));
+
+        arg->rsplit[r] = 1;
+    }
+
+    flint_reset_num_workers(nw);
+}
+
+/* ensures that at least len records are free */
+static void
+_integrate_fit_records(_integrate_prefetch_arg_t * arg, slong len)
+{
+    slong j, alloc, new_alloc;
+
+    if (arg->rnum_free >= len)
+        return;
+
+    alloc = arg->ralloc;
+    new_alloc = FLINT_MAX(2 * alloc, alloc + len);
+
+    arg->rtol = flint_realloc(arg->rtol, new_alloc * sizeof(mag_struct));
+    arg->rstatus = flint_realloc(arg->rstatus, new_alloc * sizeof(int));
+    arg->rfeval = flint_realloc(arg->rfeval, new_alloc * sizeof(slong));
+    arg->rus = flint_realloc(arg->rus, new_alloc * sizeof(acb_struct));
+    arg->rsplit = flint_realloc(arg->rsplit, new_alloc * sizeof(int));
+    arg->rcas = flint_realloc(arg->rcas, 2 * new_alloc * sizeof(acb_struct));
+    arg->rcbs = flint_realloc(arg->rcbs, 2 * new_alloc * sizeof(acb_struct));
+    arg->rcvs = flint_realloc(arg->rcvs, 2 * new_alloc * sizeof(acb_struct));
+    arg->rcms = flint_realloc(arg->rcms, 2 * new_alloc * sizeof(mag_struct));
+    arg->rfree = flint_realloc(arg->rfree, new_alloc * sizeof(slong));
+
+    for (j = alloc; j < new_alloc; j++)
+    {
+        mag_init(arg->rtol + j);
+        acb_init(arg->rus + j);
+        arg->rsplit[j] = 0;
+        acb_init(arg->rcas + 2 * j);
+        acb_init(arg->rcas + 2 * j + 1);
+        acb_init(arg->rcbs + 2 * j);
+        acb_init(arg->rcbs + 2 * j + 1);
+        acb_init(arg->rcvs + 2 * j);
+        acb_init(arg->rcvs + 2 * j + 1);
+        mag_init(arg->rcms + 2 * j);
+        mag_init(arg->rcms + 2 * j + 1);
+        arg->rfree[arg->rnum_free++] = j;
+    }
+
+    arg->ralloc = new_alloc;
+}
+
+static void
+_integrate_release_record(_integrate_prefetch_arg_t * arg, slong * rs, slong i)
+{
+    if (rs[i] != -1)
+    {
+        arg->rsplit[rs[i]] = 0;
+        arg->rfree[arg->rnum_free++] = rs[i];
+        rs[i] = -1;
+    }
+}
+
+/* Processes the queue entry top with the current tolerance, unless this
+   has been done already, together with up to num - 1 other queue entries
+   in the order in which they are likely to be taken. Returns the record
+   of top. */
+static slong
+_integrate_prefetch(_integrate_prefetch_arg_t * arg, slong * sel,
+    acb_srcptr as, acb_srcptr bs, acb_srcptr vs, mag_srcptr ms, slong * rs,
+    slong top, slong depth, int use_heap, slong num, acb_t tmp)
+{
+    slong i, j, r, nb;
+
+    r = rs[top];
+    if (r != -1 && (!acb_is_finite(vs + top) || mag_equal(arg->rtol + r, arg->tol)))
+        return r;
+
+    _integrate_fit_records(arg, num);
+
+    for (j = nb = 0; j < depth && nb < num; j++)
+    {
+        i = use_heap ? j : depth - 1 - j;
+
+        if (mag_cmp(ms + i, arg->tol) < 0 ||
+            _acb_overlaps(tmp, as + i, bs + i, arg->prec))
+            continue;
+
+        r = rs[i];
+        if (r != -1 && (!acb_is_finite(vs + i) || mag_equal(arg->rtol + r, arg->tol)))
+            continue;
+
+        if (r == -1)
+            rs[i] = arg->rfree[--arg->rnum_free];
+
+        sel[nb++] = i;
+    }
+
+    arg->as = as;
+    arg->bs = bs;
+    arg->vs = vs;
+    arg->rs = rs;
+    arg->sel = sel;
+
+    if (nb == 1)
+        _integrate_prefetch_worker(0, arg);
+    else
+        flint_parallel_do(_integrate_prefetch_worker, arg, nb, -1, FLINT_PARALLEL_STRIDED);
+
+    return rs[top];
+}
+
 int
 acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     const acb_t a, const acb_t b,
@@ -113,15 +313,18 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     const acb_calc_integrate_opt_t options,
     slong prec)
 {
+    _integrate_prefetch_arg_t arg;
     acb_ptr as, bs, vs;
     mag_ptr ms;
-    acb_t s, t, u;
-    mag_t tmpm, tmpn, new_tol;
+    slong * rs;
+    slong * sel;
+    acb_t s, u;
+    mag_t tmpm, new_tol;
     slong depth_limit, eval_limit, deg_limit;
-    slong depth, depth_max, eval, feval, top;
+    slong depth, depth_max, eval, top, r, j, num;
     slong leaf_interval_count;
     slong alloc;
-    int stopping, real_error, use_heap, status, gl_status, verbose;
+    int stopping, real_error, use_heap, status, verbose;
 
     if (options == NULL)
     {
@@ -132,13 +335,6 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
 
     status = ARB_CALC_SUCCESS;
 
-    acb_init(s);
-    acb_init(t);
-    acb_init(u);
-    mag_init(tmpm);
-    mag_init(tmpn);
-    mag_init(new_tol);
-
     depth_limit = options->depth_limit;
     if (depth_limit <= 0)
         depth_limit = 2 * prec;
@@ -157,11 +353,31 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     verbose = options->verbose;
     use_heap = options->use_heap;
 
+    num = flint_get_num_threads();
+
+    acb_init(s);
+    acb_init(u);
+    mag_init(tmpm);
+    mag_init(new_tol);
+
+    memset(&arg, 0, sizeof(arg));
+    arg.f = f;
+    arg.param = param;
+    arg.tol = new_tol;
+    arg.deg_limit = deg_limit;
+    arg.verbose = verbose;
+    arg.prec = prec;
+
+    sel = flint_malloc(num * sizeof(slong));
+
     alloc = 4;
     as = _acb_vec_init(alloc);
     bs = _acb_vec_init(alloc);
     vs = _acb_vec_init(alloc);
     ms = _mag_vec_init(alloc);
+    rs = flint_malloc(alloc * sizeof(slong));
+    for (j = 0; j < alloc; j++)
+        rs[j] = -1;
 
     /* Compute initial crude estimate for the whole interval. */
     acb_set(as, a);
@@ -179,8 +395,6 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     mag_mul_2exp_si(tmpm, tmpm, -goal);
     mag_max(new_tol, tol, tmpm);
 
-    acb_zero(s);
-
     while (depth >= 1)
     {
         if (stopping == 0 && eval >= eval_limit - 1)
@@ -204,6 +418,7 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
             acb_add(s, s, vs + top, prec);
             leaf_interval_count++;
 
+            _integrate_release_record(&arg, rs, top);
             depth--;
             if (use_heap && depth > 0)
             {
@@ -211,21 +426,26 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
                 acb_swap(bs, bs + depth);
                 acb_swap(vs, vs + depth);
                 mag_swap(ms, ms + depth);
-                heap_up(as, bs, vs, ms, depth);
+                rs[0] = rs[depth];
+                rs[depth] = -1;
+                heap_up(as, bs, vs, ms, rs, depth);
             }
             continue;
         }
 
-        /* Attempt using Gauss-Legendre rule. */
+        r = _integrate_prefetch(&arg, sel, as, bs, vs, ms, rs,
+            top, depth, use_heap, num, u);
+
+        /* Gauss-Legendre rule. */
         if (acb_is_finite(vs + top))
         {
-            gl_status = acb_calc_integrate_gl_auto_deg(u, &feval, f, param,
-                as + top, bs + top, new_tol, deg_limit, verbose > 1, prec);
-            eval += feval;
+            eval += arg.rfeval[r];
 
             /* We are done with this subinterval. */
-            if (gl_status == ARB_CALC_SUCCESS)
+            if (arg.rstatus[r] == ARB_CALC_SUCCESS)
             {
+                acb_swap(u, arg.rus + r);
+
                 /* We know that the result is real. */
                 real_error = acb_is_finite(vs + top) && acb_is_real(vs + top);
 
@@ -240,6 +460,7 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
                 mag_mul_2exp_si(tmpm, tmpm, -goal);
                 mag_max(new_tol, new_tol, tmpm);
 
+                _integrate_release_record(&arg, rs, top);
                 depth--;
                 if (use_heap && depth > 0)
                 {
@@ -247,7 +468,9 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
                     acb_swap(bs, bs + depth);
                     acb_swap(vs, vs + depth);
                     mag_swap(ms, ms + depth);
-                    heap_up(as, bs, vs, ms, depth);
+                    rs[0] = rs[depth];
+                    rs[depth] = -1;
+                    heap_up(as, bs, vs, ms, rs, depth);
                 }
                 continue;
             }
@@ -264,44 +487,39 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
 
         if (depth >= alloc - 1)
         {
-            slong k;
             as = flint_realloc(as, 2 * alloc * sizeof(acb_struct));
             bs = flint_realloc(bs, 2 * alloc * sizeof(acb_struct));
             vs = flint_realloc(vs, 2 * alloc * sizeof(acb_struct));
             ms = flint_realloc(ms, 2 * alloc * sizeof(mag_struct));
-            for (k = alloc; k < 2 * alloc; k++)
+            rs = flint_realloc(rs, 2 * alloc * sizeof(slong));
+            for (j = alloc; j < 2 * alloc; j++)
             {
-                acb_init(as + k);
-                acb_init(bs + k);
-                acb_init(vs + k);
-                mag_init(ms + k);
+                acb_init(as + j);
+                acb_init(bs + j);
+                acb_init(vs + j);
+                mag_init(ms + j);
+                rs[j] = -1;
             }
             alloc *= 2;
         }
 
-        /* Bisection. */
-        /* Interval [depth] becomes [mid, b]. */
-        acb_set(bs + depth, bs + top);
-        acb_add(as + depth, as + top, bs + top, prec);
-        acb_mul_2exp_si(as + depth, as + depth, -1);
-
-        /* Interval [top] becomes [a, mid]. */
-        acb_set(bs + top, as + depth);
-
-        /* Evaluate on [a, mid] */
-        quad_simple(vs + top, f, param, as + top, bs + top, prec);
-        mag_hypot(ms + top, arb_radref(acb_realref(vs + top)), arb_radref(acb_imagref(vs + top)));
-        eval++;
+        /* Bisection, using the halves computed above. */
+        /* Interval [top] becomes [a, mid] and interval [depth] becomes [mid, b]. */
+        acb_swap(as + top, arg.rcas + 2 * r);
+        acb_swap(bs + top, arg.rcbs + 2 * r);
+        acb_swap(vs + top, arg.rcvs + 2 * r);
+        mag_swap(ms + top, arg.rcms + 2 * r);
+        acb_swap(as + depth, arg.rcas + 2 * r + 1);
+        acb_swap(bs + depth, arg.rcbs + 2 * r + 1);
+        acb_swap(vs + depth, arg.rcvs + 2 * r + 1);
+        mag_swap(ms + depth, arg.rcms + 2 * r + 1);
+        _integrate_release_record(&arg, rs, top);
+
+        eval += 2;
         /* Adjust absolute tolerance based on new information. */
         acb_get_mag_lower(tmpm, vs + top);
         mag_mul_2exp_si(tmpm, tmpm, -goal);
         mag_max(new_tol, new_tol, tmpm);
-
-        /* Evaluate on [mid, b] */
-        quad_simple(vs + depth, f, param, as + depth, bs + depth, prec);
-        mag_hypot(ms + depth, arb_radref(acb_realref(vs + depth)), arb_radref(acb_imagref(vs + depth)));
-        eval++;
-        /* Adjust absolute tolerance based on new information. */
         acb_get_mag_lower(tmpm, vs + depth);
         mag_mul_2exp_si(tmpm, tmpm, -goal);
         mag_max(new_tol, new_tol, tmpm);
@@ -317,8 +535,8 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
 
         if (use_heap)
         {
-            heap_up(as, bs, vs, ms, depth);
-            heap_down(as, bs, vs, ms, depth + 1);
+            heap_up(as, bs, vs, ms, rs, depth);
+            heap_down(as, bs, vs, ms, rs, depth + 1);
         }
 
         depth++;
@@ -337,13 +555,24 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     _acb_vec_clear(bs, alloc);
     _acb_vec_clear(vs, alloc);
     _mag_vec_clear(ms, alloc);
+    flint_free(rs);
+    flint_free(sel);
+
+    _mag_vec_clear(arg.rtol, arg.ralloc);
+    _acb_vec_clear(arg.rus, arg.ralloc);
+    _acb_vec_clear(arg.rcas, 2 * arg.ralloc);
+    _acb_vec_clear(arg.rcbs, 2 * arg.ralloc);
+    _acb_vec_clear(arg.rcvs, 2 * arg.ralloc);
+    _mag_vec_clear(arg.rcms, 2 * arg.ralloc);
+    flint_free(arg.rstatus);
+    flint_free(arg.rfeval);
+    flint_free(arg.rsplit);
+    flint_free(arg.rfree);
+
     acb_clear(s);
-    acb_clear(t);
     acb_clear(u);
     mag_clear(tmpm);
-    mag_clear(tmpn);
     mag_clear(new_tol);
 
     return status;
 }
-
@@ -81,71 +81,133 @@ nodes_worker(slong jj, nodes_work_t * work)
     arb_hypgeom_legendre_p_ui_root(work->nodes + jj, work->weights + jj, work->n, jj, work->wp);
 }
 
-/* if k >= 0, compute the node and weight of index k */
-/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
-void
-acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+/* Extra bits kept in the cache beyond the requested precision. */
+#define GL_GUARD_BITS 30
+
+static void
+gl_compute(slong i, slong wp)
 {
-    slong n, kk, wp;
-    int all;
+    nodes_work_t work;
+    slong n = gl_steps[i];
 
-    if (i < 0 || i >= GL_STEPS || prec < 2)
-        flint_abort();
+    if (gl_cache->gl_prec[i] == 0)
+    {
+        gl_cache->gl_nodes[i] = _arb_vec_init((n + 1) / 2);
+        gl_cache->gl_weights[i] = _arb_vec_init((n + 1) / 2);
+    }
 
-    if (gl_cache == NULL)
-        gl_init();
+    work.nodes = gl_cache->gl_nodes[i];
+    work.weights = gl_cache->gl_weights[i];
+    work.n = n;
+    work.wp = wp;
 
-    n = gl_steps[i];
+    flint_parallel_do((do_func_t) nodes_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_STRIDED);
 
-    if (k >= n)
-        flint_abort();
+    gl_cache->gl_prec[i] = wp;
+}
 
-    all = (k < 0);
+/*
+    Sets y to the exact value enclosed by x rounded to nearest at prec bits,
+    with a radius of one ulp (or zero if x is exact). Returns 0 if x is too
+    wide to determine the rounding. The result does not depend on the
+    precision x was computed with, so that the nodes are the same
+    regardless of the state of the cache, which is local to each thread.
+*/
+static int
+gl_round(arb_t y, const arb_t x, slong prec)
+{
+    arf_t t, lo, hi;
+    int ok;
 
-    if (gl_cache->gl_prec[i] < prec)
+    if (mag_is_zero(arb_radref(x)))
     {
-        nodes_work_t work;
-
-        if (gl_cache->gl_prec[i] == 0)
-        {
-            gl_cache->gl_nodes[i] = _arb_vec_init((n + 1) / 2);
-            gl_cache->gl_weights[i] = _arb_vec_init((n + 1) / 2);
-        }
+        arb_set_round(y, x, prec);
+        return 1;
+    }
 
-        wp = FLINT_MAX(prec, gl_cache->gl_prec[i] * 2 + 30);
+    arf_init(t);
+    arf_init(lo);
+    arf_init(hi);
 
-        work.nodes = gl_cache->gl_nodes[i];
-        work.weights = gl_cache->gl_weights[i];
-        work.n = n;
-        work.wp = wp;
+    arf_set_mag(t, arb_radref(x));
+    arf_sub(lo, arb_midref(x), t, prec, ARF_RND_NEAR);
+    arf_add(hi, arb_midref(x), t, prec, ARF_RND_NEAR);
 
-        flint_parallel_do((do_func_t) nodes_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_STRIDED);
+    ok = arf_equal(lo, hi);
 
-        gl_cache->gl_prec[i] = wp;
+    if (ok)
+    {
+        arf_swap(arb_midref(y), lo);
+        arf_mag_set_ulp(arb_radref(y), arb_midref(y), prec);
     }
 
-    if (all)
+    arf_clear(t);
+    arf_clear(lo);
+    arf_clear(hi);
+
+    return ok;
+}
+
+static int
+gl_get(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+{
+    slong n, kk;
+
+    n = gl_steps[i];
+
+    /* if k < 0, get the first (n+1)/2 nodes and weights */
+    if (k < 0)
     {
         for (k = 0; k < (n + 1) / 2; k++)
         {
-            arb_set_round(x + k, gl_cache->gl_nodes[i] + k, prec);
-            arb_set_round(w + k, gl_cache->gl_weights[i] + k, prec);
+            if (!gl_round(x + k, gl_cache->gl_nodes[i] + k, prec) ||
+                !gl_round(w + k, gl_cache->gl_weights[i] + k, prec))
+                return 0;
         }
+
+        return 1;
     }
+
+    if (2 * k < n)
+        kk = k;
     else
-    {
-        if (2 * k < n)
-            kk = k;
-        else
-            kk = n - 1 - k;
+        kk = n - 1 - k;
 
-        if (2 * k < n)
-            arb_set_round(x, gl_cache->gl_nodes[i] + kk, prec);
-        else
-            arb_neg_round(x, gl_cache->gl_nodes[i] + kk, prec);
+    if (!gl_round(x, gl_cache->gl_nodes[i] + kk, prec) ||
+        !gl_round(w, gl_cache->gl_weights[i] + kk, prec))
+        return 0;
 
-        arb_set_round(w, gl_cache->gl_weights[i] + kk, prec);
-    }
+    if (2 * k >= n)
+        arb_neg(x, x);
+
+    return 1;
+}
+
+/* if k >= 0, compute the node and weight of index k */
+/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
+void
+acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+{
+    slong n;
+
+    if (i < 0 || i >= GL_STEPS || prec < 2)
+        flint_abort();
+
+    if (gl_cache == NULL)
+        gl_init();
+
+    n = gl_steps[i];
+
+    if (k >= n)
+        flint_abort();
+
+    if (gl_cache->gl_prec[i] < prec + GL_GUARD_BITS)
+        gl_compute(i, FLINT_MAX(prec + GL_GUARD_BITS, gl_cache->gl_prec[i] * 2 + 30));
+
+    /* In the rare event that a cached value is too close to a rounding
+       boundary, recompute at higher precision. */
+    while (!gl_get(x, w, i, k, prec))
+        gl_compute(i, gl_cache->gl_prec[i] * 2 + 30);
 }
 
 typedef struct
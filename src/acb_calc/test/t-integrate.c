@@ -497,6 +497,78 @@ int main(void)
         mag_clear(tol);
     }
 
+    /* the result must not depend on the number of threads */
+    for (iter = 0; iter < 100 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        acb_t a, b, res1, res2;
+        slong goal, prec;
+        mag_t tol;
+        acb_calc_integrate_opt_t opt;
+        acb_calc_func_t f;
+        int status1, status2, integral;
+
+        acb_init(a);
+        acb_init(b);
+        acb_init(res1);
+        acb_init(res2);
+        mag_init(tol);
+        acb_calc_integrate_opt_init(opt);
+
+        goal = 2 + n_randint(state, 200);
+        prec = 2 + n_randint(state, 200);
+        mag_set_ui_2exp_si(tol, n_randint(state, 2), -(slong) n_randint(state, 200));
+
+        if (n_randint(state, 2))
+            opt->eval_limit = n_randint(state, 2000);
+
+        if (n_randint(state, 2))
+            opt->depth_limit = n_randint(state, 100);
+
+        opt->use_heap = n_randint(state, 2);
+
+        integral = n_randint(state, 4);
+
+        if (integral == 0)
+        {
+            acb_randtest(a, state, 1 + n_randint(state, 200), 2);
+            acb_randtest(b, state, 1 + n_randint(state, 200), 2);
+            f = f_sin;
+        }
+        else
+        {
+            acb_zero(a);
+            acb_one(b);
+            if (integral == 1)
+                f = f_helfgott;
+            else if (integral == 2)
+                f = f_spike;
+            else
+                f = f_essing2;
+        }
+
+        flint_set_num_threads(1);
+        status1 = acb_calc_integrate(res1, f, NULL, a, b, goal, tol, opt, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 3));
+        status2 = acb_calc_integrate(res2, f, NULL, a, b, goal, tol, opt, prec);
+
+        if (status1 != status2 || !acb_equal(res1, res2))
+        {
+            flint_printf("FAIL (threads, iter = %wd)\n", iter);
+            flint_printf("integral = %d, prec = %wd, goal = %wd\n", integral, prec, goal);
+            flint_printf("status1 = %d, status2 = %d\n", status1, status2);
+            flint_printf("res1 = "); acb_printd(res1, 30); flint_printf("\n\n");
+            flint_printf("res2 = "); acb_printd(res2, 30); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(res1);
+        acb_clear(res2);
+        mag_clear(tol);
+    }
+
     /* more tests for the individual real extensions and branched functions */
     {
         acb_t a, b, z, w;
@@ -151,6 +151,16 @@ acb_dft_pre_struct;
 
 typedef acb_dft_pre_struct acb_dft_pre_t[1];
 
+typedef struct
+{
+    slong n;
+    acb_ptr z; /* z[k] = e(-k/n) for k < n/2, if n is even */
+    acb_dft_pre_t pre; /* complex DFT of length n/2 if n is even, else n */
+}
+acb_dft_real_struct;
+
+typedef acb_dft_real_struct acb_dft_real_t[1];
+
 /* covers both product and cyclic case */
 struct
 acb_dft_step_struct
@@ -182,6 +192,8 @@ void acb_dft_step(acb_ptr w, acb_srcptr v, acb_dft_step_ptr cyc, slong num, slon
 
 void acb_dft_precomp(acb_ptr w, acb_srcptr v, const acb_dft_pre_t pre, slong prec);
 void acb_dft_inverse_precomp(acb_ptr w, acb_srcptr v, const acb_dft_pre_t pre, slong prec);
+void acb_dft_precomp_vec(acb_ptr w, acb_srcptr v, slong num, const acb_dft_pre_t pre, slong prec);
+void acb_dft_inverse_precomp_vec(acb_ptr w, acb_srcptr v, slong num, const acb_dft_pre_t pre, slong prec);
 void acb_dft_naive_precomp(acb_ptr w, acb_srcptr v, const acb_dft_naive_t pol, slong prec);
 void acb_dft_cyc_precomp(acb_ptr w, acb_srcptr v, const acb_dft_cyc_t cyc, slong prec);
 
@@ -204,6 +216,11 @@ void acb_dft_precomp_clear(acb_dft_pre_t pre);
 void acb_dft(acb_ptr w, acb_srcptr v, slong len, slong prec);
 void acb_dft_inverse(acb_ptr w, acb_srcptr v, slong len, slong prec);
 
+void acb_dft_real_init(acb_dft_real_t t, slong len, slong prec);
+void acb_dft_real_clear(acb_dft_real_t t);
+void acb_dft_real_precomp(acb_ptr w, arb_srcptr v, const acb_dft_real_t t, slong prec);
+void acb_dft_real(acb_ptr w, arb_srcptr v, slong len, slong prec);
+
 acb_dft_step_ptr _acb_dft_steps_prod(slong * m, slong num, slong prec);
 
 ACB_DFT_INLINE void
@@ -137,7 +137,7 @@ acb_dft_bluestein_precomp(acb_ptr w, acb_srcptr v, const acb_dft_bluestein_t t,
 
     _acb_vec_kronecker_mul(w, t->z, fp, n, prec);
 
-    _acb_vec_clear(fp, n);
+    _acb_vec_clear(fp, np);
 }
 
 void
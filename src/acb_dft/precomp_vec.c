@@ -0,0 +1,69 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "acb_dft.h"
+
+typedef struct
+{
+    acb_ptr w;
+    acb_srcptr v;
+    const acb_dft_pre_struct * pre;
+    int inverse;
+    slong prec;
+}
+_vec_arg_t;
+
+static void
+_acb_dft_precomp_vec_worker(slong i, void * arg_ptr)
+{
+    _vec_arg_t * arg = (_vec_arg_t *) arg_ptr;
+    slong n = arg->pre->n;
+
+    if (arg->inverse)
+        acb_dft_inverse_precomp(arg->w + i * n, arg->v + i * n, arg->pre, arg->prec);
+    else
+        acb_dft_precomp(arg->w + i * n, arg->v + i * n, arg->pre, arg->prec);
+}
+
+static void
+_acb_dft_precomp_vec(acb_ptr w, acb_srcptr v, slong num, const acb_dft_pre_t pre, int inverse, slong prec)
+{
+    _vec_arg_t arg;
+
+    arg.w = w;
+    arg.v = v;
+    arg.pre = pre;
+    arg.inverse = inverse;
+    arg.prec = prec;
+
+    /* with fewer vectors than threads, thread each transform instead */
+    if (num < flint_get_num_threads())
+    {
+        slong i;
+        for (i = 0; i < num; i++)
+            _acb_dft_precomp_vec_worker(i, &arg);
+    }
+    else
+    {
+        flint_parallel_do(_acb_dft_precomp_vec_worker, &arg, num, -1, FLINT_PARALLEL_UNIFORM);
+    }
+}
+
+void
+acb_dft_precomp_vec(acb_ptr w, acb_srcptr v, slong num, const acb_dft_pre_t pre, slong prec)
+{
+    _acb_dft_precomp_vec(w, v, num, pre, 0, prec);
+}
+
+void
+acb_dft_inverse_precomp_vec(acb_ptr w, acb_srcptr v, slong num, const acb_dft_pre_t pre, slong prec)
+{
+    _acb_dft_precomp_vec(w, v, num, pre, 1, prec);
+}
@@ -0,0 +1,111 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "acb_dft.h"
+
+/*
+    For n = 2h, the real sequence v is packed as u_j = v_{2j} + i v_{2j+1}
+    and transformed with a complex DFT of length h. With U = DFT(u),
+
+        w_k = (U_k + conj(U_{h-k})) / 2 - i e(-k/n) (U_k - conj(U_{h-k})) / 2
+
+    for 0 < k < h, and w_{n-k} = conj(w_k) since v is real.
+*/
+
+void
+acb_dft_real_init(acb_dft_real_t t, slong len, slong prec)
+{
+    t->n = len;
+
+    if (len % 2 == 0 && len > 0)
+    {
+        t->z = _acb_vec_init(len / 2);
+        _acb_vec_unit_roots(t->z, -len, len / 2, prec);
+        acb_dft_precomp_init(t->pre, len / 2, prec);
+    }
+    else
+    {
+        t->z = NULL;
+        acb_dft_precomp_init(t->pre, len, prec);
+    }
+}
+
+void
+acb_dft_real_clear(acb_dft_real_t t)
+{
+    if (t->z != NULL)
+        _acb_vec_clear(t->z, t->n / 2);
+    acb_dft_precomp_clear(t->pre);
+}
+
+void
+acb_dft_real_precomp(acb_ptr w, arb_srcptr v, const acb_dft_real_t t, slong prec)
+{
+    slong j, k, n = t->n, h;
+    acb_ptr u;
+    acb_t a, b;
+
+    if (n == 0)
+        return;
+
+    if (t->z == NULL)
+    {
+        u = _acb_vec_init(n);
+        for (j = 0; j < n; j++)
+            arb_set(acb_realref(u + j), v + j);
+        acb_dft_precomp(w, u, t->pre, prec);
+        _acb_vec_clear(u, n);
+        return;
+    }
+
+    h = n / 2;
+    u = _acb_vec_init(h);
+    acb_init(a);
+    acb_init(b);
+
+    for (j = 0; j < h; j++)
+    {
+        arb_set(acb_realref(u + j), v + 2 * j);
+        arb_set(acb_imagref(u + j), v + 2 * j + 1);
+    }
+
+    acb_dft_precomp(u, u, t->pre, prec);
+
+    for (k = 1; k < h; k++)
+    {
+        acb_conj(b, u + h - k);
+        acb_sub(a, u + k, b, prec);
+        acb_div_onei(a, a);
+        acb_mul(a, a, t->z + k, prec);
+        acb_add(b, u + k, b, prec);
+        acb_add(w + k, a, b, prec);
+        acb_mul_2exp_si(w + k, w + k, -1);
+    }
+
+    arb_add(acb_realref(w), acb_realref(u), acb_imagref(u), prec);
+    arb_sub(acb_realref(w + h), acb_realref(u), acb_imagref(u), prec);
+    arb_zero(acb_imagref(w));
+    arb_zero(acb_imagref(w + h));
+
+    for (k = 1; k < h; k++)
+        acb_conj(w + n - k, w + k);
+
+    _acb_vec_clear(u, h);
+    acb_clear(a);
+    acb_clear(b);
+}
+
+void
+acb_dft_real(acb_ptr w, arb_srcptr v, slong len, slong prec)
+{
+    acb_dft_real_t t;
+    acb_dft_real_init(t, len, prec);
+    acb_dft_real_precomp(w, v, t, prec);
+    acb_dft_real_clear(t);
+}
@@ -9,10 +9,58 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb_dft.h"
 
 #define REORDER 0
 
+/* below this length, the sub-DFT are done in a plain loop */
+#define DFT_THREAD_CUTOFF 256
+
+typedef struct
+{
+    acb_ptr w;
+    acb_srcptr v;
+    acb_ptr t;
+    acb_dft_step_ptr cyc;
+    slong num;
+    slong prec;
+}
+_step_arg_t;
+
+/* DFT of size M on the i-th coset, followed by its twiddle factors */
+static void
+_acb_dft_step_coset(slong i, void * arg_ptr)
+{
+    _step_arg_t * arg = (_step_arg_t *) arg_ptr;
+    acb_dft_step_struct c = arg->cyc[0];
+    acb_ptr wi = arg->w + i * c.M;
+    slong j;
+
+    acb_dft_step(wi, arg->v + i * c.dv, arg->cyc + 1, arg->num - 1, arg->prec);
+
+    /* twiddle if non trivial product */
+    if (c.z != NULL && i > 0)
+    {
+        for (j = 1; j < c.M; j++)
+        {
+            if (DFT_VERB)
+                flint_printf("z[%wu*%wu]", c.dz, i * j);
+            acb_mul(wi + j, wi + j, c.z + c.dz * i * j, arg->prec);
+        }
+    }
+}
+
+/* DFT of size m on the j-th restriction */
+static void
+_acb_dft_step_quotient(slong j, void * arg_ptr)
+{
+    _step_arg_t * arg = (_step_arg_t *) arg_ptr;
+    acb_dft_step_struct c = arg->cyc[0];
+
+    acb_dft_precomp(arg->t + c.m * j, arg->w + j, c.pre, arg->prec);
+}
+
 void
 acb_dft_step(acb_ptr w, acb_srcptr v, acb_dft_step_ptr cyc, slong num, slong prec)
 {
@@ -28,8 +76,9 @@ acb_dft_step(acb_ptr w, acb_srcptr v, acb_dft_step_ptr cyc, slong num, slong pre
     else
     {
         slong i, j;
-        slong m = c.m, M = c.M, dv = c.dv, dz = c.dz;
-        acb_srcptr z = c.z;
+        slong m = c.m, M = c.M;
+        int thread_limit;
+        _step_arg_t arg;
         acb_ptr t;
 #if REORDER
         acb_ptr w2;
@@ -43,24 +92,22 @@ acb_dft_step(acb_ptr w, acb_srcptr v, acb_dft_step_ptr cyc, slong num, slong pre
             v = t;
         }
 
-        /* m DFT of size M */
-        for (i = 0; i < m; i++)
-            acb_dft_step(w + i * M, v + i * dv, cyc + 1, num - 1, prec);
+        /* the sub-DFT are independent; nested calls get no more
+           threads and run serially */
+        thread_limit = (m * M >= DFT_THREAD_CUTOFF) ? -1 : 1;
 
-        /* twiddle if non trivial product */
-        if (c.z != NULL)
-        {
-            acb_ptr wi;
-            for (wi = w + M, i = 1; i < m; i++, wi += M)
-                for (j = 1; j < M; j++)
-                {
-                    if (DFT_VERB)
-                        flint_printf("z[%wu*%wu]",dz,i*j);
-                    acb_mul(wi + j, wi + j, z + dz * i * j, prec);
-                }
-            if (DFT_VERB)
-                flint_printf("\n");
-        }
+        arg.w = w;
+        arg.v = v;
+        arg.t = t;
+        arg.cyc = cyc;
+        arg.num = num;
+        arg.prec = prec;
+
+        /* m DFT of size M, then twiddle */
+        flint_parallel_do(_acb_dft_step_coset, &arg, m, thread_limit, FLINT_PARALLEL_STRIDED);
+
+        if (DFT_VERB && c.z != NULL)
+            flint_printf("\n");
 
 #if REORDER
         /* reorder w to avoid dv shifts in next DFT */
@@ -71,8 +118,7 @@ acb_dft_step(acb_ptr w, acb_srcptr v, acb_dft_step_ptr cyc, slong num, slong pre
 #endif
 
         /* M DFT of size m */
-        for (j = 0; j < M; j++)
-            acb_dft_precomp(t + m * j, w + j, c.pre, prec);
+        flint_parallel_do(_acb_dft_step_quotient, &arg, M, thread_limit, FLINT_PARALLEL_STRIDED);
 
         /* reorder */
         for (i = 0; i < m; i++)
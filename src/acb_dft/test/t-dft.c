@@ -90,6 +90,8 @@ int main(void)
         /* avoid naive for long transforms */
         f0 = (len > 50);
 
+        flint_set_num_threads(1 + n_randint(state, 3));
+
         for (f = f0; f < nf; f++)
         {
 
@@ -173,6 +175,57 @@ int main(void)
 
     }
 
+    /* batched and real-input dft */
+    for (k = 0; k < 30; k++)
+    {
+        slong i, j, len, num;
+        acb_dft_pre_t pre;
+        acb_dft_real_t rt;
+        acb_ptr v, w1, w2;
+        arb_ptr x;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        len = (k < nq) ? q[k] : n_randint(state, 2000);
+        num = 1 + n_randint(state, 5);
+
+        v = _acb_vec_init(num * len);
+        w1 = _acb_vec_init(num * len);
+        w2 = _acb_vec_init(num * len);
+        x = _arb_vec_init(len);
+
+        for (i = 0; i < num * len; i++)
+            acb_set_si_si(v + i, i, (i * i) % 7 - 3);
+
+        acb_dft_precomp_init(pre, len, prec);
+
+        for (j = 0; j < num; j++)
+            acb_dft_precomp(w1 + j * len, v + j * len, pre, prec);
+        acb_dft_precomp_vec(w2, v, num, pre, prec);
+        check_vec_eq_prec(w1, w2, num * len, prec, digits, len, "vec", "precomp", "precomp_vec");
+
+        acb_dft_inverse_precomp_vec(w2, w2, num, pre, prec);
+        check_vec_eq_prec(v, w2, num * len, prec, digits, len, "inverse vec", "original", "inverse");
+
+        for (i = 0; i < len; i++)
+        {
+            arb_set_si(x + i, 2 * i - 3);
+            acb_set_si(v + i, 2 * i - 3);
+        }
+
+        acb_dft_precomp(w1, v, pre, prec);
+        acb_dft_real_init(rt, len, prec);
+        acb_dft_real_precomp(w2, x, rt, prec);
+        check_vec_eq_prec(w1, w2, len, prec, digits, len, "real", "precomp", "real");
+
+        acb_dft_precomp_clear(pre);
+        acb_dft_real_clear(rt);
+        _acb_vec_clear(v, num * len);
+        _acb_vec_clear(w1, num * len);
+        _acb_vec_clear(w2, num * len);
+        _arb_vec_clear(x, len);
+    }
+
     flint_randclear(state);
     flint_cleanup_master();
     flint_printf("PASS\n");
@@ -0,0 +1,485 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "acb_dft.h"
+#include "acb_dirichlet.h"
+
+#ifdef __GNUC__
+# define sqrt __builtin_sqrt
+#else
+# include <math.h>
+#endif
+
+/*
+    We use Z(t) = 2 Re(e^{i theta(t)} R(1/2+it)) where
+
+        R(s) = sum_{n=1}^{N} n^{-s} + (Riemann-Siegel correction),
+
+    N = floor(sqrt(t/(2pi))). The correction is computed pointwise.
+    On a run of points sharing the same N, the main sums are computed
+    blockwise following Odlyzko and Schonhage. For the points t_c + u h
+    of a block, |u| <= B/2, write h log(n) = 2 pi k_n / M + delta_n with
+    |delta_n| <= pi/M. Then
+
+        sum_n a_n e^{-i u h log(n)} = sum_r ((-iu)^r / r!) G_r(u)
+
+    with a_n = n^{-1/2-i t_c} and G_r(u) the DFT of length M of the vector
+    with entries sum_{k_n = k} a_n delta_n^r. The Taylor series is
+    truncated using |a_n| <= n^{-1/2}. The vectors a_n for consecutive
+    blocks differ by the factor e^{-i B h log(n)}.
+*/
+
+/* runs shorter than this use direct power sums */
+#define HARDY_Z_VEC_MIN_BATCH 32
+
+/* limit on the DFT length (per thread) */
+#define HARDY_Z_VEC_MAX_LOG_M 13
+
+typedef struct
+{
+    acb_ptr P;
+    acb_ptr C;
+    acb_ptr E;
+    ulong * N;
+    arf_srcptr t0;
+    arf_srcptr h;
+    slong prec;
+    slong wp;
+    double cutoff;
+}
+hz_point_t;
+
+typedef struct
+{
+    acb_ptr P;
+    slong m;
+    arf_srcptr t1;
+    arf_srcptr h;
+    ulong N;
+    const ulong * spf;
+    arb_srcptr logs;
+    arb_srcptr delta;
+    const slong * k;
+    acb_srcptr z;
+    const acb_dft_rad2_struct * rad2;
+    slong e;
+    slong R;
+    mag_srcptr err;
+    slong nblocks;
+    slong nchunks;
+    slong wp;
+}
+hz_run_t;
+
+static void
+_hz_point(arf_t t, arf_srcptr t0, arf_srcptr h, slong j)
+{
+    arf_set_si(t, j);
+    arf_mul(t, t, h, ARF_PREC_EXACT, ARF_RND_DOWN);
+    arf_add(t, t, t0, ARF_PREC_EXACT, ARF_RND_DOWN);
+}
+
+/* correction term, e^{i theta} and N at a single point */
+static void
+_hz_point_worker(slong j, hz_point_t * args)
+{
+    acb_t s, u;
+
+    acb_init(s);
+    acb_init(u);
+
+    _hz_point(arb_midref(acb_imagref(s)), args->t0, args->h, j);
+    arb_set_d(acb_realref(s), 0.5);
+
+    if (arf_cmp_d(arb_midref(acb_imagref(s)), args->cutoff) < 0)
+    {
+        args->N[j] = 0;
+    }
+    else
+    {
+        _acb_dirichlet_zeta_rs_r(args->C + j, args->N + j, s, 0, 0, args->prec);
+
+        if (!acb_is_finite(args->C + j))
+        {
+            args->N[j] = 0;
+        }
+        else
+        {
+            arb_set(acb_realref(u), acb_imagref(s));
+            acb_dirichlet_hardy_theta(u, u, NULL, NULL, 1, args->wp);
+            arb_sin_cos(acb_imagref(args->E + j), acb_realref(args->E + j),
+                acb_realref(u), args->wp);
+        }
+    }
+
+    acb_clear(s);
+    acb_clear(u);
+}
+
+/* main sum at a single point */
+static void
+_hz_powsum_worker(slong j, hz_point_t * args)
+{
+    acb_t s;
+
+    if (args->N[j] == 0)
+        return;
+
+    acb_init(s);
+    _hz_point(arb_midref(acb_imagref(s)), args->t0, args->h, j);
+    arb_set_d(acb_realref(s), 0.5);
+    acb_dirichlet_powsum_sieved(args->P + j, s, args->N[j], 1, args->wp);
+    acb_clear(s);
+}
+
+/* blocks [b0, b1) of a run */
+static void
+_hz_run_worker(slong i, hz_run_t * run)
+{
+    slong b0, b1, b, n, r, u, j, M, B, N, R, idx;
+    acb_ptr a, G;
+    acb_t p, y;
+    arb_t x, c;
+    arf_t tc;
+    slong wp = run->wp;
+
+    b0 = (i * run->nblocks) / run->nchunks;
+    b1 = ((i + 1) * run->nblocks) / run->nchunks;
+
+    if (b0 >= b1)
+        return;
+
+    M = WORD(1) << run->e;
+    B = M / 2;
+    N = run->N;
+    R = run->R;
+
+    acb_init(p);
+    acb_init(y);
+    arb_init(x);
+    arb_init(c);
+    arf_init(tc);
+
+    a = _acb_vec_init(N + 1);
+    G = _acb_vec_init(R * M);
+
+    /* a_n = n^{-1/2-i t_c} at the center of block b0 */
+    _hz_point(tc, run->t1, run->h, b0 * B + B / 2);
+
+    acb_one(a + 1);
+    for (n = 2; n <= N; n++)
+    {
+        if (run->spf[n] == n)
+        {
+            arb_mul_arf(x, run->logs + n, tc, wp);
+            arb_sin_cos(acb_imagref(a + n), acb_realref(a + n), x, wp);
+            arb_neg(acb_imagref(a + n), acb_imagref(a + n));
+            arb_rsqrt_ui(c, n, wp);
+            acb_mul_arb(a + n, a + n, c, wp);
+        }
+        else
+        {
+            acb_mul(a + n, a + run->spf[n], a + n / run->spf[n], wp);
+        }
+    }
+
+    for (b = b0; b < b1; b++)
+    {
+        _acb_vec_zero(G, R * M);
+
+        for (n = 1; n <= N; n++)
+        {
+            acb_set(p, a + n);
+
+            for (r = 0; r < R; r++)
+            {
+                acb_add(G + r * M + run->k[n], G + r * M + run->k[n], p, wp);
+                if (r + 1 < R)
+                    acb_mul_arb(p, p, run->delta + n, wp);
+            }
+        }
+
+        for (r = 0; r < R; r++)
+            acb_dft_rad2_precomp_inplace(G + r * M, run->rad2, wp);
+
+        for (j = 0; j < B && b * B + j < run->m; j++)
+        {
+            u = j - B / 2;
+            idx = (u < 0) ? u + M : u;
+
+            /* sum_r ((-iu)^r / r!) G_r(u) */
+            acb_set(y, G + (R - 1) * M + idx);
+            for (r = R - 2; r >= 0; r--)
+            {
+                acb_mul_si(y, y, u, wp);
+                acb_div_ui(y, y, r + 1, wp);
+                acb_div_onei(y, y);
+                acb_add(y, y, G + r * M + idx, wp);
+            }
+
+            acb_add_error_mag(y, run->err);
+            acb_swap(run->P + b * B + j, y);
+        }
+
+        if (b + 1 < b1)
+        {
+            for (n = 2; n <= N; n++)
+                acb_mul(a + n, a + n, run->z + n, wp);
+        }
+    }
+
+    _acb_vec_clear(a, N + 1);
+    _acb_vec_clear(G, R * M);
+
+    acb_clear(p);
+    acb_clear(y);
+    arb_clear(x);
+    arb_clear(c);
+    arf_clear(tc);
+}
+
+/* main sums at the m points starting at t1, all with the same N */
+static void
+_hz_run(acb_ptr P, slong m, arf_srcptr t1, arf_srcptr h, ulong N,
+    const ulong * spf, arb_srcptr logs, slong prec, slong wp)
+{
+    hz_run_t run;
+    acb_dft_rad2_t rad2;
+    arb_ptr delta;
+    acb_ptr z;
+    slong * k;
+    slong e, M, B, n, R;
+    arb_t w, twopi;
+    fmpz_t kk;
+    mag_t D, err, tm, tol;
+
+    /* B = M / 2 points per block */
+    e = FLINT_BIT_COUNT(FLINT_MIN(m, FLINT_MAX(N / 4, 32)) - 1) + 1;
+    e = FLINT_MIN(e, HARDY_Z_VEC_MAX_LOG_M);
+    M = WORD(1) << e;
+    B = M / 2;
+
+    arb_init(w);
+    arb_init(twopi);
+    fmpz_init(kk);
+    mag_init(D);
+    mag_init(err);
+    mag_init(tm);
+    mag_init(tol);
+
+    delta = _arb_vec_init(N + 1);
+    z = _acb_vec_init(N + 1);
+    k = flint_calloc(N + 1, sizeof(slong));
+
+    arb_const_pi(twopi, wp);
+    arb_mul_2exp_si(twopi, twopi, 1);
+
+    /* h log(n) = 2 pi k_n / M + delta_n */
+    acb_one(z + 1);
+    for (n = 2; n <= N; n++)
+    {
+        arb_mul_arf(w, logs + n, h, wp);
+
+        arb_div(delta + n, w, twopi, wp);
+        arb_mul_2exp_si(delta + n, delta + n, e);
+        arf_get_fmpz(kk, arb_midref(delta + n), ARF_RND_NEAR);
+        k[n] = fmpz_fdiv_ui(kk, M);
+
+        arb_mul_fmpz(delta + n, twopi, kk, wp);
+        arb_mul_2exp_si(delta + n, delta + n, -e);
+        arb_sub(delta + n, w, delta + n, wp);
+
+        arb_get_mag(tm, delta + n);
+        mag_max(D, D, tm);
+
+        /* z_n = e^{-i B h log(n)} */
+        if (spf[n] == n)
+        {
+            arb_mul_si(w, w, B, wp);
+            arb_sin_cos(acb_imagref(z + n), acb_realref(z + n), w, wp);
+            arb_neg(acb_imagref(z + n), acb_imagref(z + n));
+        }
+        else
+        {
+            acb_mul(z + n, z + spf[n], z + n / spf[n], wp);
+        }
+    }
+
+    /* |sum_n a_n sum_{r >= R} (-iu delta_n)^r / r!|
+         <= 2 sqrt(N) sum_{r >= R} (D B / 2)^r / r! */
+    mag_mul_ui(D, D, B / 2);
+    mag_set_ui(tm, N);
+    mag_sqrt(tm, tm);
+    mag_mul_2exp_si(tm, tm, 1);
+    mag_set_ui_2exp_si(tol, 1, -prec - 10);
+
+    for (R = 1; ; R++)
+    {
+        mag_exp_tail(err, D, R);
+        mag_mul(err, err, tm);
+
+        if (mag_cmp(err, tol) <= 0 || R >= 4 * prec + 10)
+            break;
+    }
+
+    acb_dft_rad2_init(rad2, e, wp);
+
+    run.P = P;
+    run.m = m;
+    run.t1 = t1;
+    run.h = h;
+    run.N = N;
+    run.spf = spf;
+    run.logs = logs;
+    run.delta = delta;
+    run.k = k;
+    run.z = z;
+    run.rad2 = rad2;
+    run.e = e;
+    run.R = R;
+    run.err = err;
+    run.nblocks = (m + B - 1) / B;
+    run.nchunks = FLINT_MIN(run.nblocks, flint_get_num_threads());
+    run.wp = wp;
+
+    flint_parallel_do((do_func_t) _hz_run_worker, &run, run.nchunks, -1, FLINT_PARALLEL_STRIDED);
+
+    acb_dft_rad2_clear(rad2);
+    _arb_vec_clear(delta, N + 1);
+    _acb_vec_clear(z, N + 1);
+    flint_free(k);
+
+    arb_clear(w);
+    arb_clear(twopi);
+    fmpz_clear(kk);
+    mag_clear(D);
+    mag_clear(err);
+    mag_clear(tm);
+    mag_clear(tol);
+}
+
+void
+acb_dirichlet_hardy_z_vec(arb_ptr res, const arf_t t0, const arf_t h,
+    slong len, slong prec)
+{
+    hz_point_t args;
+    acb_ptr P, C, E;
+    arb_ptr logs;
+    ulong * N, * spf;
+    ulong Nmax, p, q;
+    slong j, j1, tbits, wp;
+    arf_t t;
+    acb_t s;
+
+    if (len <= 0)
+        return;
+
+    arf_init(t);
+    acb_init(s);
+
+    P = _acb_vec_init(len);
+    C = _acb_vec_init(len);
+    E = _acb_vec_init(len);
+    N = flint_calloc(len, sizeof(ulong));
+
+    _hz_point(t, t0, h, len - 1);
+    tbits = FLINT_MAX(arf_abs_bound_lt_2exp_si(t0), arf_abs_bound_lt_2exp_si(t));
+    tbits = FLINT_MAX(tbits, 0);
+    wp = prec + tbits + 10;
+
+    args.P = P;
+    args.C = C;
+    args.E = E;
+    args.N = N;
+    args.t0 = t0;
+    args.h = h;
+    args.prec = prec;
+    args.wp = wp;
+    /* same as acb_dirichlet_zeta */
+    args.cutoff = 24.0 * prec * sqrt(prec);
+
+    if (arf_is_finite(t0) && arf_is_finite(h))
+        flint_parallel_do((do_func_t) _hz_point_worker, &args, len, -1, FLINT_PARALLEL_STRIDED);
+
+    Nmax = 0;
+    for (j = 0; j < len; j++)
+        Nmax = FLINT_MAX(Nmax, N[j]);
+
+    /* smallest prime factors and logarithms */
+    spf = flint_calloc(Nmax + 1, sizeof(ulong));
+    logs = _arb_vec_init(Nmax + 1);
+
+    for (p = 2; p <= Nmax; p++)
+    {
+        if (spf[p] == 0)
+        {
+            spf[p] = p;
+            arb_log_ui(logs + p, p, wp + 2 * FLINT_BIT_COUNT(Nmax));
+
+            if (p <= Nmax / p)
+                for (q = p * p; q <= Nmax; q += p)
+                    if (spf[q] == 0)
+                        spf[q] = p;
+        }
+        else
+        {
+            arb_add(logs + p, logs + spf[p], logs + p / spf[p], wp + 2 * FLINT_BIT_COUNT(Nmax));
+        }
+    }
+
+    /* main sums, on runs of points with the same N */
+    for (j = 0; j < len; j = j1)
+    {
+        for (j1 = j + 1; j1 < len && N[j1] == N[j]; j1++) ;
+
+        if (N[j] != 0 && j1 - j >= HARDY_Z_VEC_MIN_BATCH)
+        {
+            _hz_point(t, t0, h, j);
+            _hz_run(P + j, j1 - j, t, h, N[j], spf, logs, prec,
+                wp + FLINT_BIT_COUNT(N[j]) + 10);
+        }
+        else
+        {
+            for ( ; j < j1; j++)
+                if (N[j] != 0)
+                    _hz_powsum_worker(j, &args);
+        }
+    }
+
+    for (j = 0; j < len; j++)
+    {
+        if (N[j] == 0)
+        {
+            acb_zero(s);
+            _hz_point(arb_midref(acb_realref(s)), t0, h, j);
+            acb_dirichlet_hardy_z(s, s, NULL, NULL, 1, prec);
+            arb_set_round(res + j, acb_realref(s), prec);
+        }
+        else
+        {
+            /* 2 Re(e^{i theta} R) */
+            acb_add(P + j, P + j, C + j, wp);
+            arb_mul(res + j, acb_realref(E + j), acb_realref(P + j), wp);
+            arb_submul(res + j, acb_imagref(E + j), acb_imagref(P + j), wp);
+            arb_mul_2exp_si(res + j, res + j, 1);
+            arb_set_round(res + j, res + j, prec);
+        }
+    }
+
+    _acb_vec_clear(P, len);
+    _acb_vec_clear(C, len);
+    _acb_vec_clear(E, len);
+    flint_free(N);
+    flint_free(spf);
+    _arb_vec_clear(logs, Nmax + 1);
+
+    arf_clear(t);
+    acb_clear(s);
+}
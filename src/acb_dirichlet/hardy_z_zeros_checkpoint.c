@@ -0,0 +1,324 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "thread_support.h"
+#include "fmpz_vec.h"
+#include "acb_dirichlet.h"
+
+/*
+    The checkpoint file is a text file with one line per completed range:
+
+        Z <start> <count> <prec> ; <zero> ; ... ; <zero> ; E
+
+    where each zero is written with arb_dump_str. Every record is preceded
+    by a newline, so that a record cut short by a crash only spoils its
+    own line. Lines that do not parse are ignored.
+*/
+
+typedef struct
+{
+    arb_ptr res;
+    fmpz * start;
+    slong * count;
+    slong range_len;
+    slong prec;
+}
+_zeros_arg_t;
+
+static void
+_zeros_worker(slong i, void * arg_ptr)
+{
+    _zeros_arg_t * arg = (_zeros_arg_t *) arg_ptr;
+
+    acb_dirichlet_hardy_z_zeros(arg->res + i * arg->range_len,
+        arg->start + i, arg->count[i], arg->prec);
+}
+
+/* reads a line of arbitrary length; returns NULL at end of file */
+static char *
+_read_line(FILE * file)
+{
+    char * buf;
+    size_t len, alloc;
+    int c;
+
+    c = fgetc(file);
+    if (c == EOF)
+        return NULL;
+
+    alloc = 256;
+    len = 0;
+    buf = flint_malloc(alloc);
+
+    while (c != EOF && c != '\n')
+    {
+        if (len + 1 >= alloc)
+        {
+            alloc *= 2;
+            buf = flint_realloc(buf, alloc);
+        }
+
+        buf[len++] = c;
+        c = fgetc(file);
+    }
+
+    buf[len] = '\0';
+    return buf;
+}
+
+/* returns the next ';'-separated field with surrounding spaces removed,
+   or NULL if there is none; modifies the line in place */
+static char *
+_next_field(char ** pos)
+{
+    char * s = *pos, * t;
+
+    if (s == NULL)
+        return NULL;
+
+    t = strchr(s, ';');
+    if (t != NULL)
+    {
+        *t = '\0';
+        *pos = t + 1;
+    }
+    else
+    {
+        *pos = NULL;
+    }
+
+    while (*s == ' ')
+        s++;
+
+    t = s + strlen(s);
+    while (t > s && t[-1] == ' ')
+        t--;
+    *t = '\0';
+
+    return s;
+}
+
+/* parses a record, returning the index of its range if it belongs to a
+   range of the current partition that is not done yet and the zeros could
+   be read into res */
+static slong
+_parse_record(char * line, arb_ptr res, const fmpz_t n, const slong * count,
+    const int * done, slong num_ranges, slong range_len, slong prec)
+{
+    char * pos = line;
+    char * field;
+    char * digits;
+    fmpz_t rstart;
+    slong rcount, rprec, i, k;
+    int ok;
+
+    field = _next_field(&pos);
+    if (field == NULL || field[0] != 'Z' || field[1] != ' ')
+        return -1;
+
+    /* header: Z <start> <count> <prec> */
+    digits = flint_malloc(strlen(field) + 1);
+    ok = (sscanf(field + 2, "%s", digits) == 1);
+
+    fmpz_init(rstart);
+    ok = ok && (fmpz_set_str(rstart, digits, 10) == 0);
+    ok = ok && (flint_sscanf(field + 2 + strlen(digits), "%wd %wd", &rcount, &rprec) == 2);
+
+    /* the range index is (start - n) / range_len */
+    k = -1;
+    if (ok)
+    {
+        fmpz_sub(rstart, rstart, n);
+
+        if (fmpz_sgn(rstart) >= 0 && fmpz_cmp_si(rstart, num_ranges * range_len) < 0
+            && fmpz_fdiv_ui(rstart, range_len) == 0)
+            k = fmpz_get_si(rstart) / range_len;
+    }
+
+    fmpz_clear(rstart);
+    flint_free(digits);
+
+    ok = (k >= 0) && !done[k] && (rcount == count[k]) && (rprec >= prec);
+
+    for (i = 0; ok && i < rcount; i++)
+    {
+        field = _next_field(&pos);
+        ok = (field != NULL) && (arb_load_str(res + k * range_len + i, field) == 0);
+        if (ok)
+            arb_set_round(res + k * range_len + i, res + k * range_len + i, prec);
+    }
+
+    if (ok)
+    {
+        field = _next_field(&pos);
+        ok = (field != NULL) && (strcmp(field, "E") == 0) && (pos == NULL);
+    }
+
+    return ok ? k : -1;
+}
+
+static void
+_write_record(FILE * file, const fmpz_t start, slong count, slong prec, arb_srcptr z)
+{
+    slong i;
+    char * s;
+
+    fputs("\nZ ", file);
+    fmpz_fprint(file, start);
+    flint_fprintf(file, " %wd %wd", count, prec);
+
+    for (i = 0; i < count; i++)
+    {
+        s = arb_dump_str(z + i);
+        fputs(" ; ", file);
+        fputs(s, file);
+        flint_free(s);
+    }
+
+    fputs(" ; E\n", file);
+}
+
+slong
+acb_dirichlet_hardy_z_zeros_checkpoint(arb_ptr res, const fmpz_t n,
+    slong len, slong range_len, const char * filename, slong prec)
+{
+    slong num_ranges, num_pending, num_loaded, round, i, j, k;
+    fmpz * start;
+    slong * count;
+    int * done;
+    FILE * file;
+    char * line;
+
+    if (len <= 0)
+        return 0;
+
+    if (fmpz_sgn(n) < 1)
+        flint_throw(FLINT_ERROR, "nonpositive indices of zeros are not supported\n");
+
+    if (range_len <= 0)
+        range_len = len;
+
+    num_ranges = (len + range_len - 1) / range_len;
+
+    start = _fmpz_vec_init(num_ranges);
+    count = flint_malloc(sizeof(slong) * num_ranges);
+    done = flint_calloc(num_ranges, sizeof(int));
+
+    for (i = 0; i < num_ranges; i++)
+    {
+        fmpz_add_si(start + i, n, i * range_len);
+        count[i] = FLINT_MIN(range_len, len - i * range_len);
+    }
+
+    num_loaded = 0;
+    file = NULL;
+
+    if (filename != NULL)
+    {
+        file = fopen(filename, "r");
+
+        if (file != NULL)
+        {
+            while ((line = _read_line(file)) != NULL)
+            {
+                k = _parse_record(line, res, n, count, done, num_ranges, range_len, prec);
+
+                if (k >= 0)
+                {
+                    done[k] = 1;
+                    num_loaded += count[k];
+                }
+
+                flint_free(line);
+            }
+
+            fclose(file);
+        }
+
+        file = fopen(filename, "a");
+
+        if (file == NULL)
+            flint_throw(FLINT_ERROR, "acb_dirichlet_hardy_z_zeros_checkpoint: "
+                "unable to open %s for writing\n", filename);
+    }
+
+    /* compute the remaining ranges in rounds of one range per thread,
+       writing each round to the checkpoint file before starting the next */
+    {
+        _zeros_arg_t arg;
+        fmpz * rstart;
+        slong * rcount;
+        slong * ridx;
+        arb_ptr rres;
+
+        round = FLINT_MAX(flint_get_num_threads(), 1);
+        round = FLINT_MIN(round, num_ranges);
+
+        rstart = _fmpz_vec_init(round);
+        rcount = flint_malloc(sizeof(slong) * round);
+        ridx = flint_malloc(sizeof(slong) * round);
+        rres = _arb_vec_init(round * range_len);
+
+        for (i = 0; i < num_ranges; )
+        {
+            num_pending = 0;
+
+            for ( ; i < num_ranges && num_pending < round; i++)
+            {
+                if (!done[i])
+                {
+                    fmpz_set(rstart + num_pending, start + i);
+                    rcount[num_pending] = count[i];
+                    ridx[num_pending] = i;
+                    num_pending++;
+                }
+            }
+
+            if (num_pending == 0)
+                break;
+
+            arg.res = rres;
+            arg.start = rstart;
+            arg.count = rcount;
+            arg.range_len = range_len;
+            arg.prec = prec;
+
+            flint_parallel_do(_zeros_worker, &arg, num_pending, -1,
+                FLINT_PARALLEL_STRIDED);
+
+            for (j = 0; j < num_pending; j++)
+            {
+                k = ridx[j];
+                _arb_vec_set(res + k * range_len, rres + j * range_len, count[k]);
+
+                if (file != NULL)
+                    _write_record(file, start + k, count[k], prec, rres + j * range_len);
+            }
+
+            if (file != NULL)
+                fflush(file);
+        }
+
+        _fmpz_vec_clear(rstart, round);
+        flint_free(rcount);
+        flint_free(ridx);
+        _arb_vec_clear(rres, round * range_len);
+    }
+
+    if (file != NULL)
+        fclose(file);
+
+    _fmpz_vec_clear(start, num_ranges);
+    flint_free(count);
+    flint_free(done);
+
+    return num_loaded;
+}
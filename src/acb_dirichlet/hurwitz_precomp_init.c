@@ -9,9 +9,54 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb_dirichlet.h"
 #include "acb_poly.h"
 
+typedef struct
+{
+    acb_ptr coeffs;
+    const acb_struct * s;
+    slong A;
+    slong K;
+    slong N;
+    int deflate;
+    slong prec;
+}
+hurwitz_precomp_arg_t;
+
+/* multiply row i by zeta(s+k,a) where a = A + (2*i+1)/(2*N) */
+static void
+_hurwitz_precomp_worker(slong i, void * _args)
+{
+    hurwitz_precomp_arg_t * args = (hurwitz_precomp_arg_t *) _args;
+    slong k, K = args->K, N = args->N, prec = args->prec;
+    acb_t t, a;
+
+    acb_init(t);
+    acb_init(a);
+
+    acb_set_ui(a, 2 * i + 1);
+    acb_div_ui(a, a, 2 * N, prec);
+    acb_add_ui(a, a, args->A, prec);
+
+    for (k = 0; k < K; k++)
+    {
+        acb_add_ui(t, args->s, k, prec);
+
+        if (args->deflate && k == 0)
+            _acb_poly_zeta_cpx_series(t, t, a, 1, 1, prec);
+        else
+            acb_hurwitz_zeta(t, t, a, prec);
+
+        acb_mul(args->coeffs + i * K + k,
+                args->coeffs + i * K + k, t, prec);
+    }
+
+    acb_clear(t);
+    acb_clear(a);
+}
+
 void
 acb_dirichlet_hurwitz_precomp_init(acb_dirichlet_hurwitz_precomp_t pre,
         const acb_t s, int deflate, slong A, slong K, slong N, slong prec)
@@ -43,10 +88,7 @@ acb_dirichlet_hurwitz_precomp_init(acb_dirichlet_hurwitz_precomp_t pre,
 
     if (mag_is_finite(&pre->err))
     {
-        acb_t t, a;
-
-        acb_init(t);
-        acb_init(a);
+        hurwitz_precomp_arg_t args;
 
         /* (-1)^k (s)_k / k! */
         acb_one(pre->coeffs + 0);
@@ -61,29 +103,16 @@ acb_dirichlet_hurwitz_precomp_init(acb_dirichlet_hurwitz_precomp_t pre,
         for (i = 1; i < N; i++)
             _acb_vec_set(pre->coeffs + i * K, pre->coeffs, K);
 
-        /* zeta(s+k,a) where a = A + (2*i+1)/(2*N) */
-        for (i = 0; i < N; i++)
-        {
-            acb_set_ui(a, 2 * i + 1);
-            acb_div_ui(a, a, 2 * N, prec);
-            acb_add_ui(a, a, A, prec);
-
-            for (k = 0; k < K; k++)
-            {
-                acb_add_ui(t, s, k, prec);
-
-                if (deflate && k == 0)
-                    _acb_poly_zeta_cpx_series(t, t, a, 1, 1, prec);
-                else
-                    acb_hurwitz_zeta(t, t, a, prec);
-
-                acb_mul(pre->coeffs + i * K + k,
-                        pre->coeffs + i * K + k, t, prec);
-            }
-        }
+        args.coeffs = pre->coeffs;
+        args.s = s;
+        args.A = A;
+        args.K = K;
+        args.N = N;
+        args.deflate = deflate;
+        args.prec = prec;
 
-        acb_clear(t);
-        acb_clear(a);
+        /* the N Taylor expansions are independent */
+        flint_parallel_do(_hurwitz_precomp_worker, &args, N, -1, FLINT_PARALLEL_STRIDED);
     }
 }
 
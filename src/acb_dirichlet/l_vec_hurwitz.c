@@ -9,17 +9,65 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb_dirichlet.h"
 #include "acb_poly.h"
 
+typedef struct
+{
+    acb_ptr z;
+    const ulong * num;
+    const acb_struct * s;
+    const acb_struct * qs;
+    const acb_dirichlet_hurwitz_precomp_struct * precomp;
+    ulong q;
+    int deflate;
+    slong prec;
+}
+l_vec_hurwitz_arg_t;
+
+/* z[i] = conj(q^(-s) zeta(s, num[i] / q)) */
+static void
+_l_vec_hurwitz_worker(slong i, void * _args)
+{
+    l_vec_hurwitz_arg_t * args = (l_vec_hurwitz_arg_t *) _args;
+    acb_ptr z = args->z + i;
+    slong prec = args->prec;
+
+    if (args->precomp == NULL)
+    {
+        acb_t a;
+        acb_init(a);
+        acb_set_ui(a, args->num[i]);
+        acb_div_ui(a, a, args->q, prec);
+
+        if (args->deflate == 0)
+            acb_hurwitz_zeta(z, args->s, a, prec);
+        else
+            _acb_poly_zeta_cpx_series(z, args->s, a, 1, 1, prec);
+
+        acb_clear(a);
+    }
+    else
+    {
+        acb_dirichlet_hurwitz_precomp_eval(z, args->precomp, args->num[i], args->q, prec);
+    }
+
+    acb_mul(z, z, args->qs, prec);
+    acb_conj(z, z);
+}
+
 void
 acb_dirichlet_l_vec_hurwitz(acb_ptr res, const acb_t s,
     const acb_dirichlet_hurwitz_precomp_t precomp,
     const dirichlet_group_t G, slong prec)
 {
     acb_t a, qs;
-    acb_ptr zeta, z;
+    acb_ptr zeta;
+    ulong * num;
+    slong k;
     dirichlet_char_t cn;
+    l_vec_hurwitz_arg_t args;
     int deflate;
 
     /* remove pole in Hurwitz zeta at s = 1 */
@@ -35,37 +83,32 @@ acb_dirichlet_l_vec_hurwitz(acb_ptr res, const acb_t s,
     acb_neg(a, s);
     acb_pow(qs, qs, a, prec);
 
-    zeta = z = _acb_vec_init(G->phi_q);
+    /* the Hurwitz zeta values are independent; list the arguments
+       in character order and evaluate them in parallel */
+    num = flint_malloc(G->phi_q * sizeof(ulong));
+    k = 0;
     dirichlet_char_one(cn, G);
     do {
-        if (precomp == NULL)
-        {
-            acb_set_ui(a, cn->n);
-            acb_div_ui(a, a, G->q, prec);
-
-            if (deflate == 0)
-                acb_hurwitz_zeta(z, s, a, prec);
-            else
-                _acb_poly_zeta_cpx_series(z, s, a, 1, 1, prec);
-        }
-        else
-        {
-            acb_dirichlet_hurwitz_precomp_eval(z, precomp, cn->n, G->q, prec);
-        }
+        num[k++] = cn->n;
+    } while (dirichlet_char_next(cn, G) >= 0);
 
-        acb_mul(z, z, qs, prec);
-        acb_conj(z, z);
+    zeta = _acb_vec_init(G->phi_q);
 
-        z++;
-    } while (dirichlet_char_next(cn, G) >= 0);
+    args.z = zeta;
+    args.num = num;
+    args.s = s;
+    args.qs = qs;
+    args.precomp = precomp;
+    args.q = G->q;
+    args.deflate = deflate;
+    args.prec = prec;
+
+    flint_parallel_do(_l_vec_hurwitz_worker, &args, G->phi_q, -1, FLINT_PARALLEL_STRIDED);
 
     acb_dirichlet_dft_index(res, zeta, G, prec);
 
-    {
-        slong k;
-        for (k = 0; k < G->phi_q; k++)
-            acb_conj(res + k, res + k);
-    }
+    for (k = 0; k < G->phi_q; k++)
+        acb_conj(res + k, res + k);
 
     /* restore pole for the principal character */
     if (deflate)
@@ -73,7 +116,7 @@ acb_dirichlet_l_vec_hurwitz(acb_ptr res, const acb_t s,
 
     dirichlet_char_clear(cn);
     _acb_vec_clear(zeta, G->phi_q);
+    flint_free(num);
     acb_clear(qs);
     acb_clear(a);
 }
-
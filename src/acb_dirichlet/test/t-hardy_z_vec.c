@@ -0,0 +1,84 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "acb_dirichlet.h"
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("hardy_z_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* compare with hardy_z */
+    for (iter = 0; iter < 100 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        arf_t t0, h;
+        acb_t t, z;
+        arb_ptr res;
+        slong i, j, len, prec;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        prec = 2 + n_randint(state, 150);
+        len = n_randint(state, 400);
+
+        arf_init(t0);
+        arf_init(h);
+        acb_init(t);
+        acb_init(z);
+        res = _arb_vec_init(len);
+
+        /* sometimes below the Riemann-Siegel cutoff */
+        arf_set_ui_2exp_si(t0, n_randint(state, 1000),
+            n_randint(state, 2) ? 10 + n_randint(state, 10) : n_randint(state, 10));
+        arf_set_ui_2exp_si(h, 1 + n_randint(state, 100), -(slong) n_randint(state, 12));
+        if (n_randint(state, 4) == 0)
+            arf_neg(h, h);
+        if (arf_sgn(h) < 0)
+            arf_add_ui(t0, t0, 100000, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+        acb_dirichlet_hardy_z_vec(res, t0, h, len, prec);
+
+        for (i = 0; i < 5 && len > 0; i++)
+        {
+            j = n_randint(state, len);
+
+            acb_zero(t);
+            arf_mul_si(arb_midref(acb_realref(t)), h, j, ARF_PREC_EXACT, ARF_RND_DOWN);
+            arf_add(arb_midref(acb_realref(t)), arb_midref(acb_realref(t)), t0, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+            acb_dirichlet_hardy_z(z, t, NULL, NULL, 1, prec + 20);
+
+            if (!arb_overlaps(res + j, acb_realref(z)))
+            {
+                flint_printf("FAIL: overlap\n\n");
+                flint_printf("iter = %wd  prec = %wd  j = %wd\n\n", iter, prec, j);
+                flint_printf("t = "); acb_printn(t, 50, 0); flint_printf("\n\n");
+                flint_printf("res = "); arb_printn(res + j, 50, 0); flint_printf("\n\n");
+                flint_printf("z = "); acb_printn(z, 50, 0); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        arf_clear(t0);
+        arf_clear(h);
+        acb_clear(t);
+        acb_clear(z);
+        _arb_vec_clear(res, len);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "acb_dirichlet.h"
+
+#define FILENAME "t-hardy_z_zeros_checkpoint.tmp"
+
+static int
+_vec_equal(arb_srcptr x, arb_srcptr y, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (!arb_equal(x + i, y + i))
+            return 0;
+
+    return 1;
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("hardy_z_zeros_checkpoint....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        arb_ptr res1, res2, res3;
+        arb_t t;
+        fmpz_t n;
+        slong len, len2, range_len, prec, prec2, loaded, i;
+        FILE * file;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        fmpz_init(n);
+        arb_init(t);
+
+        fmpz_randtest_unsigned(n, state, 10);
+        fmpz_add_ui(n, n, 1);
+        len = 1 + n_randint(state, 12);
+        len2 = len + n_randint(state, 5);
+        range_len = 1 + n_randint(state, 6);
+        prec = 2 + n_randint(state, 100);
+        prec2 = 2 + n_randint(state, prec - 1);
+
+        res1 = _arb_vec_init(len2);
+        res2 = _arb_vec_init(len2);
+        res3 = _arb_vec_init(len2);
+
+        remove(FILENAME);
+
+        /* fresh run */
+        loaded = acb_dirichlet_hardy_z_zeros_checkpoint(res1, n, len, range_len, FILENAME, prec);
+        acb_dirichlet_hardy_z_zeros(res2, n, len2, prec);
+
+        if (loaded != 0 || !_vec_equal(res1, res2, len))
+        {
+            flint_printf("FAIL: fresh run\n\n");
+            flint_printf("n = "); fmpz_print(n);
+            flint_printf("  len = %wd  range_len = %wd  prec = %wd  loaded = %wd\n\n", len, range_len, prec, loaded);
+            flint_abort();
+        }
+
+        /* a record cut short by a crash is ignored */
+        file = fopen(FILENAME, "a");
+        flint_fprintf(file, "\nZ %wd %wd %wd ; 1 2", len, range_len, prec);
+        fclose(file);
+
+        /* resuming reads all ranges back exactly */
+        loaded = acb_dirichlet_hardy_z_zeros_checkpoint(res3, n, len, range_len, FILENAME, prec);
+
+        if (loaded != len || !_vec_equal(res1, res3, len))
+        {
+            flint_printf("FAIL: resume\n\n");
+            flint_printf("n = "); fmpz_print(n);
+            flint_printf("  len = %wd  range_len = %wd  prec = %wd  loaded = %wd\n\n", len, range_len, prec, loaded);
+            flint_abort();
+        }
+
+        /* at lower precision, the saved zeros are rounded */
+        loaded = acb_dirichlet_hardy_z_zeros_checkpoint(res3, n, len, range_len, FILENAME, prec2);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_set_round(t, res1 + i, prec2);
+
+            if (!arb_equal(t, res3 + i))
+            {
+                flint_printf("FAIL: lower precision\n\n");
+                flint_printf("n = "); fmpz_print(n);
+                flint_printf("  len = %wd  range_len = %wd  prec = %wd  prec2 = %wd  i = %wd\n\n", len, range_len, prec, prec2, i);
+                flint_abort();
+            }
+        }
+
+        /* extending the computation reuses the complete ranges */
+        loaded = acb_dirichlet_hardy_z_zeros_checkpoint(res3, n, len2, range_len, FILENAME, prec);
+
+        if (loaded < (len / range_len) * range_len || !_vec_equal(res2, res3, len2))
+        {
+            flint_printf("FAIL: extend\n\n");
+            flint_printf("n = "); fmpz_print(n);
+            flint_printf("  len = %wd  len2 = %wd  range_len = %wd  prec = %wd  loaded = %wd\n\n", len, len2, range_len, prec, loaded);
+            flint_abort();
+        }
+
+        remove(FILENAME);
+
+        _arb_vec_clear(res1, len2);
+        _arb_vec_clear(res2, len2);
+        _arb_vec_clear(res3, len2);
+        arb_clear(t);
+        fmpz_clear(n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -35,6 +35,8 @@ int main(void)
         prec = 50 + n_randint(state, 50);
         q = 1 + n_randint(state, 50);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
+
         dirichlet_group_init(G, q);
         dirichlet_char_init(chi, G);
 
@@ -19,7 +19,8 @@
 #endif
 
 void
-acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
+_acb_dirichlet_zeta_rs_r(acb_t res, ulong * len, const acb_t s, slong K,
+    int powsum, slong prec)
 {
     arb_ptr dk, pipow;
     acb_ptr Fp;
@@ -41,6 +42,7 @@ acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
         if (!(sigma > -1e6 && sigma < 1e6) || !(t > 1 && t < 1e40))
         {
             acb_indeterminate(res);
+            *len = 0;
             return;
         }
 
@@ -83,6 +85,7 @@ acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
     if (!mag_is_finite(err))
     {
         acb_indeterminate(res);
+        *len = 0;
         mag_clear(err);
         return;
     }
@@ -119,6 +122,7 @@ acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
             if (wp > 4 * prec && wp > arb_rel_accuracy_bits(acb_imagref(s)))
             {
                 acb_indeterminate(res);
+                *len = 0;
                 goto cleanup;
             }
 
@@ -143,9 +147,12 @@ acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
     if (!fmpz_fits_si(N))
     {
         acb_indeterminate(res);
+        *len = 0;
         goto cleanup;
     }
 
+    *len = fmpz_get_ui(N);
+
     wp = prec + 10 + 3 * fmpz_bits(N); /* xxx */
     wp = FLINT_MAX(wp, prec + 10);
     wp = wp + FLINT_BIT_COUNT(K);
@@ -209,12 +216,15 @@ acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
     if (fmpz_is_even(N))
         acb_neg(S, S);
 
-    if (_acb_vec_estimate_allocated_bytes(fmpz_get_ui(N) / 6, wp) < 4e9)
-        acb_dirichlet_powsum_sieved(u, s, fmpz_get_ui(N), 1, wp);
-    else
-        acb_dirichlet_powsum_smooth(u, s, fmpz_get_ui(N), 1, wp);
+    if (powsum)
+    {
+        if (_acb_vec_estimate_allocated_bytes(fmpz_get_ui(N) / 6, wp) < 4e9)
+            acb_dirichlet_powsum_sieved(u, s, fmpz_get_ui(N), 1, wp);
+        else
+            acb_dirichlet_powsum_smooth(u, s, fmpz_get_ui(N), 1, wp);
 
-    acb_add(S, S, u, wp);
+        acb_add(S, S, u, wp);
+    }
 
     acb_set(res, S);  /* don't set_round here; the extra precision is useful */
 
@@ -237,3 +247,10 @@ cleanup:
     mag_clear(err);
 }
 
+
+void
+acb_dirichlet_zeta_rs_r(acb_t res, const acb_t s, slong K, slong prec)
+{
+    ulong len;
+    _acb_dirichlet_zeta_rs_r(res, &len, s, K, 1, prec);
+}
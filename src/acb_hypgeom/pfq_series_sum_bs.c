@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb_poly.h"
 #include "acb_hypgeom.h"
 
@@ -43,6 +44,50 @@ factor(acb_poly_t A, acb_poly_t tmp,
     }
 }
 
+/* combines the results for [aa, m) and [m, bb), overwriting B2;
+   B1 and B2 are not set for ranges of length 1 */
+static void
+merge(acb_poly_t A1, acb_poly_t B1, acb_poly_t C1,
+        acb_poly_t A2, acb_poly_t B2, const acb_poly_t C2,
+        slong len1, slong len2, slong len, slong prec)
+{
+    acb_poly_t tmp;
+
+    acb_poly_init(tmp);
+
+    if (len2 == 1)  /* B2 = C2 */
+    {
+        if (len1 == 1)
+            acb_poly_add(B2, A1, C1, prec);
+        else
+            acb_poly_add(B2, A1, B1, prec);
+
+        acb_poly_mullow(B1, B2, C2, len, prec);
+    }
+    else
+    {
+        if (len1 == 1)
+        {
+            acb_poly_mullow(B1, C1, C2, len, prec);
+        }
+        else
+        {
+            acb_poly_mullow(tmp, B1, C2, len, prec);
+            acb_poly_swap(B1, tmp);
+        }
+
+        acb_poly_mullow(tmp, A1, B2, len, prec);
+        acb_poly_add(B1, B1, tmp, prec);
+    }
+
+    acb_poly_mullow(tmp, A1, A2, len, prec);
+    acb_poly_swap(A1, tmp);
+    acb_poly_mullow(tmp, C1, C2, len, prec);
+    acb_poly_swap(C1, tmp);
+
+    acb_poly_clear(tmp);
+}
+
 static void
 bsplit(acb_poly_t A1, acb_poly_t B1, acb_poly_t C1,
         const acb_poly_struct * a, slong p,
@@ -62,55 +107,124 @@ bsplit(acb_poly_t A1, acb_poly_t B1, acb_poly_t C1,
     {
         slong m;
 
-        acb_poly_t A2, B2, C2, tmp;
+        acb_poly_t A2, B2, C2;
 
         acb_poly_init(A2);
         acb_poly_init(B2);
         acb_poly_init(C2);
-        acb_poly_init(tmp);
 
         m = aa + (bb - aa) / 2;
 
         bsplit(A1, B1, C1, a, p, b, q, z, aa, m, len, prec);
         bsplit(A2, B2, C2, a, p, b, q, z, m, bb, len, prec);
 
-        if (bb - m == 1)  /* B2 = C2 */
-        {
-            if (m - aa == 1)
-                acb_poly_add(B2, A1, C1, prec);
-            else
-                acb_poly_add(B2, A1, B1, prec);
-
-            acb_poly_mullow(B1, B2, C2, len, prec);
-        }
-        else
-        {
-            if (m - aa == 1)
-            {
-                acb_poly_mullow(B1, C1, C2, len, prec);
-            }
-            else
-            {
-                acb_poly_mullow(tmp, B1, C2, len, prec);
-                acb_poly_swap(B1, tmp);
-            }
-
-            acb_poly_mullow(tmp, A1, B2, len, prec);
-            acb_poly_add(B1, B1, tmp, prec);
-        }
-
-        acb_poly_mullow(tmp, A1, A2, len, prec);
-        acb_poly_swap(A1, tmp);
-        acb_poly_mullow(tmp, C1, C2, len, prec);
-        acb_poly_swap(C1, tmp);
+        merge(A1, B1, C1, A2, B2, C2, m - aa, bb - m, len, prec);
 
         acb_poly_clear(A2);
         acb_poly_clear(B2);
         acb_poly_clear(C2);
-        acb_poly_clear(tmp);
     }
 }
 
+typedef struct
+{
+    acb_poly_struct A;
+    acb_poly_struct B;
+    acb_poly_struct C;
+    slong a;
+    slong b;
+}
+bsplit_res_t;
+
+typedef struct
+{
+    const acb_poly_struct * a;
+    slong p;
+    const acb_poly_struct * b;
+    slong q;
+    const acb_poly_struct * z;
+    slong len;
+    slong prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(bsplit_res_t * x, void * args)
+{
+    acb_poly_init(&x->A);
+    acb_poly_init(&x->B);
+    acb_poly_init(&x->C);
+}
+
+static void
+bsplit_clear(bsplit_res_t * x, void * args)
+{
+    acb_poly_clear(&x->A);
+    acb_poly_clear(&x->B);
+    acb_poly_clear(&x->C);
+}
+
+static void
+bsplit_basecase(bsplit_res_t * res, slong aa, slong bb, bsplit_args_t * args)
+{
+    bsplit(&res->A, &res->B, &res->C, args->a, args->p, args->b, args->q,
+        args->z, aa, bb, args->len, args->prec);
+
+    res->a = aa;
+    res->b = bb;
+}
+
+/* res = left */
+static void
+bsplit_merge(bsplit_res_t * res, bsplit_res_t * left, bsplit_res_t * right, bsplit_args_t * args)
+{
+    if (res != left)
+        flint_abort();
+
+    merge(&res->A, &res->B, &res->C, &right->A, &right->B, &right->C,
+        left->b - left->a, right->b - right->a, args->len, args->prec);
+
+    res->b = right->b;
+}
+
+/* same as bsplit, with subtrees evaluated in parallel */
+static void
+bsplit_threaded(acb_poly_t A1, acb_poly_t B1, acb_poly_t C1,
+        const acb_poly_struct * a, slong p,
+        const acb_poly_struct * b, slong q,
+        const acb_poly_t z,
+        slong aa,
+        slong bb,
+        slong len, slong prec)
+{
+    bsplit_res_t res;
+    bsplit_args_t args;
+
+    res.A = *A1;
+    res.B = *B1;
+    res.C = *C1;
+
+    args.a = a;
+    args.p = p;
+    args.b = b;
+    args.q = q;
+    args.z = z;
+    args.len = len;
+    args.prec = prec;
+
+    flint_parallel_binary_splitting(&res,
+        (bsplit_basecase_func_t) bsplit_basecase,
+        (bsplit_merge_func_t) bsplit_merge,
+        sizeof(bsplit_res_t),
+        (bsplit_init_func_t) bsplit_init,
+        (bsplit_clear_func_t) bsplit_clear,
+        &args, aa, bb, 4, -1, FLINT_PARALLEL_BSPLIT_LEFT_INPLACE);
+
+    *A1 = res.A;
+    *B1 = res.B;
+    *C1 = res.C;
+}
+
 void
 acb_hypgeom_pfq_series_sum_bs(acb_poly_t s, acb_poly_t t,
     const acb_poly_struct * a, slong p,
@@ -188,7 +302,7 @@ acb_hypgeom_pfq_series_sum_bs(acb_poly_t s, acb_poly_t t,
     acb_poly_init(v);
     acb_poly_init(w);
 
-    bsplit(u, v, w, a, p, b, q, z, start, n, len, prec);
+    bsplit_threaded(u, v, w, a, p, b, q, z, start, n, len, prec);
 
     if (n - start == 1)
         acb_poly_set(v, w);  /* B1 not set */
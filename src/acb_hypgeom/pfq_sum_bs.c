@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb.h"
 #include "acb_hypgeom.h"
 
@@ -58,6 +59,35 @@ factor(acb_t A, acb_t tmp, acb_srcptr a, slong p, const acb_t z, slong k, slong
     }
 }
 
+/* combines the results for [aa, m) and [m, bb), overwriting B2;
+   B1 and B2 are not set for ranges of length 1 */
+static void
+merge(acb_t A1, acb_t B1, acb_t C1, acb_t A2, acb_t B2, const acb_t C2,
+        slong len1, slong len2, slong prec)
+{
+    if (len2 == 1)  /* B2 = C2 */
+    {
+        if (len1 == 1)
+            acb_add(B2, A1, C1, prec);
+        else
+            acb_add(B2, A1, B1, prec);
+
+        acb_mul(B1, B2, C2, prec);
+    }
+    else
+    {
+        if (len1 == 1)
+            acb_mul(B1, C1, C2, prec);
+        else
+            acb_mul(B1, B1, C2, prec);
+
+        acb_addmul(B1, A1, B2, prec);
+    }
+
+    acb_mul(A1, A1, A2, prec);
+    acb_mul(C1, C1, C2, prec);
+}
+
 static void
 bsplit(acb_t A1, acb_t B1, acb_t C1,
         acb_srcptr a, slong p,
@@ -89,27 +119,7 @@ bsplit(acb_t A1, acb_t B1, acb_t C1,
         bsplit(A1, B1, C1, a, p, b, q, z, aa, m, prec, invz);
         bsplit(A2, B2, C2, a, p, b, q, z, m, bb, prec, invz);
 
-        if (bb - m == 1)  /* B2 = C2 */
-        {
-            if (m - aa == 1)
-                acb_add(B2, A1, C1, prec);
-            else
-                acb_add(B2, A1, B1, prec);
-
-            acb_mul(B1, B2, C2, prec);
-        }
-        else
-        {
-            if (m - aa == 1)
-                acb_mul(B1, C1, C2, prec);
-            else
-                acb_mul(B1, B1, C2, prec);
-
-            acb_addmul(B1, A1, B2, prec);
-        }
-
-        acb_mul(A1, A1, A2, prec);
-        acb_mul(C1, C1, C2, prec);
+        merge(A1, B1, C1, A2, B2, C2, m - aa, bb - m, prec);
 
         acb_clear(A2);
         acb_clear(B2);
@@ -117,6 +127,106 @@ bsplit(acb_t A1, acb_t B1, acb_t C1,
     }
 }
 
+typedef struct
+{
+    acb_struct A;
+    acb_struct B;
+    acb_struct C;
+    slong a;
+    slong b;
+}
+bsplit_res_t;
+
+typedef struct
+{
+    acb_srcptr a;
+    slong p;
+    acb_srcptr b;
+    slong q;
+    acb_srcptr z;
+    slong prec;
+    int invz;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(bsplit_res_t * x, void * args)
+{
+    acb_init(&x->A);
+    acb_init(&x->B);
+    acb_init(&x->C);
+}
+
+static void
+bsplit_clear(bsplit_res_t * x, void * args)
+{
+    acb_clear(&x->A);
+    acb_clear(&x->B);
+    acb_clear(&x->C);
+}
+
+static void
+bsplit_basecase(bsplit_res_t * res, slong aa, slong bb, bsplit_args_t * args)
+{
+    bsplit(&res->A, &res->B, &res->C, args->a, args->p, args->b, args->q,
+        args->z, aa, bb, args->prec, args->invz);
+
+    res->a = aa;
+    res->b = bb;
+}
+
+/* res = left */
+static void
+bsplit_merge(bsplit_res_t * res, bsplit_res_t * left, bsplit_res_t * right, bsplit_args_t * args)
+{
+    if (res != left)
+        flint_abort();
+
+    merge(&res->A, &res->B, &res->C, &right->A, &right->B, &right->C,
+        left->b - left->a, right->b - right->a, args->prec);
+
+    res->b = right->b;
+}
+
+/* same as bsplit, with subtrees evaluated in parallel */
+static void
+bsplit_threaded(acb_t A1, acb_t B1, acb_t C1,
+        acb_srcptr a, slong p,
+        acb_srcptr b, slong q,
+        const acb_t z,
+        slong aa,
+        slong bb,
+        slong prec,
+        int invz)
+{
+    bsplit_res_t res;
+    bsplit_args_t args;
+
+    res.A = *A1;
+    res.B = *B1;
+    res.C = *C1;
+
+    args.a = a;
+    args.p = p;
+    args.b = b;
+    args.q = q;
+    args.z = z;
+    args.prec = prec;
+    args.invz = invz;
+
+    flint_parallel_binary_splitting(&res,
+        (bsplit_basecase_func_t) bsplit_basecase,
+        (bsplit_merge_func_t) bsplit_merge,
+        sizeof(bsplit_res_t),
+        (bsplit_init_func_t) bsplit_init,
+        (bsplit_clear_func_t) bsplit_clear,
+        &args, aa, bb, 8, -1, FLINT_PARALLEL_BSPLIT_LEFT_INPLACE);
+
+    *A1 = res.A;
+    *B1 = res.B;
+    *C1 = res.C;
+}
+
 void
 acb_hypgeom_pfq_sum_bs(acb_t s, acb_t t,
     acb_srcptr a, slong p, acb_srcptr b, slong q, const acb_t z, slong n, slong prec)
@@ -137,7 +247,7 @@ acb_hypgeom_pfq_sum_bs(acb_t s, acb_t t,
     /* we compute to n-1 instead of n to avoid dividing by 0 in the
        denominator when computing a hypergeometric polynomial
        that terminates right before a pole */
-    bsplit(u, v, w, a, p, b, q, z, 0, n - 1, prec, 0);
+    bsplit_threaded(u, v, w, a, p, b, q, z, 0, n - 1, prec, 0);
 
     acb_add(s, u, v, prec); /* s = s + t */
     acb_div(s, s, w, prec);
@@ -178,7 +288,7 @@ acb_hypgeom_pfq_sum_bs_invz(acb_t s, acb_t t,
     /* we compute to n-1 instead of n to avoid dividing by 0 in the
        denominator when computing a hypergeometric polynomial
        that terminates right before a pole */
-    bsplit(u, v, w, a, p, b, q, z, 0, n - 1, prec, 1);
+    bsplit_threaded(u, v, w, a, p, b, q, z, 0, n - 1, prec, 1);
 
     acb_add(s, u, v, prec); /* s = s + t */
     acb_div(s, s, w, prec);
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb.h"
 #include "acb_hypgeom.h"
 
@@ -45,6 +46,38 @@ bsplit(acb_t y, const acb_t x, ulong a, ulong b, slong prec)
     }
 }
 
+typedef struct
+{
+    acb_srcptr x;
+    slong prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(acb_ptr y, void * args)
+{
+    acb_init(y);
+}
+
+static void
+bsplit_clear(acb_ptr y, void * args)
+{
+    acb_clear(y);
+}
+
+static void
+bsplit_basecase(acb_ptr y, slong a, slong b, bsplit_args_t * args)
+{
+    bsplit(y, args->x, a, b, args->prec);
+}
+
+/* res = left */
+static void
+bsplit_merge(acb_ptr res, acb_ptr left, acb_ptr right, bsplit_args_t * args)
+{
+    acb_mul(res, left, right, args->prec);
+}
+
 void
 acb_hypgeom_rising_ui_bs(acb_t res, const acb_t x, ulong n, slong prec)
 {
@@ -59,10 +92,20 @@ acb_hypgeom_rising_ui_bs(acb_t res, const acb_t x, ulong n, slong prec)
 
     {
         acb_t t;
+        bsplit_args_t args;
         slong wp = ARF_PREC_ADD(prec, FLINT_BIT_COUNT(n));
 
+        args.x = x;
+        args.prec = wp;
+
         acb_init(t);
-        bsplit(t, x, 0, n, wp);
+        flint_parallel_binary_splitting(t,
+            (bsplit_basecase_func_t) bsplit_basecase,
+            (bsplit_merge_func_t) bsplit_merge,
+            sizeof(acb_struct),
+            (bsplit_init_func_t) bsplit_init,
+            (bsplit_clear_func_t) bsplit_clear,
+            &args, 0, n, 4, -1, FLINT_PARALLEL_BSPLIT_LEFT_INPLACE);
         acb_set_round(res, t, prec);
         acb_clear(t);
     }
@@ -28,6 +28,8 @@ int main(void)
         acb_t z, s1, s2, t1, t2;
         slong i, p, q, n, prec1, prec2;
 
+        flint_set_num_threads(1 + n_randint(state, 3));
+
         p = n_randint(state, 5);
         q = n_randint(state, 5);
         n = n_randint(state, 300);
@@ -79,7 +81,7 @@ int main(void)
     }
 
     flint_randclear(state);
-    flint_cleanup();
+    flint_cleanup_master();
     flint_printf("PASS\n");
     return 0;
 }
@@ -479,6 +479,9 @@ slong _acb_poly_validate_roots(acb_ptr roots,
 void _acb_poly_refine_roots_durand_kerner(acb_ptr roots,
         acb_srcptr poly, slong len, slong prec);
 
+void _acb_poly_refine_roots_aberth(acb_ptr roots,
+        acb_srcptr poly, slong len, slong prec);
+
 slong _acb_poly_find_roots(acb_ptr roots,
     acb_srcptr poly,
     acb_srcptr initial, slong len, slong maxiter, slong prec);
@@ -9,8 +9,11 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <math.h>
 #include "ulong_extras.h"
+#include "double_extras.h"
 #include "fmpq.h"
+#include "thread_support.h"
 #include "acb_poly.h"
 
 slong
@@ -69,6 +72,265 @@ _acb_poly_roots_initial_values(acb_ptr roots, slong deg, slong prec)
     }
 }
 
+/* Aberth iteration in hardware double precision */
+
+typedef struct
+{
+    const double * c;     /* coefficients, interleaved re/im */
+    const double * z;     /* current roots, interleaved re/im */
+    double * w;           /* corrections */
+    const int * done;
+    slong len;
+}
+_aberth_d_args_t;
+
+/* writes p(z) / p'(z), evaluating the reversed polynomial at 1/z when
+   |z| > 1 to avoid overflow; returns 0 if p(z) = 0 */
+static int
+_newton_quotient_d(double * nre, double * nim, const double * c, slong len,
+    double zr, double zi)
+{
+    double pr, pi, dr, di, t, u, n2;
+    slong i, deg = len - 1;
+    int rev;
+
+    rev = (zr * zr + zi * zi > 1.0);
+
+    if (rev)
+    {
+        t = zr * zr + zi * zi;
+        zr = zr / t;
+        zi = -zi / t;
+    }
+
+    pr = c[2 * (rev ? 0 : deg)];
+    pi = c[2 * (rev ? 0 : deg) + 1];
+    dr = di = 0.0;
+
+    for (i = deg - 1; i >= 0; i--)
+    {
+        slong k = rev ? deg - i : i;
+
+        t = dr * zr - di * zi + pr;
+        di = dr * zi + di * zr + pi;
+        dr = t;
+
+        t = pr * zr - pi * zi + c[2 * k];
+        pi = pr * zi + pi * zr + c[2 * k + 1];
+        pr = t;
+    }
+
+    if (pr == 0.0 && pi == 0.0)
+        return 0;
+
+    if (rev)
+    {
+        /* p(z) / p'(z) = z q(y) / (deg q(y) - y q'(y)) with y = 1/z */
+        t = deg * pr - (zr * dr - zi * di);
+        u = deg * pi - (zr * di + zi * dr);
+        dr = t;
+        di = u;
+
+        /* z = 1/y */
+        n2 = zr * zr + zi * zi;
+        t = (pr * zr + pi * zi) / n2;
+        pi = (pi * zr - pr * zi) / n2;
+        pr = t;
+    }
+
+    n2 = dr * dr + di * di;
+    *nre = (pr * dr + pi * di) / n2;
+    *nim = (pi * dr - pr * di) / n2;
+
+    return 1;
+}
+
+static void
+_aberth_d_worker(slong i, void * args_ptr)
+{
+    _aberth_d_args_t * args = (_aberth_d_args_t *) args_ptr;
+    const double * z = args->z;
+    double nre, nim, sre, sim, a, b, t;
+    slong j, deg = args->len - 1;
+
+    args->w[2 * i] = args->w[2 * i + 1] = 0.0;
+
+    if (args->done[i] || !_newton_quotient_d(&nre, &nim, args->c, args->len,
+                                            z[2 * i], z[2 * i + 1]))
+        return;
+
+    sre = sim = 0.0;
+    for (j = 0; j < deg; j++)
+    {
+        if (j != i)
+        {
+            a = z[2 * i] - z[2 * j];
+            b = z[2 * i + 1] - z[2 * j + 1];
+            t = a * a + b * b;
+
+            if (t != 0.0)
+            {
+                sre += a / t;
+                sim -= b / t;
+            }
+        }
+    }
+
+    /* w = N / (1 - N S) */
+    a = 1.0 - (nre * sre - nim * sim);
+    b = -(nre * sim + nim * sre);
+    t = a * a + b * b;
+
+    args->w[2 * i] = (nre * a + nim * b) / t;
+    args->w[2 * i + 1] = (nim * a - nre * b) / t;
+}
+
+/*
+    Computes approximate roots in double precision, writing them to roots
+    and returning 1 on success (returning 2 if all roots have converged to
+    nearly full double precision). Returns 0 without touching roots if the
+    coefficients or initial values cannot be represented as doubles, or
+    if the iteration breaks down.
+*/
+static int
+_acb_poly_find_roots_d(acb_ptr roots, acb_srcptr poly, acb_srcptr initial,
+    slong len, slong prec)
+{
+    _aberth_d_args_t args;
+    double *c, *z, *w;
+    int *done;
+    slong i, k, iter, deg, e, alldone;
+    arf_t t;
+    int result = 1;
+
+    deg = len - 1;
+
+    e = -ARF_PREC_EXACT;
+    for (i = 0; i < len; i++)
+    {
+        if (!acb_is_finite(poly + i))
+            return 0;
+        e = FLINT_MAX(e, _acb_get_mid_mag(poly + i));
+    }
+
+    if (e == -ARF_PREC_EXACT || e >= ARF_PREC_EXACT)
+        return 0;
+
+    c = flint_malloc(sizeof(double) * 2 * len);
+    z = flint_malloc(sizeof(double) * 2 * deg);
+    w = flint_malloc(sizeof(double) * 2 * deg);
+    done = flint_calloc(deg, sizeof(int));
+    arf_init(t);
+
+    /* normalise the largest coefficient to magnitude about 1 */
+    for (i = 0; i < len; i++)
+    {
+        arf_mul_2exp_si(t, arb_midref(acb_realref(poly + i)), -e);
+        c[2 * i] = arf_get_d(t, ARF_RND_NEAR);
+        arf_mul_2exp_si(t, arb_midref(acb_imagref(poly + i)), -e);
+        c[2 * i + 1] = arf_get_d(t, ARF_RND_NEAR);
+    }
+
+    if (c[2 * deg] == 0.0 && c[2 * deg + 1] == 0.0)
+        result = 0;
+
+    if (result && initial != NULL)
+    {
+        for (i = 0; i < deg && result; i++)
+        {
+            if (_acb_get_mid_mag(initial + i) > 500)
+                result = 0;
+            else
+            {
+                z[2 * i] = arf_get_d(arb_midref(acb_realref(initial + i)), ARF_RND_NEAR);
+                z[2 * i + 1] = arf_get_d(arb_midref(acb_imagref(initial + i)), ARF_RND_NEAR);
+            }
+        }
+    }
+    else if (result)
+    {
+        /* points on a circle whose radius is the geometric mean of the
+           nonzero roots, rotated away from the real axis */
+        double r;
+
+        for (k = 0; c[2 * k] == 0.0 && c[2 * k + 1] == 0.0; k++) ;
+
+        if (k < deg)
+        {
+            r = log(hypot(c[2 * k], c[2 * k + 1]));
+            r -= log(hypot(c[2 * deg], c[2 * deg + 1]));
+            r = exp(r / (deg - k));
+            r = FLINT_MAX(r, ldexp(1.0, -400));
+            r = FLINT_MIN(r, ldexp(1.0, 400));
+        }
+        else
+        {
+            r = 1.0;
+        }
+
+        for (i = 0; i < deg; i++)
+        {
+            z[2 * i] = r * cos(2 * 3.141592653589793 * i / deg + 0.4);
+            z[2 * i + 1] = r * sin(2 * 3.141592653589793 * i / deg + 0.4);
+        }
+    }
+
+    args.c = c;
+    args.z = z;
+    args.w = w;
+    args.done = done;
+    args.len = len;
+
+    alldone = 0;
+    for (iter = 0; iter < 100 && result && !alldone; iter++)
+    {
+        flint_parallel_do(_aberth_d_worker, &args, deg, -1, FLINT_PARALLEL_STRIDED);
+
+        alldone = 1;
+        for (i = 0; i < deg; i++)
+        {
+            if (done[i])
+                continue;
+
+            if (!(fabs(w[2 * i]) < D_INF && fabs(w[2 * i + 1]) < D_INF))
+            {
+                result = 0;
+                break;
+            }
+
+            z[2 * i] -= w[2 * i];
+            z[2 * i + 1] -= w[2 * i + 1];
+
+            if (fabs(w[2 * i]) + fabs(w[2 * i + 1]) <=
+                    ldexp(fabs(z[2 * i]) + fabs(z[2 * i + 1]), -48))
+                done[i] = 1;
+            else
+                alldone = 0;
+        }
+    }
+
+    if (result)
+    {
+        for (i = 0; i < deg; i++)
+        {
+            acb_set_d_d(roots + i, z[2 * i], z[2 * i + 1]);
+            acb_set_round(roots + i, roots + i, prec);
+            acb_get_mid(roots + i, roots + i);
+        }
+
+        if (alldone)
+            result = 2;
+    }
+
+    flint_free(c);
+    flint_free(z);
+    flint_free(w);
+    flint_free(done);
+    arf_clear(t);
+
+    return result;
+}
+
 slong
 _acb_poly_find_roots(acb_ptr roots,
     acb_srcptr poly,
@@ -101,14 +363,24 @@ _acb_poly_find_roots(acb_ptr roots,
         return 1;
     }
 
-    if (initial == NULL)
-        _acb_poly_roots_initial_values(roots, deg, prec);
-    else
-        _acb_vec_set(roots, initial, deg);
-
     if (maxiter == 0)
         maxiter = 2 * deg + n_sqrt(prec);
 
+    /* start from a double precision solution when possible; at
+       low precision, that solution is as good as refining it */
+    switch (_acb_poly_find_roots_d(roots, poly, initial, len, prec))
+    {
+        case 0:
+            if (initial == NULL)
+                _acb_poly_roots_initial_values(roots, deg, prec);
+            else
+                _acb_vec_set(roots, initial, deg);
+            break;
+        case 2:
+            if (prec <= 53)
+                maxiter = 0;
+    }
+
     for (iter = 0; iter < maxiter; iter++)
     {
         max_rootmag = -ARF_PREC_EXACT;
@@ -118,7 +390,7 @@ _acb_poly_find_roots(acb_ptr roots,
             max_rootmag = FLINT_MAX(rootmag, max_rootmag);
         }
 
-        _acb_poly_refine_roots_durand_kerner(roots, poly, len, prec);
+        _acb_poly_refine_roots_aberth(roots, poly, len, prec);
 
         max_correction = -ARF_PREC_EXACT;
         for (i = 0; i < deg; i++)
@@ -0,0 +1,243 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include "double_extras.h"
+#include "thread_support.h"
+#include "acb_poly.h"
+
+/*
+    One Aberth step for root i is z_i <- z_i - w_i with
+
+        w_i = N_i / (1 - N_i S_i),   N_i = p(z_i) / p'(z_i),
+        S_i = sum_{j != i} 1 / (z_i - z_j).
+
+    The Newton quotient N_i determines the accuracy of the step, while an
+    error in S_i only perturbs w_i by O(|N_i|^2), so S_i is always computed
+    in hardware double arithmetic. Differences that suffer from cancellation
+    are recomputed from the arf midpoints. All updates use the old roots
+    (Jacobi style), making the per-root work independent.
+*/
+
+/* roots below this magnitude (and their reciprocal distances) are safe
+   to handle in double precision */
+#define ABERTH_D_MAX_EXP 500
+
+static void
+_acb_mid_get_d(double * re, double * im, const acb_t z)
+{
+    *re = arf_get_d(arb_midref(acb_realref(z)), ARF_RND_NEAR);
+    *im = arf_get_d(arb_midref(acb_imagref(z)), ARF_RND_NEAR);
+}
+
+/* (re, im) <- 1 / (re, im) */
+static __inline__ void
+_d_complex_inv(double * re, double * im)
+{
+    double t = (*re) * (*re) + (*im) * (*im);
+    *re = *re / t;
+    *im = -(*im) / t;
+}
+
+/* sum_{j != i} 1 / (z_i - z_j) */
+static void
+_aberth_sum_d(double * sre, double * sim, slong i, acb_srcptr roots,
+    const double * zd, slong n)
+{
+    double a, b, c, d, s, t;
+    slong j;
+
+    a = zd[2 * i];
+    b = zd[2 * i + 1];
+    s = t = 0.0;
+
+    for (j = 0; j < n; j++)
+    {
+        if (j == i)
+            continue;
+
+        c = a - zd[2 * j];
+        d = b - zd[2 * j + 1];
+
+        /* cancellation: redo the subtraction with the exact midpoints */
+        if (fabs(c) + fabs(d) <= ldexp(fabs(a) + fabs(b), -40))
+        {
+            acb_t u;
+            acb_init(u);
+            arf_sub(arb_midref(acb_realref(u)), arb_midref(acb_realref(roots + i)),
+                arb_midref(acb_realref(roots + j)), 64, ARF_RND_DOWN);
+            arf_sub(arb_midref(acb_imagref(u)), arb_midref(acb_imagref(roots + i)),
+                arb_midref(acb_imagref(roots + j)), 64, ARF_RND_DOWN);
+            _acb_mid_get_d(&c, &d, u);
+            acb_clear(u);
+
+            /* coincident approximations, or below double range */
+            if (fabs(c) + fabs(d) < ldexp(1.0, -ABERTH_D_MAX_EXP))
+                continue;
+        }
+
+        _d_complex_inv(&c, &d);
+        s += c;
+        t += d;
+    }
+
+    *sre = s;
+    *sim = t;
+}
+
+/* writes p(z) to y and p'(z) to dy, ignoring radii */
+static void
+_acb_poly_evaluate2_mid(acb_t y, acb_t dy, acb_srcptr poly, slong len,
+    const acb_t z, slong prec)
+{
+    arf_t re, im;
+    slong i;
+
+    arf_init(re);
+    arf_init(im);
+
+    acb_zero(dy);
+    acb_get_mid(y, poly + len - 1);
+
+#define YR arb_midref(acb_realref(y))
+#define YI arb_midref(acb_imagref(y))
+#define DR arb_midref(acb_realref(dy))
+#define DI arb_midref(acb_imagref(dy))
+#define ZR arb_midref(acb_realref(z))
+#define ZI arb_midref(acb_imagref(z))
+
+    for (i = len - 2; i >= 0; i--)
+    {
+        arf_complex_mul(re, im, DR, DI, ZR, ZI, prec, ARF_RND_DOWN);
+        arf_add(DR, re, YR, prec, ARF_RND_DOWN);
+        arf_add(DI, im, YI, prec, ARF_RND_DOWN);
+
+        arf_complex_mul(re, im, YR, YI, ZR, ZI, prec, ARF_RND_DOWN);
+        arf_add(YR, re, arb_midref(acb_realref(poly + i)), prec, ARF_RND_DOWN);
+        arf_add(YI, im, arb_midref(acb_imagref(poly + i)), prec, ARF_RND_DOWN);
+    }
+
+#undef YR
+#undef YI
+#undef DR
+#undef DI
+#undef ZR
+#undef ZI
+
+    arf_clear(re);
+    arf_clear(im);
+}
+
+typedef struct
+{
+    acb_ptr corr;
+    acb_srcptr roots;
+    const double * zd;
+    acb_srcptr poly;
+    slong len;
+    slong prec;
+}
+_aberth_args_t;
+
+static void
+_aberth_worker(slong i, void * args_ptr)
+{
+    _aberth_args_t * args = (_aberth_args_t *) args_ptr;
+    acb_ptr w = args->corr + i;
+    acb_t y, dy;
+    double sre, sim, nre, nim, tre, tim;
+    slong prec = args->prec;
+
+    acb_init(y);
+    acb_init(dy);
+
+    _acb_poly_evaluate2_mid(y, dy, args->poly, args->len, args->roots + i, prec);
+
+    if (acb_is_zero(y) || acb_is_zero(dy))
+    {
+        acb_zero(w);
+    }
+    else
+    {
+        /* N = p / p' */
+        acb_div(w, y, dy, prec);
+        acb_get_mid(w, w);
+
+        _aberth_sum_d(&sre, &sim, i, args->roots, args->zd, args->len - 1);
+        _acb_mid_get_d(&nre, &nim, w);
+
+        /* 1 / (1 - N S) */
+        tre = 1.0 - (nre * sre - nim * sim);
+        tim = -(nre * sim + nim * sre);
+
+        if (tre != 0.0 || tim != 0.0)
+        {
+            _d_complex_inv(&tre, &tim);
+
+            if (fabs(tre) < D_INF && fabs(tim) < D_INF)
+            {
+                acb_set_d_d(y, tre, tim);
+                acb_mul(w, w, y, prec);
+                acb_get_mid(w, w);
+            }
+        }
+    }
+
+    acb_clear(y);
+    acb_clear(dy);
+}
+
+void
+_acb_poly_refine_roots_aberth(acb_ptr roots, acb_srcptr poly, slong len, slong prec)
+{
+    _aberth_args_t args;
+    acb_ptr corr;
+    double * zd;
+    slong i, deg = len - 1;
+
+    for (i = 0; i < deg; i++)
+    {
+        if (arf_cmpabs_2exp_si(arb_midref(acb_realref(roots + i)), ABERTH_D_MAX_EXP) > 0 ||
+            arf_cmpabs_2exp_si(arb_midref(acb_imagref(roots + i)), ABERTH_D_MAX_EXP) > 0 ||
+            !acb_is_finite(roots + i))
+        {
+            _acb_poly_refine_roots_durand_kerner(roots, poly, len, prec);
+            return;
+        }
+    }
+
+    corr = _acb_vec_init(deg);
+    zd = flint_malloc(sizeof(double) * 2 * deg);
+
+    for (i = 0; i < deg; i++)
+        _acb_mid_get_d(zd + 2 * i, zd + 2 * i + 1, roots + i);
+
+    args.corr = corr;
+    args.roots = roots;
+    args.zd = zd;
+    args.poly = poly;
+    args.len = len;
+    args.prec = prec;
+
+    flint_parallel_do(_aberth_worker, &args, deg, -1, FLINT_PARALLEL_STRIDED);
+
+    for (i = 0; i < deg; i++)
+    {
+        arf_sub(arb_midref(acb_realref(roots + i)), arb_midref(acb_realref(roots + i)),
+            arb_midref(acb_realref(corr + i)), prec, ARF_RND_DOWN);
+        arf_sub(arb_midref(acb_imagref(roots + i)), arb_midref(acb_imagref(roots + i)),
+            arb_midref(acb_imagref(corr + i)), prec, ARF_RND_DOWN);
+
+        arf_get_mag(arb_radref(acb_realref(roots + i)), arb_midref(acb_realref(corr + i)));
+        arf_get_mag(arb_radref(acb_imagref(roots + i)), arb_midref(acb_imagref(corr + i)));
+    }
+
+    _acb_vec_clear(corr, deg);
+    flint_free(zd);
+}
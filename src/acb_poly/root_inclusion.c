@@ -27,14 +27,22 @@ _acb_poly_root_inclusion(acb_t r, const acb_t m,
     mag_zero(arb_radref(acb_realref(r)));
     mag_zero(arb_radref(acb_imagref(r)));
 
-    _acb_poly_evaluate(t, poly, len, r, prec);
+    /* with complex balls, Horner's rule inflates the radii by a factor
+       up to sqrt(2) per step; rectangular splitting avoids this */
+    if (len >= 32)
+        _acb_poly_evaluate_rectangular(t, poly, len, r, prec);
+    else
+        _acb_poly_evaluate(t, poly, len, r, prec);
     acb_get_abs_ubound_arf(u, t, MAG_BITS);
 
     /* it could happen that we have an exact root, in which case
        we should avoid dividing by the derivative */
     if (!arf_is_zero(u))
     {
-        _acb_poly_evaluate(t, polyder, len - 1, r, prec);
+        if (len >= 32)
+            _acb_poly_evaluate_rectangular(t, polyder, len - 1, r, prec);
+        else
+            _acb_poly_evaluate(t, polyder, len - 1, r, prec);
         acb_inv(t, t, MAG_BITS);
         acb_get_abs_ubound_arf(v, t, MAG_BITS);
 
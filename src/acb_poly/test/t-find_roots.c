@@ -37,8 +37,13 @@ int main(void)
         acb_poly_init(B);
         acb_poly_init(C);
 
+        flint_set_num_threads(1 + n_randint(state, 3));
+
         do {
-            acb_poly_randtest(A, state, 2 + n_randint(state, 15), prec, 5);
+            if (n_randint(state, 10) == 0)
+                acb_poly_randtest(A, state, 2 + n_randint(state, 100), prec, 5);
+            else
+                acb_poly_randtest(A, state, 2 + n_randint(state, 15), prec, 5);
         } while (A->length == 0);
         deg = A->length - 1;
 
@@ -9,8 +9,43 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <stdlib.h>
+#include "thread_support.h"
 #include "acb_poly.h"
 
+typedef struct
+{
+    acb_ptr roots;
+    acb_srcptr poly;
+    acb_srcptr deriv;
+    slong len;
+    slong prec;
+}
+_inclusion_args_t;
+
+static void
+_inclusion_worker(slong i, void * args_ptr)
+{
+    _inclusion_args_t * args = (_inclusion_args_t *) args_ptr;
+
+    _acb_poly_root_inclusion(args->roots + i, args->roots + i,
+        args->poly, args->deriv, args->len, args->prec);
+}
+
+typedef struct
+{
+    arf_struct lo;
+    arf_struct hi;
+    slong i;
+}
+_interval_t;
+
+static int
+_interval_cmp(const void * a, const void * b)
+{
+    return arf_cmp(&((const _interval_t *) a)->lo, &((const _interval_t *) b)->lo);
+}
+
 slong
 _acb_poly_validate_roots(acb_ptr roots,
         acb_srcptr poly, slong len, slong prec)
@@ -19,6 +54,8 @@ _acb_poly_validate_roots(acb_ptr roots,
     slong isolated, nonisolated, total_isolated;
     acb_ptr deriv;
     acb_ptr tmp;
+    _interval_t * re;
+    _inclusion_args_t args;
     int *overlap;
 
     deg = len - 1;
@@ -26,24 +63,48 @@ _acb_poly_validate_roots(acb_ptr roots,
     deriv = _acb_vec_init(deg);
     overlap = flint_calloc(deg, sizeof(int));
     tmp = flint_malloc(sizeof(acb_struct) * deg);
+    re = flint_malloc(sizeof(_interval_t) * deg);
 
     _acb_poly_derivative(deriv, poly, len, prec);
 
     /* compute an inclusion interval for each point */
+    args.roots = roots;
+    args.poly = poly;
+    args.deriv = deriv;
+    args.len = len;
+    args.prec = prec;
+
+    flint_parallel_do(_inclusion_worker, &args, deg, -1, FLINT_PARALLEL_STRIDED);
+
+    /* find which points do not overlap with any other points, by
+       sweeping over the real parts sorted by their lower endpoints */
     for (i = 0; i < deg; i++)
     {
-        _acb_poly_root_inclusion(roots + i, roots + i,
-            poly, deriv, len, prec);
+        arf_init(&re[i].lo);
+        arf_init(&re[i].hi);
+        re[i].i = i;
+
+        if (arb_is_finite(acb_realref(roots + i)))
+        {
+            arb_get_lbound_arf(&re[i].lo, acb_realref(roots + i), MAG_BITS);
+            arb_get_ubound_arf(&re[i].hi, acb_realref(roots + i), MAG_BITS);
+        }
+        else
+        {
+            arf_neg_inf(&re[i].lo);
+            arf_pos_inf(&re[i].hi);
+        }
     }
 
-    /* find which points do not overlap with any other points */
+    qsort(re, deg, sizeof(_interval_t), _interval_cmp);
+
     for (i = 0; i < deg; i++)
     {
-        for (j = i + 1; j < deg; j++)
+        for (j = i + 1; j < deg && arf_cmp(&re[j].lo, &re[i].hi) <= 0; j++)
         {
-            if (acb_overlaps(roots + i, roots + j))
+            if (acb_overlaps(roots + re[i].i, roots + re[j].i))
             {
-                overlap[i] = overlap[j] = 1;
+                overlap[re[i].i] = overlap[re[j].i] = 1;
             }
         }
     }
@@ -72,10 +133,16 @@ _acb_poly_validate_roots(acb_ptr roots,
         }
     }
 
+    for (i = 0; i < deg; i++)
+    {
+        arf_clear(&re[i].lo);
+        arf_clear(&re[i].hi);
+    }
+
     _acb_vec_clear(deriv, deg);
     flint_free(tmp);
+    flint_free(re);
     flint_free(overlap);
 
     return isolated;
 }
-
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz.h"
 #include "aprcl.h"
 
@@ -149,12 +150,54 @@ _aprcl_is_gausspower_from_unity_p(ulong q, ulong r, const fmpz_t n)
     return result;
 }
 
+/*
+    The Gauss sum computations for the different triples (q, p, k) with
+    p^k | q - 1 are independent and dominate the running time, so they are
+    collected as tasks and may run in parallel. The bookkeeping of (Lp)
+    depends on the order of the tasks and is replayed serially afterwards.
+*/
+typedef struct
+{
+    ulong q;
+    ulong p;
+    ulong k;
+    slong unity_power;      /* -2 if gcd(q*r, n) != 1 */
+}
+_aprcl_gauss_task_struct;
+
+typedef struct
+{
+    _aprcl_gauss_task_struct * tasks;
+    const fmpz * n;
+}
+_aprcl_gauss_args_struct;
+
+static void
+_aprcl_is_prime_gauss_worker(slong i, void * _args)
+{
+    _aprcl_gauss_args_struct * args = (_aprcl_gauss_args_struct *) _args;
+    _aprcl_gauss_task_struct * task = args->tasks + i;
+    ulong r;
+
+    /* r = p^k */
+    r = n_pow(task->p, task->k);
+
+    if (aprcl_is_mul_coprime_ui_ui(task->q, r, args->n) == 0)
+        task->unity_power = -2;
+    else
+        task->unity_power = _aprcl_is_gausspower_from_unity_p(task->q, r, args->n);
+}
+
 primality_test_status
 _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
 {
     int *lambdas;
+    int state, pind;
     ulong i, j, k, nmod4;
+    slong t, num_tasks, num_threads;
     primality_test_status result;
+    _aprcl_gauss_task_struct * tasks;
+    _aprcl_gauss_args_struct args;
 
     /*
         Condition (Lp) is satisfied iff:
@@ -169,16 +212,19 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
         lambdas[i] = 0;
 
     result = PROBABPRIME;
+    num_threads = flint_get_num_threads();
 
     /* nmod4 = n % 4 */
     nmod4 = fmpz_tdiv_ui(n, 4);
 
-    /* for every prime q | s */
+    /* collect (q, p, k) for every prime q | s and p^k | q - 1 */
+    tasks = NULL;
+    num_tasks = 0;
+
     for (i = 0; i < config->qs->num; i++)
     {
         n_factor_t q_factors;
         ulong q;
-        if (result == COMPOSITE) break;
 
         q = fmpz_get_ui(config->qs->p + i);
 
@@ -193,15 +239,42 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
         n_factor_init(&q_factors);
         n_factor(&q_factors, q - 1, 1);
 
-        /* for every prime p | q - 1 */
         for (j = 0; j < q_factors.num; j++)
         {
-            int state, pind;
-            ulong p;
-            if (result == COMPOSITE) break;
+            tasks = flint_realloc(tasks, (num_tasks + q_factors.exp[j]) *
+                                          sizeof(_aprcl_gauss_task_struct));
 
-            p = q_factors.p[j];
+            for (k = 1; k <= q_factors.exp[j]; k++)
+            {
+                tasks[num_tasks].q = q;
+                tasks[num_tasks].p = q_factors.p[j];
+                tasks[num_tasks].k = k;
+                num_tasks++;
+            }
+        }
+    }
+
+    args.tasks = tasks;
+    args.n = n;
+
+    if (result == PROBABPRIME && num_threads > 1 && num_tasks > 1)
+        flint_parallel_do(_aprcl_is_prime_gauss_worker, &args, num_tasks,
+                                                -1, FLINT_PARALLEL_STRIDED);
+
+    state = 0;
+    pind = 0;
 
+    for (t = 0; t < num_tasks && result == PROBABPRIME; t++)
+    {
+        ulong q, p, r;
+        int unity_power;
+
+        q = tasks[t].q;
+        p = tasks[t].p;
+
+        /* first power of a new prime p | q - 1 */
+        if (tasks[t].k == 1)
+        {
             pind = _aprcl_p_ind(config, p);
             state = lambdas[pind];
 
@@ -243,82 +316,73 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
                     lambdas[pind] = state;
                 }
             }
+        }
 
-            /* for every prime power p^k | q - 1 */
-            for (k = 1; k <= q_factors.exp[j]; k++)
-            {
-                int unity_power;
-                ulong r;
+        /* r = p^k */
+        r = n_pow(p, tasks[t].k);
 
-                /* r = p^k */
-                r = n_pow(p, k);
+        if (num_threads <= 1 || num_tasks <= 1)
+            _aprcl_is_prime_gauss_worker(t, &args);
 
-                /* if gcd(q*r, n) != 1 */
-                if (aprcl_is_mul_coprime_ui_ui(q, r, n) == 0)
-                {
-                    result = COMPOSITE;
-                    break;
-                }
+        /*
+            if gcd(q*r, n) != 1, or there is no z such that
+            \tau(\chi^n) = \zeta_r^z*\tau^n(\chi), then n is composite;
+            otherwise unity_power = z
+        */
+        unity_power = tasks[t].unity_power;
 
-                /*
-                    if exists z such that \tau(\chi^n) = \zeta_r^z*\tau^n(\chi)
-                    unity_power = z; otherwise unity_power = -1
-                */
-                unity_power = _aprcl_is_gausspower_from_unity_p(q, r, n);
+        if (unity_power < 0)
+        {
+            result = COMPOSITE;
+            break;
+        }
 
-                /* if unity_power < 0 then n is composite */
-                if (unity_power < 0)
-                {
-                    result = COMPOSITE;
-                    break;
-                }
+        /*
+            (Lp.c)
+            if p > 2 then (Lp) is equal to:
+                (\tau(\chi))^(\sigma_n - n) is a generator of cyclic
+                group <\zeta_r>
+        */
+        if (p > 2 && state == 0 && unity_power > 0)
+        {
+            ulong upow = unity_power;
+            /*
+                if gcd(r, unity_power) = 1 then
+                (\tau(\chi))^(\sigma_n - n) is a generator
+            */
+            if (n_gcd(r, upow) == 1)
+            {
+                state = 3;
+                lambdas[pind] = state;
+            }
+        }
 
-                /*
-                    (Lp.c)
-                    if p > 2 then (Lp) is equal to:
-                        (\tau(\chi))^(\sigma_n - n) is a generator of cyclic
-                        group <\zeta_r>
-                */
-                if (p > 2 && state == 0 && unity_power > 0)
+        /*
+            (Lp.b)
+            check 2) of (Lp) if p == 2 and nmod4 == 3
+        */
+        if (p == 2 && unity_power > 0
+            && (state == 0 || state == 1) && nmod4 == 3)
+        {
+            ulong upow = unity_power;
+            if (n_gcd(r, upow) == 1)
+            {
+                if (state == 0)
                 {
-                    ulong upow = unity_power;
-                    /*
-                        if gcd(r, unity_power) = 1 then
-                        (\tau(\chi))^(\sigma_n - n) is a generator
-                    */
-                    if (n_gcd(r, upow) == 1)
-                    {
-                        state = 3;
-                        lambdas[pind] = state;
-                    }
+                    state = 2;
+                    lambdas[pind] = state;
                 }
-
-                /*
-                    (Lp.b)
-                    check 2) of (Lp) if p == 2 and nmod4 == 3
-                */
-                if (p == 2 && unity_power > 0
-                    && (state == 0 || state == 1) && nmod4 == 3)
+                if (state == 1)
                 {
-                    ulong upow = unity_power;
-                    if (n_gcd(r, upow) == 1)
-                    {
-                        if (state == 0)
-                        {
-                            state = 2;
-                            lambdas[pind] = state;
-                        }
-                        if (state == 1)
-                        {
-                            state = 3;
-                            lambdas[pind] = state;
-                        }
-                    }
+                    state = 3;
+                    lambdas[pind] = state;
                 }
             }
         }
     }
 
+    flint_free(tasks);
+
     /*
         if for some p we have not proved (Lp)
         then n can be as prime or composite
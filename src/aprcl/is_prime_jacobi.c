@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz.h"
 #include "fmpz_mod.h"
 #include "aprcl.h"
@@ -537,13 +538,185 @@ _aprcl_is_prime_jacobi_additional_test(const fmpz_t n, ulong p)
     return result;
 }
 
+/*
+    The pseudoprime tests for the different pairs (p, q) with p | q - 1
+    are independent, so we collect them as tasks. Workers only read
+    lambdas; whether a task proves (Lp) is recorded in the task and folded
+    into lambdas afterwards, in the same order as a serial run.
+*/
+typedef struct
+{
+    ulong q;
+    ulong p;
+    ulong k;
+    int pind;
+    int composite;      /* the task proves n composite */
+    int lambda;         /* the task proves (Lp) */
+}
+_aprcl_jacobi_task_struct;
+
+typedef struct
+{
+    _aprcl_jacobi_task_struct * tasks;
+    const int * lambdas;
+    const fmpz * n;
+    const fmpz * ndec;
+    const fmpz * ndecdiv;
+    ulong nmod4;
+}
+_aprcl_jacobi_args_struct;
+
+static void
+_aprcl_is_prime_jacobi_worker(slong i, void * _args)
+{
+    _aprcl_jacobi_args_struct * args = (_aprcl_jacobi_args_struct *) _args;
+    _aprcl_jacobi_task_struct * task = args->tasks + i;
+    const fmpz * n = args->n;
+    ulong q = task->q, p = task->p, k = task->k, v, r;
+    int lambda_known = args->lambdas[task->pind];
+    slong h;
+    fmpz_t u, q_pow;
+    unity_zp jacobi_sum, jacobi_sum2_1, jacobi_sum2_2;
+
+    task->composite = 0;
+    task->lambda = 0;
+
+    fmpz_init(u);
+    fmpz_init(q_pow);
+
+    r = n_pow(p, k);        /* set r = p^k */
+
+    /* if lambdas_p == 0 set q_pow = q^{(n - 1) / 2} and p == 2 */
+    fmpz_set_ui(q_pow, q);
+    if (lambda_known == 0 && p == 2 && k >= 2)
+        fmpz_powm(q_pow, q_pow, args->ndecdiv, n);
+
+    /* compute u = n / r and v = n % r */
+    fmpz_tdiv_q_ui(u, n, r);
+    v = fmpz_tdiv_ui(n, r);
+
+    /* init unity_zp for jacobi sums */
+    unity_zp_init(jacobi_sum, p, k, n);
+    unity_zp_init(jacobi_sum2_1, p, k, n);
+    unity_zp_init(jacobi_sum2_2, p, k, n);
+
+    /* compute set jacobi_sum = J(p, q) */
+    unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
+    /* if p == 2 and k >= 3 we also need to compute J_2(q) and J_3(q) */
+    if (p == 2 && k >= 3)
+    {
+        /* compute J_3(q) */
+        unity_zp_jacobi_sum_2q_one(jacobi_sum2_1, q);
+        /* compute J_2(q) */
+        unity_zp_jacobi_sum_2q_two(jacobi_sum2_2, q);
+    }
+
+    if (p == 2 && k == 1)
+    {
+        h = _aprcl_is_prime_jacobi_check_21(q, n);
+
+        /* if h not found then n is composite */
+        if (h < 0)
+            task->composite = 1;
+
+        /*
+            check (Lp);
+            if h == 1 (unity root = -1)
+            and n % 4 == 1 then lambdas_2 = 1
+        */
+        if (lambda_known == 0 && h == 1 && args->nmod4 == 1)
+            task->lambda = 1;
+    }
+
+    if (p == 2 && k == 2)
+    {
+        h = _aprcl_is_prime_jacobi_check_22(jacobi_sum, u, v, q);
+
+        /* if h not found then n is composite */
+        if (h < 0)
+            task->composite = 1;
+
+        /*
+            check (Lp);
+            if h == 1 or 3 (unity root = -i or i)
+            and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
+        */
+        if (h % 2 != 0 && lambda_known == 0 && fmpz_equal(q_pow, args->ndec))
+            task->lambda = 1;
+    }
+
+    if (p == 2 && k >= 3)
+    {
+        h = _aprcl_is_prime_jacobi_check_2k(jacobi_sum,
+                jacobi_sum2_1, jacobi_sum2_2, u, v);
+
+        /* if h not found then n is composite */
+        if (h < 0)
+            task->composite = 1;
+
+        /*
+            check (Lp);
+            if h % 2 != 0 (primitive unity root)
+            and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
+        */
+        if (h % 2 != 0 && lambda_known == 0 && fmpz_equal(q_pow, args->ndec))
+            task->lambda = 1;
+    }
+
+    if (p != 2)
+    {
+        h = _aprcl_is_prime_jacobi_check_pk(jacobi_sum, u, v);
+
+        /* if h not found then n is composite */
+        if (h < 0)
+            task->composite = 1;
+
+        /*
+            check (Lp);
+            if h % p != 0 (primitive unity root)
+            then lambdas_p = 1
+        */
+        if (h % p != 0 && lambda_known == 0)
+            task->lambda = 1;
+    }
+
+    /* clear unity_zp for jacobi sums */
+    unity_zp_clear(jacobi_sum);
+    unity_zp_clear(jacobi_sum2_1);
+    unity_zp_clear(jacobi_sum2_2);
+
+    fmpz_clear(u);
+    fmpz_clear(q_pow);
+}
+
+typedef struct
+{
+    const fmpz * n;
+    const ulong * p;
+    const int * lambdas;
+    int * res;
+}
+_aprcl_additional_args_struct;
+
+static void
+_aprcl_is_prime_jacobi_additional_worker(slong i, void * _args)
+{
+    _aprcl_additional_args_struct * args = (_aprcl_additional_args_struct *) _args;
+
+    if (args->lambdas[i] == 0)
+        args->res[i] = _aprcl_is_prime_jacobi_additional_test(args->n, args->p[i]);
+}
+
 primality_test_status
 _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
 {
     int *lambdas;
     ulong i, j, nmod4;
+    slong num_tasks, num_threads;
     primality_test_status result;
-    fmpz_t temp, p2, ndec, ndecdiv, u, q_pow;
+    fmpz_t temp, p2, ndec, ndecdiv;
+    _aprcl_jacobi_task_struct * tasks;
+    _aprcl_jacobi_args_struct args;
 
     /* deal with primes that can divide R */
     if (fmpz_cmp_ui(n, 2) == 0)
@@ -553,8 +726,6 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
        return PRIME;
 
     /* initialization */
-    fmpz_init(q_pow);
-    fmpz_init(u);
     fmpz_init(temp);
     fmpz_init(p2);
     fmpz_init(ndecdiv);
@@ -563,6 +734,7 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
     fmpz_fdiv_q_2exp(ndecdiv, ndec, 1);
 
     result = PROBABPRIME;
+    num_threads = flint_get_num_threads();
 
     /*
         Condition (Lp) is satisfied iff:
@@ -603,8 +775,11 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
         result = COMPOSITE;
 
     /* Begin pseudoprime tests with Jacobi sums step. */
-    /* for every prime q | s */
-    for (i = 0; i < config->qs->num; i++)
+    /* collect the pairs (p, q) for every prime q | s and p | q - 1 */
+    tasks = NULL;
+    num_tasks = 0;
+
+    for (i = 0; i < config->qs->num && result != COMPOSITE; i++)
     {
         n_factor_t q_factors;
         ulong q;
@@ -612,9 +787,6 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
         if (config->qs_used[i] == 0)
             continue;
 
-        if (result == COMPOSITE)
-            break;
-
         q = fmpz_get_ui(config->qs->p + i); /* set q; q must get into ulong */
 
         /* if n == q; q - prime => n - prime */
@@ -628,136 +800,80 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
         n_factor_init(&q_factors);
         n_factor(&q_factors, q - 1, 1);
 
+        tasks = flint_realloc(tasks, (num_tasks + q_factors.num) *
+                                    sizeof(_aprcl_jacobi_task_struct));
+
         /* for every prime p | q - 1 */
         for (j = 0; j < q_factors.num; j++)
         {
-            int pind;
-            slong h;
-            ulong v, p, r, k;
-            unity_zp jacobi_sum, jacobi_sum2_1, jacobi_sum2_2;
-
-            if (result == COMPOSITE)
-                break;
-
-            p = q_factors.p[j];     /* set p; p | q - 1 */
-            k = q_factors.exp[j];   /* set max k for which p^k | q - 1 */
-            r = n_pow(p, k);        /* set r = p^k */
-            pind = _aprcl_p_ind(config, p);  /* find index of p in lambdas */
-
-            /* if lambdas_p == 0 set q_pow = q^{(n - 1) / 2} and p == 2 */
-            fmpz_set_ui(q_pow, q);
-            if (lambdas[pind] == 0 && p == 2)
-                fmpz_powm(q_pow, q_pow, ndecdiv, n);
-
-            /* compute u = n / r and v = n % r */
-            fmpz_tdiv_q_ui(u, n, r);
-            v = fmpz_tdiv_ui(n, r);
-
-            /* init unity_zp for jacobi sums */
-            unity_zp_init(jacobi_sum, p, k, n);
-            unity_zp_init(jacobi_sum2_1, p, k, n);
-            unity_zp_init(jacobi_sum2_2, p, k, n);
-
-            /* compute set jacobi_sum = J(p, q) */
-            unity_zp_jacobi_sum_pq(jacobi_sum, q, p);
-            /* if p == 2 and k >= 3 we also need to compute J_2(q) and J_3(q) */
-            if (p == 2 && k >= 3)
-            {
-                /* compute J_3(q) */
-                unity_zp_jacobi_sum_2q_one(jacobi_sum2_1, q);
-                /* compute J_2(q) */
-                unity_zp_jacobi_sum_2q_two(jacobi_sum2_2, q);
-            }
-
-            if (p == 2 && k == 1)
-            {
-                h = _aprcl_is_prime_jacobi_check_21(q, n);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /*
-                    check (Lp);
-                    if h == 1 (unity root = -1)
-                    and n % 4 == 1 then lambdas_2 = 1
-                */
-                if (lambdas[pind] == 0 && h == 1 && nmod4 == 1)
-                    lambdas[pind] = 1;
-            }
-
-            if (p == 2 && k == 2)
-            {
-                h = _aprcl_is_prime_jacobi_check_22(jacobi_sum, u, v, q);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /*
-                    check (Lp);
-                    if h == 1 or 3 (unity root = -i or i)
-                    and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
-                */
-                if (h % 2 != 0 && lambdas[pind] == 0 && fmpz_equal(q_pow, ndec))
-                    lambdas[pind] = 1;
-            }
-
-            if (p == 2 && k >= 3)
-            {
-                h = _aprcl_is_prime_jacobi_check_2k(jacobi_sum,
-                        jacobi_sum2_1, jacobi_sum2_2, u, v);
+            tasks[num_tasks].q = q;
+            tasks[num_tasks].p = q_factors.p[j];      /* set p; p | q - 1 */
+            /* set max k for which p^k | q - 1 */
+            tasks[num_tasks].k = q_factors.exp[j];
+            /* find index of p in lambdas */
+            tasks[num_tasks].pind = _aprcl_p_ind(config, q_factors.p[j]);
+            num_tasks++;
+        }
+    }
 
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
+    if (result == PROBABPRIME)
+    {
+        args.tasks = tasks;
+        args.lambdas = lambdas;
+        args.n = n;
+        args.ndec = ndec;
+        args.ndecdiv = ndecdiv;
+        args.nmod4 = nmod4;
+
+        if (num_threads > 1 && num_tasks > 1)
+            flint_parallel_do(_aprcl_is_prime_jacobi_worker, &args,
+                                    num_tasks, -1, FLINT_PARALLEL_STRIDED);
+
+        for (i = 0; i < num_tasks; i++)
+        {
+            /* serially, each task sees the lambdas found before it */
+            if (num_threads <= 1 || num_tasks <= 1)
+                _aprcl_is_prime_jacobi_worker(i, &args);
 
-                /*
-                    check (Lp);
-                    if h % 2 != 0 (primitive unity root)
-                    and q^{(n - 1) / 2} = -1 mod n then lambdas_2 = 1
-                */
-                if (h % 2 != 0 && lambdas[pind] == 0 && fmpz_equal(q_pow, ndec))
-                    lambdas[pind] = 1;
-            }
+            if (tasks[i].lambda)
+                lambdas[tasks[i].pind] = 1;
 
-            if (p != 2)
+            if (tasks[i].composite)
             {
-                h = _aprcl_is_prime_jacobi_check_pk(jacobi_sum, u, v);
-
-                /* if h not found then n is composite */
-                if (h < 0)
-                    result = COMPOSITE;
-
-                /*
-                    check (Lp);
-                    if h % p != 0 (primitive unity root)
-                    then lambdas_p = 1
-                */
-                if (h % p != 0 && lambdas[pind] == 0)
-                    lambdas[pind] = 1;
+                result = COMPOSITE;
+                break;
             }
-
-            /* clear unity_zp for jacobi sums */
-            unity_zp_clear(jacobi_sum);
-            unity_zp_clear(jacobi_sum2_1);
-            unity_zp_clear(jacobi_sum2_2);
         }
-
     }
 
+    flint_free(tasks);
+
     /* Begin L_p tests */
 
     /* if n can be prime */
     if (result == PROBABPRIME)
     {
+        int * additional;
+        _aprcl_additional_args_struct add_args;
+
+        additional = (int *) flint_malloc(sizeof(int) * config->rs.num);
+
+        add_args.n = n;
+        add_args.p = config->rs.p;
+        add_args.lambdas = lambdas;
+        add_args.res = additional;
+
+        /* the additional tests for different p are independent */
+        flint_parallel_do(_aprcl_is_prime_jacobi_additional_worker, &add_args,
+                                config->rs.num, -1, FLINT_PARALLEL_STRIDED);
+
         /* for every lambdas_p */
         for (i = 0; i < config->rs.num; i++)
         {
             /* if lambdas_p == 0 need run additional test for p */
             if (lambdas[i] == 0)
             {
-                int r = _aprcl_is_prime_jacobi_additional_test(n, config->rs.p[i]);
+                int r = additional[i];
 
                 /* if r == 2 then we prove that n is composite */
                 if (r == 2)
@@ -779,6 +895,8 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
                 }
             }
         }
+
+        flint_free(additional);
     }
 
     /* Trial division and primality proving step */
@@ -801,8 +919,6 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
 
     /* clear */
     flint_free(lambdas);
-    fmpz_clear(u);
-    fmpz_clear(q_pow);
     fmpz_clear(p2);
     fmpz_clear(ndec);
     fmpz_clear(ndecdiv);
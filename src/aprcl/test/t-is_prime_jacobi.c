@@ -147,6 +147,35 @@ int main(void)
         fmpz_clear(u);
     }
 
+    /* Test aprcl_is_prime_jacobi on primes, with threads. */
+    {
+        for (i = 0; i < 10 * flint_test_multiplier(); i++)
+        {
+            fmpz_t n;
+            fmpz_init(n);
+
+            flint_set_num_threads(1 + n_randint(state, 4));
+
+            fmpz_randbits(n, state, 100 + n_randint(state, 200));
+            fmpz_abs(n, n);
+            fmpz_nextprime(n, n, 0);
+
+            if (aprcl_is_prime_jacobi(n) != 1)
+            {
+                flint_printf("FAIL\n");
+                flint_printf("Testing number = ");
+                fmpz_print(n);
+                flint_printf("\naprcl_is_prime_jacobi did not prove primality\n");
+                fflush(stdout);
+                flint_abort();
+            }
+
+            fmpz_clear(n);
+        }
+
+        flint_set_num_threads(1);
+    }
+
     /* Test aprcl_is_prime_jacobi. */
     {
         for (i = 0; i < 200 * flint_test_multiplier(); i++)
@@ -155,6 +184,8 @@ int main(void)
             fmpz_t n;
             fmpz_init(n);
 
+            flint_set_num_threads(1 + n_randint(state, 4));
+
             fmpz_randtest_unsigned(n, state, 1000);
             while (fmpz_cmp_ui(n, 100) <= 0)
                 fmpz_randtest_unsigned(n, state, 1000);
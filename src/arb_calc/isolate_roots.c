@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "arb_calc.h"
 
 #define BLOCK_NO_ZERO 0
@@ -182,3 +183,237 @@ arb_calc_isolate_roots(arf_interval_ptr * blocks, int ** flags,
     return length;
 }
 
+
+/* Breadth-first version: the pending blocks at each depth are tested
+   concurrently and the merge is done serially in increasing order. */
+
+typedef struct
+{
+    arf_interval_struct block;
+    arf_interval_struct L;
+    arf_interval_struct R;
+    int asign;
+    int bsign;
+    int msign;
+    int status;
+    int done;
+}
+_isolate_item_struct;
+
+typedef struct
+{
+    _isolate_item_struct * items;
+    const slong * idx;
+    slong num;
+    slong num_chunks;
+    slong depth;
+    arb_calc_func_t func;
+    void ** params;
+    slong prec;
+}
+_isolate_arg_t;
+
+/* chunk k uses params[k], so that no two threads share a context */
+static void
+_isolate_worker(slong k, void * arg_ptr)
+{
+    _isolate_arg_t * arg = (_isolate_arg_t *) arg_ptr;
+    _isolate_item_struct * item;
+    slong i;
+
+    for (i = k; i < arg->num; i += arg->num_chunks)
+    {
+        item = arg->items + arg->idx[i];
+
+        item->status = check_block(arg->func, arg->params[k], &item->block,
+            item->asign, item->bsign, arg->prec);
+
+        if (item->status == BLOCK_UNKNOWN && arg->depth > 0)
+            item->msign = arb_calc_partition(&item->L, &item->R, arg->func,
+                arg->params[k], &item->block, arg->prec);
+    }
+}
+
+static void
+_isolate_item_init(_isolate_item_struct * item, const arf_interval_t block,
+    int asign, int bsign)
+{
+    arf_interval_init(&item->block);
+    arf_interval_init(&item->L);
+    arf_interval_init(&item->R);
+    arf_interval_set(&item->block, block);
+    item->asign = asign;
+    item->bsign = bsign;
+    item->status = BLOCK_UNKNOWN;
+    item->done = 0;
+}
+
+static void
+_isolate_item_clear(_isolate_item_struct * item)
+{
+    arf_interval_clear(&item->block);
+    arf_interval_clear(&item->L);
+    arf_interval_clear(&item->R);
+}
+
+slong
+arb_calc_isolate_roots_threaded(arf_interval_ptr * blocks, int ** flags,
+    arb_calc_func_t func, void ** params, slong num_params,
+    const arf_interval_t block, slong maxdepth, slong maxeval, slong maxfound,
+    slong prec)
+{
+    _isolate_item_struct * cur, * next, * item;
+    slong i, num, next_num, num_eval, num_pending, depth;
+    slong * idx;
+    _isolate_arg_t arg;
+    int asign, bsign;
+    arb_t m, v;
+
+    if (num_params < 1)
+        flint_throw(FLINT_ERROR, "arb_calc_isolate_roots_threaded: num_params must be positive\n");
+
+    arb_init(m);
+    arb_init(v);
+
+    arb_set_arf(m, &block->a);
+    func(v, m, params[0], 1, prec);
+    asign = arb_sgn_nonzero(v);
+
+    arb_set_arf(m, &block->b);
+    func(v, m, params[0], 1, prec);
+    bsign = arb_sgn_nonzero(v);
+
+    arb_clear(m);
+    arb_clear(v);
+
+    cur = flint_malloc(sizeof(_isolate_item_struct));
+    _isolate_item_init(cur, block, asign, bsign);
+    num = 1;
+    num_pending = 1;
+
+    for (depth = maxdepth; num_pending != 0; depth--)
+    {
+        /* the evaluation budget goes to the leftmost pending blocks;
+           the remaining pending blocks are output untested */
+        idx = flint_malloc(sizeof(slong) * num_pending);
+        num_eval = 0;
+
+        for (i = 0; i < num; i++)
+        {
+            if (!cur[i].done)
+            {
+                if (maxfound > 0 && num_eval < maxeval)
+                    idx[num_eval++] = i;
+                else
+                    cur[i].done = 1;
+            }
+        }
+
+        if (num_eval != 0)
+        {
+            arg.items = cur;
+            arg.idx = idx;
+            arg.num = num_eval;
+            arg.num_chunks = FLINT_MIN(num_params, num_eval);
+            arg.depth = depth;
+            arg.func = func;
+            arg.params = params;
+            arg.prec = prec;
+
+            flint_parallel_do(_isolate_worker, &arg, arg.num_chunks, -1,
+                FLINT_PARALLEL_STRIDED);
+
+            maxeval -= num_eval;
+        }
+
+        flint_free(idx);
+
+        /* merge in order, replacing bisected blocks by their halves */
+        next = flint_malloc(sizeof(_isolate_item_struct) * 2 * num);
+        next_num = 0;
+        num_pending = 0;
+
+        for (i = 0; i < num; i++)
+        {
+            item = cur + i;
+
+            if (item->done)
+            {
+                next[next_num++] = *item;
+            }
+            else if (item->status == BLOCK_NO_ZERO)
+            {
+                _isolate_item_clear(item);
+            }
+            else if (item->status == BLOCK_ISOLATED_ZERO || depth <= 0
+                || maxfound <= 0)
+            {
+                if (item->status == BLOCK_ISOLATED_ZERO)
+                {
+                    if (maxfound > 0)
+                    {
+                        if (arb_calc_verbose)
+                        {
+                            flint_printf("found isolated root in: ");
+                            arf_interval_printd(&item->block, 15);
+                            flint_printf("\n");
+                        }
+
+                        maxfound--;
+                    }
+                    else
+                    {
+                        /* the serial algorithm would not have tested it */
+                        item->status = BLOCK_UNKNOWN;
+                    }
+                }
+
+                item->done = 1;
+                next[next_num++] = *item;
+            }
+            else
+            {
+                if (item->msign == 0 && arb_calc_verbose)
+                {
+                    flint_printf("possible zero at midpoint: ");
+                    arf_interval_printd(&item->block, 15);
+                    flint_printf("\n");
+                }
+
+                _isolate_item_init(next + next_num, &item->L, item->asign, item->msign);
+                _isolate_item_init(next + next_num + 1, &item->R, item->msign, item->bsign);
+                next_num += 2;
+                num_pending += 2;
+
+                _isolate_item_clear(item);
+            }
+        }
+
+        flint_free(cur);
+        cur = next;
+        num = next_num;
+    }
+
+    if (num == 0)
+    {
+        *blocks = NULL;
+        *flags = NULL;
+    }
+    else
+    {
+        *blocks = flint_malloc(sizeof(arf_interval_struct) * num);
+        *flags = flint_malloc(sizeof(int) * num);
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        (*blocks)[i] = cur[i].block;
+        (*flags)[i] = cur[i].status;
+        arf_interval_clear(&cur[i].L);
+        arf_interval_clear(&cur[i].R);
+    }
+
+    flint_free(cur);
+
+    return num;
+}
@@ -0,0 +1,221 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "arb_poly.h"
+#include "arb_calc.h"
+
+/* per-thread evaluation context */
+typedef struct
+{
+    slong count;
+    arb_ptr x;
+}
+eval_ctx_struct;
+
+/* sin((pi/2)x), using the scratch space of the context */
+static int
+sin_pi2_x(arb_ptr out, const arb_t inp, void * params, slong order, slong prec)
+{
+    eval_ctx_struct * ctx = (eval_ctx_struct *) params;
+    arb_ptr x = ctx->x;
+
+    ctx->count++;
+
+    arb_set(x, inp);
+    arb_one(x + 1);
+
+    arb_const_pi(out, prec);
+    arb_mul_2exp_si(out, out, -1);
+    _arb_vec_scalar_mul(x, x, 2, out, prec);
+    _arb_poly_sin_series(out, x, order, order, prec);
+
+    return 0;
+}
+
+static int
+check_equal(arf_interval_srcptr blocks1, const int * info1, slong num1,
+    arf_interval_srcptr blocks2, const int * info2, slong num2)
+{
+    slong i;
+
+    if (num1 != num2)
+        return 0;
+
+    for (i = 0; i < num1; i++)
+    {
+        if (!arf_equal(&blocks1[i].a, &blocks2[i].a) ||
+            !arf_equal(&blocks1[i].b, &blocks2[i].b) ||
+            info1[i] != info2[i])
+            return 0;
+    }
+
+    return 1;
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("isolate_roots_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 40 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        slong m, r, a, b, maxdepth, maxeval, maxfound, prec, i, j, k;
+        slong num, num1, num2, num_params;
+        arf_interval_ptr blocks, blocks1, blocks2;
+        int * info, * info1, * info2;
+        eval_ctx_struct ctx[4];
+        void * params[4];
+        arf_interval_t interval;
+        arb_t t;
+        fmpz_t nn;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        prec = 2 + n_randint(state, 50);
+
+        m = n_randint(state, 80);
+        r = 1 + n_randint(state, 80);
+        a = m - r;
+        b = m + r;
+
+        maxdepth = 1 + n_randint(state, 60);
+        maxeval = 1 + n_randint(state, 5000);
+        maxfound = 1 + n_randint(state, 100);
+
+        num_params = 1 + n_randint(state, 4);
+
+        for (k = 0; k < 4; k++)
+        {
+            ctx[k].count = 0;
+            ctx[k].x = _arb_vec_init(2);
+            params[k] = ctx + k;
+        }
+
+        arf_interval_init(interval);
+        arb_init(t);
+        fmpz_init(nn);
+
+        arf_set_si(&interval->a, a);
+        arf_set_si(&interval->b, b);
+
+        num = arb_calc_isolate_roots_threaded(&blocks, &info, sin_pi2_x,
+            params, num_params, interval, maxdepth, maxeval, maxfound, prec);
+
+        /* check that all roots are accounted for */
+        for (i = a; i <= b; i++)
+        {
+            if (i % 2 == 0)
+            {
+                int found = 0;
+
+                for (j = 0; j < num; j++)
+                {
+                    arf_interval_get_arb(t, blocks + j, ARF_PREC_EXACT);
+
+                    if (arb_contains_si(t, i))
+                    {
+                        found = 1;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    flint_printf("FAIL: missing root %wd\n", i);
+                    flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                        a, b, maxdepth, maxeval, maxfound, prec);
+                    flint_abort();
+                }
+            }
+        }
+
+        /* check that all reported single roots are good, and the order */
+        for (i = 0; i < num; i++)
+        {
+            if (info[i] == 1)
+            {
+                arf_interval_get_arb(t, blocks + i, ARF_PREC_EXACT);
+                arb_mul_2exp_si(t, t, -1);
+
+                if (!arb_get_unique_fmpz(nn, t))
+                {
+                    flint_printf("FAIL: bad root %wd\n", i);
+                    flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                        a, b, maxdepth, maxeval, maxfound, prec);
+                    flint_abort();
+                }
+            }
+
+            if (i > 0 && arf_cmp(&blocks[i - 1].b, &blocks[i].a) > 0)
+            {
+                flint_printf("FAIL: order\n");
+                flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                    a, b, maxdepth, maxeval, maxfound, prec);
+                flint_abort();
+            }
+        }
+
+        /* the output does not depend on the number of contexts */
+        num1 = arb_calc_isolate_roots_threaded(&blocks1, &info1, sin_pi2_x,
+            params, 1, interval, maxdepth, maxeval, maxfound, prec);
+
+        if (!check_equal(blocks, info, num, blocks1, info1, num1))
+        {
+            flint_printf("FAIL: num_params\n");
+            flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd, num_params = %wd\n",
+                a, b, maxdepth, maxeval, maxfound, prec, num_params);
+            flint_abort();
+        }
+
+        _arf_interval_vec_clear(blocks, num);
+        _arf_interval_vec_clear(blocks1, num1);
+        flint_free(info);
+        flint_free(info1);
+
+        /* without limits, the output agrees with the serial algorithm;
+           the depth is kept small since the number of blocks can grow
+           exponentially at low precision */
+        maxdepth = FLINT_MIN(maxdepth, 10);
+        num1 = arb_calc_isolate_roots_threaded(&blocks1, &info1, sin_pi2_x,
+            params, num_params, interval, maxdepth, WORD_MAX, WORD_MAX, prec);
+        num2 = arb_calc_isolate_roots(&blocks2, &info2, sin_pi2_x,
+            params[0], interval, maxdepth, WORD_MAX, WORD_MAX, prec);
+
+        if (!check_equal(blocks1, info1, num1, blocks2, info2, num2))
+        {
+            flint_printf("FAIL: serial\n");
+            flint_printf("a = %wd, b = %wd, maxdepth = %wd, prec = %wd, num_params = %wd\n",
+                a, b, maxdepth, prec, num_params);
+            flint_abort();
+        }
+
+        _arf_interval_vec_clear(blocks1, num1);
+        _arf_interval_vec_clear(blocks2, num2);
+        flint_free(info1);
+        flint_free(info2);
+
+        for (k = 0; k < 4; k++)
+            _arb_vec_clear(ctx[k].x, 2);
+
+        arf_interval_clear(interval);
+        arb_clear(t);
+        fmpz_clear(nn);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
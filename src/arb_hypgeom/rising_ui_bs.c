@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "arb_hypgeom.h"
 
 static void
@@ -44,6 +45,38 @@ bsplit(arb_t y, const arb_t x, ulong a, ulong b, slong prec)
     }
 }
 
+typedef struct
+{
+    arb_srcptr x;
+    slong prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(arb_ptr y, void * args)
+{
+    arb_init(y);
+}
+
+static void
+bsplit_clear(arb_ptr y, void * args)
+{
+    arb_clear(y);
+}
+
+static void
+bsplit_basecase(arb_ptr y, slong a, slong b, bsplit_args_t * args)
+{
+    bsplit(y, args->x, a, b, args->prec);
+}
+
+/* res = left */
+static void
+bsplit_merge(arb_ptr res, arb_ptr left, arb_ptr right, bsplit_args_t * args)
+{
+    arb_mul(res, left, right, args->prec);
+}
+
 void
 arb_hypgeom_rising_ui_bs(arb_t res, const arb_t x, ulong n, slong prec)
 {
@@ -58,10 +91,20 @@ arb_hypgeom_rising_ui_bs(arb_t res, const arb_t x, ulong n, slong prec)
 
     {
         arb_t t;
+        bsplit_args_t args;
         slong wp = ARF_PREC_ADD(prec, FLINT_BIT_COUNT(n));
 
+        args.x = x;
+        args.prec = wp;
+
         arb_init(t);
-        bsplit(t, x, 0, n, wp);
+        flint_parallel_binary_splitting(t,
+            (bsplit_basecase_func_t) bsplit_basecase,
+            (bsplit_merge_func_t) bsplit_merge,
+            sizeof(arb_struct),
+            (bsplit_init_func_t) bsplit_init,
+            (bsplit_clear_func_t) bsplit_clear,
+            &args, 0, n, 16, -1, FLINT_PARALLEL_BSPLIT_LEFT_INPLACE);
         arb_set_round(res, t, prec);
         arb_clear(t);
     }
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "arb_hypgeom.h"
 
 static void
@@ -55,6 +56,35 @@ factor(arb_t A, const fmpq * a, slong alen, const fmpq * b, slong blen, const fm
     fmpz_clear(u);
 }
 
+/* combines the results for [aa, m) and [m, bb), overwriting B2;
+   B1 and B2 are not set for ranges of length 1 */
+static void
+merge(arb_t A1, arb_t B1, arb_t C1, arb_t A2, arb_t B2, const arb_t C2,
+        slong len1, slong len2, slong prec)
+{
+    if (len2 == 1)  /* B2 = C2 */
+    {
+        if (len1 == 1)
+            arb_add(B2, A1, C1, prec);
+        else
+            arb_add(B2, A1, B1, prec);
+
+        arb_mul(B1, B2, C2, prec);
+    }
+    else
+    {
+        if (len1 == 1)
+            arb_mul(B1, C1, C2, prec);
+        else
+            arb_mul(B1, B1, C2, prec);
+
+        arb_addmul(B1, A1, B2, prec);
+    }
+
+    arb_mul(A1, A1, A2, prec);
+    arb_mul(C1, C1, C2, prec);
+}
+
 static void
 bsplit(arb_t A1, arb_t B1, arb_t C1,
         const fmpq * a, slong alen, const fmpz_t aden,
@@ -85,27 +115,7 @@ bsplit(arb_t A1, arb_t B1, arb_t C1,
         bsplit(A1, B1, C1, a, alen, aden, b, blen, bden, z, reciprocal, aa, m, prec);
         bsplit(A2, B2, C2, a, alen, aden, b, blen, bden, z, reciprocal, m, bb, prec);
 
-        if (bb - m == 1)  /* B2 = C2 */
-        {
-            if (m - aa == 1)
-                arb_add(B2, A1, C1, prec);
-            else
-                arb_add(B2, A1, B1, prec);
-
-            arb_mul(B1, B2, C2, prec);
-        }
-        else
-        {
-            if (m - aa == 1)
-                arb_mul(B1, C1, C2, prec);
-            else
-                arb_mul(B1, B1, C2, prec);
-
-            arb_addmul(B1, A1, B2, prec);
-        }
-
-        arb_mul(A1, A1, A2, prec);
-        arb_mul(C1, C1, C2, prec);
+        merge(A1, B1, C1, A2, B2, C2, m - aa, bb - m, prec);
 
         arb_clear(A2);
         arb_clear(B2);
@@ -113,6 +123,110 @@ bsplit(arb_t A1, arb_t B1, arb_t C1,
     }
 }
 
+typedef struct
+{
+    arb_struct A;
+    arb_struct B;
+    arb_struct C;
+    slong a;
+    slong b;
+}
+bsplit_res_t;
+
+typedef struct
+{
+    const fmpq * a;
+    slong alen;
+    const fmpz * aden;
+    const fmpq * b;
+    slong blen;
+    const fmpz * bden;
+    arb_srcptr z;
+    int reciprocal;
+    slong prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(bsplit_res_t * x, void * args)
+{
+    arb_init(&x->A);
+    arb_init(&x->B);
+    arb_init(&x->C);
+}
+
+static void
+bsplit_clear(bsplit_res_t * x, void * args)
+{
+    arb_clear(&x->A);
+    arb_clear(&x->B);
+    arb_clear(&x->C);
+}
+
+static void
+bsplit_basecase(bsplit_res_t * res, slong aa, slong bb, bsplit_args_t * args)
+{
+    bsplit(&res->A, &res->B, &res->C, args->a, args->alen, args->aden,
+        args->b, args->blen, args->bden, args->z, args->reciprocal,
+        aa, bb, args->prec);
+
+    res->a = aa;
+    res->b = bb;
+}
+
+/* res = left */
+static void
+bsplit_merge(bsplit_res_t * res, bsplit_res_t * left, bsplit_res_t * right, bsplit_args_t * args)
+{
+    if (res != left)
+        flint_abort();
+
+    merge(&res->A, &res->B, &res->C, &right->A, &right->B, &right->C,
+        left->b - left->a, right->b - right->a, args->prec);
+
+    res->b = right->b;
+}
+
+/* same as bsplit, with subtrees evaluated in parallel */
+static void
+bsplit_threaded(arb_t A1, arb_t B1, arb_t C1,
+        const fmpq * a, slong alen, const fmpz_t aden,
+        const fmpq * b, slong blen, const fmpz_t bden,
+        const arb_t z, int reciprocal,
+        slong aa,
+        slong bb,
+        slong prec)
+{
+    bsplit_res_t res;
+    bsplit_args_t args;
+
+    res.A = *A1;
+    res.B = *B1;
+    res.C = *C1;
+
+    args.a = a;
+    args.alen = alen;
+    args.aden = aden;
+    args.b = b;
+    args.blen = blen;
+    args.bden = bden;
+    args.z = z;
+    args.reciprocal = reciprocal;
+    args.prec = prec;
+
+    flint_parallel_binary_splitting(&res,
+        (bsplit_basecase_func_t) bsplit_basecase,
+        (bsplit_merge_func_t) bsplit_merge,
+        sizeof(bsplit_res_t),
+        (bsplit_init_func_t) bsplit_init,
+        (bsplit_clear_func_t) bsplit_clear,
+        &args, aa, bb, 8, -1, FLINT_PARALLEL_BSPLIT_LEFT_INPLACE);
+
+    *A1 = res.A;
+    *B1 = res.B;
+    *C1 = res.C;
+}
+
 void
 arb_hypgeom_sum_fmpq_arb_bs(arb_t res, const fmpq * a, slong alen, const fmpq * b, slong blen, const arb_t z, int reciprocal, slong N, slong prec)
 {
@@ -144,7 +258,7 @@ arb_hypgeom_sum_fmpq_arb_bs(arb_t res, const fmpq * a, slong alen, const fmpq *
     /* we compute to N-1 instead of N to avoid dividing by 0 in the
        denominator when computing a hypergeometric polynomial
        that terminates right before a pole */
-    bsplit(u, v, w, a, alen, aden, b, blen, bden, z, reciprocal, 0, N - 1, prec);
+    bsplit_threaded(u, v, w, a, alen, aden, b, blen, bden, z, reciprocal, 0, N - 1, prec);
 
     arb_add(res, u, v, prec); /* s = s + t */
     arb_div(res, res, w, prec);
@@ -34,6 +34,8 @@ int main(void)
         blen = n_randint(state, 5);
         N = n_randint(state, 100);
 
+        flint_set_num_threads(1 + n_randint(state, 3));
+
         arb_init(s1);
         arb_init(s2);
         arb_init(s3);
@@ -80,7 +82,7 @@ int main(void)
     }
 
     flint_randclear(state);
-    flint_cleanup();
+    flint_cleanup_master();
     flint_printf("PASS\n");
     return 0;
 }
@@ -19,6 +19,7 @@
 #endif
 
 #include "fmpq_types.h"
+#include "d_mat.h"
 #include "arb.h"
 
 #ifdef __cplusplus
@@ -79,6 +80,15 @@ void arb_mat_set_round_fmpz_mat(arb_mat_t dest, const fmpz_mat_t src, slong prec
 
 void arb_mat_set_fmpq_mat(arb_mat_t dest, const fmpq_mat_t src, slong prec);
 
+/* midpoints of larger magnitude are not converted to doubles, leaving
+   enough headroom that products and sums of n converted entries and
+   entries of an approximate inverse cannot overflow */
+#define ARB_MAT_D_MAX_EXP 400
+
+int _arb_mat_get_d_mat_mid(d_mat_t dest, const arb_mat_t src);
+
+int _arb_mat_set_round_d_mat(arb_mat_t dest, const d_mat_t src, slong prec);
+
 /* Random generation */
 
 void arb_mat_randtest(arb_mat_t mat, flint_rand_t state, slong prec, slong mag_bits);
@@ -356,6 +366,8 @@ int arb_mat_solve_lu(arb_mat_t X, const arb_mat_t A, const arb_mat_t B, slong pr
 
 int arb_mat_solve_precond(arb_mat_t X, const arb_mat_t A, const arb_mat_t B, slong prec);
 
+int arb_mat_solve_double(arb_mat_t X, const arb_mat_t A, const arb_mat_t B, slong prec);
+
 int arb_mat_solve_preapprox(arb_mat_t X, const arb_mat_t A,
     const arb_mat_t B, const arb_mat_t R, const arb_mat_t T, slong prec);
 
@@ -183,9 +183,29 @@ arb_mat_approx_lu_recursive(slong * P, arb_mat_t LU, const arb_mat_t A, slong pr
     return r1 && r2;
 }
 
+/* Returns 0 if the midpoints do not fit in doubles or if the
+   hardware floating-point elimination breaks down. */
+static int
+_arb_mat_approx_lu_d(slong * P, arb_mat_t LU, const arb_mat_t A, slong prec)
+{
+    d_mat_t D;
+    int result;
+
+    d_mat_init(D, arb_mat_nrows(A), arb_mat_ncols(A));
+
+    result = _arb_mat_get_d_mat_mid(D, A) && d_mat_lu(P, D, D)
+        && _arb_mat_set_round_d_mat(LU, D, prec);
+
+    d_mat_clear(D);
+    return result;
+}
+
 int
 arb_mat_approx_lu(slong * P, arb_mat_t LU, const arb_mat_t A, slong prec)
 {
+    if (prec <= 53 && !arb_mat_is_empty(A) && _arb_mat_approx_lu_d(P, LU, A, prec))
+        return 1;
+
     if (arb_mat_nrows(A) < 8 || arb_mat_ncols(A) < 8)
         return arb_mat_approx_lu_classical(P, LU, A, prec);
     else
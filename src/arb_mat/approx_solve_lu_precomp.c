@@ -12,6 +12,29 @@
 
 #include "arb_mat.h"
 
+static int
+_arb_mat_approx_solve_lu_precomp_d(arb_mat_t X, const slong * perm,
+    const arb_mat_t A, const arb_mat_t B, slong prec)
+{
+    d_mat_t LU, T;
+    int result;
+
+    d_mat_init(LU, arb_mat_nrows(A), arb_mat_ncols(A));
+    d_mat_init(T, arb_mat_nrows(B), arb_mat_ncols(B));
+
+    result = _arb_mat_get_d_mat_mid(LU, A) && _arb_mat_get_d_mat_mid(T, B);
+
+    if (result)
+    {
+        d_mat_solve_lu_precomp(T, perm, LU, T);
+        result = _arb_mat_set_round_d_mat(X, T, prec);
+    }
+
+    d_mat_clear(LU);
+    d_mat_clear(T);
+    return result;
+}
+
 void
 arb_mat_approx_solve_lu_precomp(arb_mat_t X, const slong * perm,
     const arb_mat_t A, const arb_mat_t B, slong prec)
@@ -21,6 +44,10 @@ arb_mat_approx_solve_lu_precomp(arb_mat_t X, const slong * perm,
     n = arb_mat_nrows(X);
     m = arb_mat_ncols(X);
 
+    if (prec <= 53 && n != 0 && m != 0 &&
+        _arb_mat_approx_solve_lu_precomp_d(X, perm, A, B, prec))
+        return;
+
     if (X == B)
     {
         arb_ptr tmp = flint_malloc(sizeof(arb_struct) * n);
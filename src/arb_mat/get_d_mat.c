@@ -0,0 +1,58 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include "double_extras.h"
+#include "arb_mat.h"
+
+int
+_arb_mat_get_d_mat_mid(d_mat_t dest, const arb_mat_t src)
+{
+    slong i, j;
+
+    for (i = 0; i < arb_mat_nrows(src); i++)
+    {
+        for (j = 0; j < arb_mat_ncols(src); j++)
+        {
+            arf_srcptr x = arb_midref(arb_mat_entry(src, i, j));
+
+            if (!arf_is_finite(x) || arf_cmpabs_2exp_si(x, ARB_MAT_D_MAX_EXP) > 0)
+                return 0;
+
+            d_mat_entry(dest, i, j) = arf_get_d(x, ARF_RND_NEAR);
+        }
+    }
+
+    return 1;
+}
+
+int
+_arb_mat_set_round_d_mat(arb_mat_t dest, const d_mat_t src, slong prec)
+{
+    slong i, j;
+
+    for (i = 0; i < d_mat_nrows(src); i++)
+        for (j = 0; j < d_mat_ncols(src); j++)
+            if (!(fabs(d_mat_entry(src, i, j)) < D_INF))
+                return 0;
+
+    for (i = 0; i < d_mat_nrows(src); i++)
+    {
+        for (j = 0; j < d_mat_ncols(src); j++)
+        {
+            arb_ptr x = arb_mat_entry(dest, i, j);
+
+            arf_set_d(arb_midref(x), d_mat_entry(src, i, j));
+            arf_set_round(arb_midref(x), arb_midref(x), prec, ARF_RND_DOWN);
+            mag_zero(arb_radref(x));
+        }
+    }
+
+    return 1;
+}
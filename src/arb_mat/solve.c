@@ -16,6 +16,9 @@ arb_mat_solve(arb_mat_t X, const arb_mat_t A, const arb_mat_t B, slong prec)
 {
     slong n = arb_mat_nrows(A);
 
+    if (n > 4 && prec <= 128 && arb_mat_solve_double(X, A, B, prec))
+        return 1;
+
     if (n <= 4 || prec > 10.0 * n)
         return arb_mat_solve_lu(X, A, B, prec);
     else
@@ -0,0 +1,278 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include "double_extras.h"
+#include "perm.h"
+#include "arb_mat.h"
+
+/*
+    Returns an upper bound for ||I - R A||_inf valid for every A with
+    |A - A0| <= E entrywise, where R, A0 and E are hardware double
+    matrices with entries bounded by 2^ARB_MAT_D_MAX_EXP (E may
+    also contain larger or infinite entries, giving an infinite or NaN
+    result). With u = 2^-53, the computed product P = fl(R A0) satisfies
+    |P - R A0| <= gamma_n |R| |A0| where gamma_n <= 2 (n+1) u, so that
+    |I - R A| <= |I - P| + |R| (E + 2 (n+1) u |A0|) entrywise. All
+    quantities in the final expression are nonnegative and are evaluated
+    with fewer than 3n + 8 roundings each, which is absorbed into the
+    factor 1 + 8 (n+2) u. The last term covers underflow, which causes
+    an absolute error of at most 2^-1075 per product.
+*/
+static double
+_d_mat_precond_bound(const d_mat_t R, const d_mat_t A0, const d_mat_t E)
+{
+    slong i, j, n;
+    double u, g, s, d;
+    d_mat_t P, Ra, Ea;
+
+    n = d_mat_nrows(R);
+    u = ldexp(1.0, -53);
+    g = 2.0 * (n + 1) * u;
+
+    d_mat_init(P, n, n);
+    d_mat_init(Ra, n, n);
+    d_mat_init(Ea, n, n);
+
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n; j++)
+        {
+            d_mat_entry(Ra, i, j) = fabs(d_mat_entry(R, i, j));
+            d_mat_entry(Ea, i, j) = d_mat_entry(E, i, j)
+                                    + g * fabs(d_mat_entry(A0, i, j));
+        }
+    }
+
+    d_mat_mul_classical(P, R, A0);
+    d_mat_mul_classical(Ea, Ra, Ea);
+
+    d = 0.0;
+    for (i = 0; i < n; i++)
+    {
+        s = 0.0;
+        for (j = 0; j < n; j++)
+            s += fabs((i == j) - d_mat_entry(P, i, j)) + d_mat_entry(Ea, i, j);
+
+        /* also propagates NaN */
+        if (!(s <= d))
+            d = s;
+    }
+
+    d = d * (1.0 + 8.0 * (n + 2) * u) + (double) n * n * ldexp(1.0, -1000);
+
+    d_mat_clear(P);
+    d_mat_clear(Ra);
+    d_mat_clear(Ea);
+
+    return d;
+}
+
+/* Sets E to upper bounds for |A - A0| where A0 = fl(mid(A)). */
+static void
+_arb_mat_get_d_mat_err(d_mat_t E, const arb_mat_t A, const d_mat_t A0)
+{
+    slong i, j;
+    arf_t t;
+    mag_t e;
+
+    arf_init(t);
+    mag_init(e);
+
+    for (i = 0; i < arb_mat_nrows(A); i++)
+    {
+        for (j = 0; j < arb_mat_ncols(A); j++)
+        {
+            arb_srcptr x = arb_mat_entry(A, i, j);
+
+            arf_set_d(t, d_mat_entry(A0, i, j));
+            arf_sub(t, arb_midref(x), t, MAG_BITS, ARF_RND_UP);
+            arf_get_mag(e, t);
+            mag_add(e, e, arb_radref(x));
+            d_mat_entry(E, i, j) = mag_get_d(e);
+        }
+    }
+
+    arf_clear(t);
+    mag_clear(e);
+}
+
+int
+arb_mat_solve_double(arb_mat_t X, const arb_mat_t A, const arb_mat_t B, slong prec)
+{
+    slong i, j, k, n, m, wp, maxiter, *perm;
+    d_mat_t A0, LU, R, T;
+    arb_mat_t Rb, Y, C;
+    mag_t d, e, err, maxerr, prev;
+    int result;
+
+    n = arb_mat_nrows(A);
+    m = arb_mat_ncols(X);
+
+    if (n == 0 || m == 0)
+        return 1;
+
+    d_mat_init(A0, n, n);
+    d_mat_init(LU, n, n);
+    d_mat_init(R, n, n);
+    d_mat_init(T, n, m);
+    perm = _perm_init(n);
+    mag_init(d);
+
+    result = _arb_mat_get_d_mat_mid(A0, A) && _arb_mat_get_d_mat_mid(T, B)
+        && d_mat_lu(perm, LU, A0);
+
+    if (result)
+    {
+        /* approximate inverse and approximate solution */
+        d_mat_one(R);
+        d_mat_solve_lu_precomp(R, perm, LU, R);
+        d_mat_solve_lu_precomp(T, perm, LU, T);
+
+        for (i = 0; i < n && result; i++)
+            for (j = 0; j < n && result; j++)
+                result = fabs(d_mat_entry(R, i, j)) <= ldexp(1.0, ARB_MAT_D_MAX_EXP);
+
+        for (i = 0; i < n && result; i++)
+            for (j = 0; j < m && result; j++)
+                result = fabs(d_mat_entry(T, i, j)) < D_INF;
+    }
+
+    if (result)
+    {
+        double b;
+
+        /* d = lower bound for 1 - ||I - R A||_inf */
+        _arb_mat_get_d_mat_err(LU, A, A0);
+        b = _d_mat_precond_bound(R, A0, LU);
+
+        if (b < 1.0)
+        {
+            mag_init(e);
+            mag_set_d(e, b);
+            mag_one(d);
+            mag_sub_lower(d, d, e);
+            mag_clear(e);
+        }
+
+        result = !mag_is_zero(d);
+    }
+
+    if (result)
+    {
+        arb_mat_init(Rb, n, n);
+        arb_mat_init(Y, n, m);
+        arb_mat_init(C, n, m);
+        mag_init(e);
+        mag_init(err);
+        mag_init(maxerr);
+        mag_init(prev);
+        mag_inf(prev);
+
+        for (i = 0; i < n; i++)
+            for (j = 0; j < n; j++)
+                arb_set_d(arb_mat_entry(Rb, i, j), d_mat_entry(R, i, j));
+
+        for (i = 0; i < n; i++)
+            for (j = 0; j < m; j++)
+                arb_set_d(arb_mat_entry(Y, i, j), d_mat_entry(T, i, j));
+
+        /* Refine Y with residuals computed in ball arithmetic. By Theorem
+           10.2 of Rump in Acta Numerica 2010, every iteration also yields
+           a rigorous error bound max_i |R (A Y - B)|_ij / d for column j. */
+        wp = prec + 64;
+        maxiter = 2 + prec / 16;
+
+        for (k = 0; ; k++)
+        {
+            int done = 1;
+
+            arb_mat_mul(C, A, Y, wp);
+            arb_mat_sub(C, C, B, wp);
+            arb_mat_mul(C, Rb, C, wp);
+
+            mag_zero(maxerr);
+            for (j = 0; j < m; j++)
+            {
+                mag_zero(err);
+                mag_zero(e);
+                for (i = 0; i < n; i++)
+                {
+                    arb_get_mag(e, arb_mat_entry(C, i, j));
+                    mag_max(err, err, e);
+                }
+                mag_div(err, err, d);
+                mag_max(maxerr, maxerr, err);
+
+                /* converged if err <= 2^-prec max_i |Y_ij| */
+                if (done)
+                {
+                    mag_zero(e);
+                    for (i = 0; i < n; i++)
+                    {
+                        mag_t t;
+                        mag_init(t);
+                        arf_get_mag_lower(t, arb_midref(arb_mat_entry(Y, i, j)));
+                        mag_max(e, e, t);
+                        mag_clear(t);
+                    }
+                    mag_mul_2exp_si(e, e, -prec);
+                    done = mag_cmp(err, e) <= 0;
+                }
+            }
+
+            /* also stop when the error bounds no longer shrink,
+               e.g. because they are dominated by the radii of A or B */
+            mag_mul_2exp_si(prev, prev, -1);
+            if (done || k >= maxiter || mag_cmp(maxerr, prev) > 0)
+                break;
+            mag_set(prev, maxerr);
+
+            for (i = 0; i < n; i++)
+                for (j = 0; j < m; j++)
+                    arf_sub(arb_midref(arb_mat_entry(Y, i, j)),
+                        arb_midref(arb_mat_entry(Y, i, j)),
+                        arb_midref(arb_mat_entry(C, i, j)), wp, ARF_RND_DOWN);
+        }
+
+        for (j = 0; j < m; j++)
+        {
+            mag_zero(err);
+            for (i = 0; i < n; i++)
+            {
+                arb_get_mag(e, arb_mat_entry(C, i, j));
+                mag_max(err, err, e);
+            }
+            mag_div(err, err, d);
+
+            for (i = 0; i < n; i++)
+            {
+                arb_set_round(arb_mat_entry(X, i, j), arb_mat_entry(Y, i, j), prec);
+                arb_add_error_mag(arb_mat_entry(X, i, j), err);
+            }
+        }
+
+        arb_mat_clear(Rb);
+        arb_mat_clear(Y);
+        arb_mat_clear(C);
+        mag_clear(e);
+        mag_clear(err);
+        mag_clear(maxerr);
+        mag_clear(prev);
+    }
+
+    d_mat_clear(A0);
+    d_mat_clear(LU);
+    d_mat_clear(R);
+    d_mat_clear(T);
+    _perm_clear(perm);
+    mag_clear(d);
+
+    return result;
+}
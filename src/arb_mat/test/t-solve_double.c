@@ -0,0 +1,131 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mat.h"
+#include "fmpq_mat.h"
+#include "arb_mat.h"
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("solve_double....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        fmpq_mat_t Q, QX, QB;
+        arb_mat_t A, X, B;
+        slong i, n, m, qbits, prec;
+        int q_invertible, r_invertible, r_invertible2, dominant;
+
+        n = n_randint(state, 30);
+        m = n_randint(state, 8);
+        qbits = 1 + n_randint(state, 30);
+        prec = 2 + n_randint(state, 200);
+        dominant = n_randint(state, 2);
+
+        fmpq_mat_init(Q, n, n);
+        fmpq_mat_init(QX, n, m);
+        fmpq_mat_init(QB, n, m);
+
+        arb_mat_init(A, n, n);
+        arb_mat_init(X, n, m);
+        arb_mat_init(B, n, m);
+
+        if (dominant)
+        {
+            /* integer entries with a dominant diagonal */
+            fmpz_mat_t Z;
+            fmpz_mat_init(Z, n, n);
+            fmpz_mat_randbits(Z, state, qbits);
+
+            for (i = 0; i < n; i++)
+            {
+                if (n_randint(state, 2))
+                    fmpz_add_si(fmpz_mat_entry(Z, i, i), fmpz_mat_entry(Z, i, i), (n + 1) << qbits);
+                else
+                    fmpz_sub_si(fmpz_mat_entry(Z, i, i), fmpz_mat_entry(Z, i, i), (n + 1) << qbits);
+            }
+
+            fmpq_mat_set_fmpz_mat(Q, Z);
+            fmpz_mat_clear(Z);
+        }
+        else
+        {
+            fmpq_mat_randtest(Q, state, qbits);
+        }
+
+        fmpq_mat_randtest(QB, state, qbits);
+
+        q_invertible = fmpq_mat_solve_fraction_free(QX, Q, QB);
+
+        arb_mat_set_fmpq_mat(A, Q, prec);
+        arb_mat_set_fmpq_mat(B, QB, prec);
+
+        r_invertible = arb_mat_solve_double(X, A, B, prec);
+
+        if (r_invertible && !q_invertible)
+        {
+            flint_printf("FAIL: matrix is singular over Q but not over R\n");
+            flint_printf("n = %wd, prec = %wd\n", n, prec);
+            flint_printf("Q = \n"); fmpq_mat_print(Q); flint_printf("\n\n");
+            flint_printf("A = \n"); arb_mat_printd(A, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        if (!r_invertible && dominant && qbits < 20 && prec >= 20)
+        {
+            flint_printf("FAIL: diagonally dominant matrix not solved\n");
+            flint_printf("n = %wd, prec = %wd\n", n, prec);
+            flint_printf("A = \n"); arb_mat_printd(A, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        if (r_invertible)
+        {
+            if (!arb_mat_contains_fmpq_mat(X, QX))
+            {
+                flint_printf("FAIL (containment, iter = %wd)\n", iter);
+                flint_printf("n = %wd, prec = %wd\n", n, prec);
+                flint_printf("Q = \n"); fmpq_mat_print(Q); flint_printf("\n\n");
+                flint_printf("QB = \n"); fmpq_mat_print(QB); flint_printf("\n\n");
+                flint_printf("QX = \n"); fmpq_mat_print(QX); flint_printf("\n\n");
+                flint_printf("X = \n"); arb_mat_printd(X, 15); flint_printf("\n\n");
+                flint_abort();
+            }
+
+            /* test aliasing */
+            r_invertible2 = arb_mat_solve_double(B, A, B, prec);
+            if (!arb_mat_equal(X, B) || r_invertible != r_invertible2)
+            {
+                flint_printf("FAIL (aliasing)\n");
+                flint_printf("A = \n"); arb_mat_printd(A, 15); flint_printf("\n\n");
+                flint_printf("B = \n"); arb_mat_printd(B, 15); flint_printf("\n\n");
+                flint_printf("X = \n"); arb_mat_printd(X, 15); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        fmpq_mat_clear(Q);
+        fmpq_mat_clear(QB);
+        fmpq_mat_clear(QX);
+        arb_mat_clear(A);
+        arb_mat_clear(B);
+        arb_mat_clear(X);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return 0;
+}
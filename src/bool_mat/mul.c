@@ -10,6 +10,7 @@
 */
 
 #include "bool_mat.h"
+#include "gf2_mat.h"
 
 void
 bool_mat_mul(bool_mat_t C, const bool_mat_t A, const bool_mat_t B)
@@ -43,6 +44,23 @@ bool_mat_mul(bool_mat_t C, const bool_mat_t A, const bool_mat_t B)
         return;
     }
 
+    if (ar >= GF2_MAT_M4RM_CUTOFF && br >= GF2_MAT_M4RM_CUTOFF && bc >= GF2_MAT_M4RM_CUTOFF)
+    {
+        gf2_mat_t AA, BB, CC;
+
+        gf2_mat_init(AA, ar, br);
+        gf2_mat_init(BB, br, bc);
+        gf2_mat_init(CC, ar, bc);
+        gf2_mat_set_bool_mat(AA, A);
+        gf2_mat_set_bool_mat(BB, B);
+        gf2_mat_bool_mul(CC, AA, BB);
+        gf2_mat_get_bool_mat(C, CC);
+        gf2_mat_clear(AA);
+        gf2_mat_clear(BB);
+        gf2_mat_clear(CC);
+        return;
+    }
+
     for (i = 0; i < ar; i++)
     {
         for (j = 0; j < bc; j++)
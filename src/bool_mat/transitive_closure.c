@@ -10,6 +10,7 @@
 */
 
 #include "bool_mat.h"
+#include "gf2_mat.h"
 
 /* Warshall's algorithm */
 void
@@ -31,6 +32,18 @@ bool_mat_transitive_closure(bool_mat_t dest, const bool_mat_t src)
         flint_abort();
     }
 
+    if (dim >= GF2_MAT_M4RM_CUTOFF)
+    {
+        gf2_mat_t T;
+
+        gf2_mat_init(T, dim, dim);
+        gf2_mat_set_bool_mat(T, src);
+        gf2_mat_bool_transitive_closure(T, T);
+        gf2_mat_get_bool_mat(dest, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
     bool_mat_set(dest, src);
 
     for (k = 0; k < dim; k++)
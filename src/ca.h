@@ -25,6 +25,10 @@
 #include "fmpz_mpoly.h"
 #include "fexpr.h"
 
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -198,6 +202,29 @@ ca_field_cache_struct;
 
 typedef ca_field_cache_struct ca_field_cache_t[1];
 
+/* Results of ca_merge_fields, kept in a set-associative table with
+   least recently used replacement */
+
+typedef struct
+{
+    ca_field_struct * x;
+    ca_field_struct * y;
+    ca_field_struct * field;
+    slong * gen_map;             /* Images of the generators of x, then y */
+    ulong last_used;
+}
+ca_field_merge_struct;
+
+typedef struct
+{
+    ca_field_merge_struct * items;
+    slong num_sets;
+    ulong clock;
+}
+ca_field_merge_cache_struct;
+
+typedef ca_field_merge_cache_struct ca_field_merge_cache_t[1];
+
 /* Context object ************************************************************/
 
 enum
@@ -229,11 +256,15 @@ typedef struct
 {
     ca_ext_cache_struct ext_cache;              /* Cached extension objects */
     ca_field_cache_struct field_cache;          /* Cached extension fields  */
+    ca_field_merge_cache_struct merge_cache;    /* Cached field merges      */
     ca_field_struct * field_qq;                 /* Quick access to QQ      */
     ca_field_struct * field_qq_i;               /* Quick access to QQ(i)   */
     fmpz_mpoly_ctx_struct ** mctx;              /* Cached contexts for multivariate polys */
     slong mctx_len;
     slong * options;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t lock;                       /* Guards the caches        */
+#endif
 }
 ca_ctx_struct;
 
@@ -241,6 +272,7 @@ typedef ca_ctx_struct ca_ctx_t[1];
 
 #define CA_CTX_EXT_CACHE(ctx) (&((ctx)->ext_cache))
 #define CA_CTX_FIELD_CACHE(ctx) (&((ctx)->field_cache))
+#define CA_CTX_MERGE_CACHE(ctx) (&((ctx)->merge_cache))
 
 #define CA_CTX_FIELD_WITH_INDEX(ctx, i) ((&((ctx)->field_cache))->items[i])
 
@@ -250,6 +282,20 @@ void ca_ctx_init(ca_ctx_t ctx);
 void ca_ctx_clear(ca_ctx_t ctx);
 void ca_ctx_print(ca_ctx_t ctx);
 
+CA_INLINE void _ca_ctx_lock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&ctx->lock);
+#endif
+}
+
+CA_INLINE void _ca_ctx_unlock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&ctx->lock);
+#endif
+}
+
 CA_INLINE slong ca_ctx_get_option(ca_ctx_t ctx, slong i)
 {
     return ctx->options[i];
@@ -16,18 +16,30 @@
 void
 ca_ctx_clear(ca_ctx_t ctx)
 {
-    slong i;
+    fmpz_mpoly_ctx_struct ** mctx, ** prev;
+    slong i, len;
 
     CA_INFO(ctx, ("%wd extension numbers cached at time of destruction\n", CA_CTX_EXT_CACHE(ctx)->length));
     CA_INFO(ctx, ("%wd fields cached at time of destruction\n", CA_CTX_FIELD_CACHE(ctx)->length));
 
     ca_ext_cache_clear(CA_CTX_EXT_CACHE(ctx), ctx);
     ca_field_cache_clear(CA_CTX_FIELD_CACHE(ctx), ctx);
+    ca_field_merge_cache_clear(CA_CTX_MERGE_CACHE(ctx), ctx);
 
     for (i = 0; i < ctx->mctx_len; i++)
         flint_free(ctx->mctx[i]);
 
-    flint_free(ctx->mctx);
+    /* free the chain of arrays left behind by _ca_ctx_init_mctx */
+    for (mctx = ctx->mctx, len = ctx->mctx_len; mctx != NULL; mctx = prev, len /= 2)
+    {
+        prev = (fmpz_mpoly_ctx_struct **) mctx[len];
+        flint_free(mctx);
+    }
+
     flint_free(ctx->options);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&ctx->lock);
+#endif
 }
 
@@ -40,8 +40,20 @@ ca_ctx_init(ca_ctx_t ctx)
     ctx->mctx = NULL;
     ctx->mctx_len = 0;
 
+#if FLINT_USES_PTHREAD
+    {
+        pthread_mutexattr_t attr;
+
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&ctx->lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+#endif
+
     ca_ext_cache_init(CA_CTX_EXT_CACHE(ctx), ctx);
     ca_field_cache_init(CA_CTX_FIELD_CACHE(ctx), ctx);
+    ca_field_merge_cache_init(CA_CTX_MERGE_CACHE(ctx), CA_FIELD_MERGE_CACHE_SETS, ctx);
 
     /* Always create QQ */
     ctx->field_qq = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), NULL, 0, ctx);
@@ -49,6 +49,8 @@ ca_ctx_print(ca_ctx_t ctx)
 {
     slong i;
 
+    _ca_ctx_lock(ctx);
+
     flint_printf("Calcium context with %wd cached fields:\n", CA_CTX_FIELD_CACHE(ctx)->length);
     for (i = 0; i < CA_CTX_FIELD_CACHE(ctx)->length; i++)
     {
@@ -57,6 +59,8 @@ ca_ctx_print(ca_ctx_t ctx)
         flint_printf("\n");
     }
     flint_printf("\n");
+
+    _ca_ctx_unlock(ctx);
 }
 
 void
@@ -91,6 +91,11 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
     xgen_map = flint_malloc(xlen * sizeof(slong));
     ygen_map = flint_malloc(ylen * sizeof(slong));
 
+    field = ca_field_merge_cache_lookup(xgen_map, ygen_map, CA_CTX_MERGE_CACHE(ctx), xfield, yfield, ctx);
+
+    if (field != NULL)
+        goto merged;
+
 /*
     printf("merge fields of len %ld and len %ld\n", xlen, ylen);
     for (ix = 0; ix < xlen; ix++)
@@ -161,6 +166,8 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
 
     field = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), ext, ext_len, ctx);
 
+    ca_field_merge_cache_insert(CA_CTX_MERGE_CACHE(ctx), xfield, yfield, field, xgen_map, ygen_map, ctx);
+
 /*
     printf("MERGE FIELDS:\n");
     if (CA_FIELD_LENGTH(xfield) > 100) flint_abort();
@@ -171,6 +178,7 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
     ca_field_print(field, ctx); printf("\n\n");
 */
 
+merged:
     if (xfield == field)
     {
         ca_set(resx, x, ctx);
@@ -0,0 +1,155 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "ca.h"
+
+typedef struct
+{
+    ca_ctx_struct * ctx;
+    truth_t * results;
+}
+work_t;
+
+/* (sqrt(k) + log(k + 2))^2 - log(k + 2)^2 - 2 sqrt(k) log(k + 2) - k
+   and (sqrt(k) + sqrt(k + 1))^2 - 2 sqrt(k) sqrt(k + 1) - (2k + 1)
+   are both zero */
+static void
+worker(slong i, void * _args)
+{
+    work_t * args = (work_t *) _args;
+    ca_ctx_struct * ctx = args->ctx;
+    ulong k = 2 + i % 7;
+    ca_t a, b, c, t, u;
+
+    ca_init(a, ctx);
+    ca_init(b, ctx);
+    ca_init(c, ctx);
+    ca_init(t, ctx);
+    ca_init(u, ctx);
+
+    ca_sqrt_ui(a, k, ctx);
+    ca_set_ui(c, k + 2, ctx);
+    ca_log(c, c, ctx);
+
+    if (i % 2 == 0)
+    {
+        ca_add(t, a, c, ctx);
+        ca_mul(t, t, t, ctx);
+        ca_mul(u, c, c, ctx);
+        ca_sub(t, t, u, ctx);
+        ca_mul(u, a, c, ctx);
+        ca_mul_ui(u, u, 2, ctx);
+        ca_sub(t, t, u, ctx);
+        ca_sub_ui(t, t, k, ctx);
+    }
+    else
+    {
+        ca_sqrt_ui(b, k + 1, ctx);
+        ca_add(t, a, b, ctx);
+        ca_mul(t, t, t, ctx);
+        ca_mul(u, a, b, ctx);
+        ca_mul_ui(u, u, 2, ctx);
+        ca_sub(t, t, u, ctx);
+        ca_sub_ui(t, t, 2 * k + 1, ctx);
+    }
+
+    args->results[i] = ca_check_is_zero(t, ctx);
+
+    ca_clear(a, ctx);
+    ca_clear(b, ctx);
+    ca_clear(c, ctx);
+    ca_clear(t, ctx);
+    ca_clear(u, ctx);
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_shared....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* repeated merges of the same fields give consistent results */
+    for (iter = 0; iter < 200 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y, z, w;
+        slong j;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(w, ctx);
+
+        ca_randtest(x, state, 3, 5, ctx);
+        ca_randtest(y, state, 3, 5, ctx);
+
+        for (j = 0; j < 3; j++)
+        {
+            if (j == 2)
+                ca_swap(x, y, ctx);
+
+            ca_add(z, x, y, ctx);
+            ca_sub(w, z, y, ctx);
+
+            if (ca_check_equal(w, x, ctx) == T_FALSE)
+            {
+                flint_printf("FAIL (merge)\n\n");
+                flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+                flint_printf("y = "); ca_print(y, ctx); flint_printf("\n\n");
+                flint_printf("w = "); ca_print(w, ctx); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(w, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    /* one context shared between threads */
+    for (iter = 0; iter < 10 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        work_t args;
+        slong i, n = 28;
+
+        ca_ctx_init(ctx);
+        args.ctx = ctx;
+        args.results = flint_malloc(sizeof(truth_t) * n);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+        flint_parallel_do(worker, &args, n, -1, FLINT_PARALLEL_STRIDED);
+
+        for (i = 0; i < n; i++)
+        {
+            if (args.results[i] != T_TRUE)
+            {
+                flint_printf("FAIL (threads)\n\n");
+                flint_printf("i = %wd, result = %d\n", i, args.results[i]);
+                flint_abort();
+            }
+        }
+
+        flint_free(args.results);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
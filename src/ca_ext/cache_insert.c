@@ -18,6 +18,8 @@ ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t
 
     xhash = ca_ext_hash(x, ctx);
 
+    _ca_ctx_lock(ctx);
+
     /* make room for inserting entry if needed */
     if (cache->length == cache->alloc)
     {
@@ -75,15 +77,25 @@ ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t
         /* not found, so insert */
         if (cache->hash_table[loc] == -1)
         {
+            ca_ext_ptr res;
+
             ca_ext_init_set(cache->items[cache->length], x, ctx);
             cache->hash_table[loc] = cache->length;
             cache->length++;
-            return cache->items[cache->length - 1];
+            res = cache->items[cache->length - 1];
+
+            _ca_ctx_unlock(ctx);
+            return res;
         }
 
         /* found */
         if (ca_ext_equal_repr(cache->items[cache->hash_table[loc]], x, ctx))
-            return cache->items[cache->hash_table[loc]];
+        {
+            ca_ext_ptr res = cache->items[cache->hash_table[loc]];
+
+            _ca_ctx_unlock(ctx);
+            return res;
+        }
 
         loc++;
         if (loc == cache->hash_size)
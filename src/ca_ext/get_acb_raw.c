@@ -59,18 +59,25 @@
 void
 ca_ext_get_acb_raw(acb_t res, ca_ext_t x, slong prec, ca_ctx_t ctx)
 {
+    /* extension numbers may be shared between threads through the
+       context, so the cached enclosures are only accessed under its lock */
     if (CA_EXT_HEAD(x) == CA_QQBar)
     {
+        _ca_ctx_lock(ctx);
         qqbar_cache_enclosure(CA_EXT_QQBAR(x), prec);
         qqbar_get_acb(res, CA_EXT_QQBAR(x), prec);
+        _ca_ctx_unlock(ctx);
         return;
     }
 
+    _ca_ctx_lock(ctx);
     if (prec <= CA_EXT_FUNC_PREC(x))
     {
         acb_set(res, CA_EXT_FUNC_ENCLOSURE(x));
+        _ca_ctx_unlock(ctx);
         return;
     }
+    _ca_ctx_unlock(ctx);
 
     switch (CA_EXT_HEAD(x))
     {
@@ -127,7 +134,12 @@ ca_ext_get_acb_raw(acb_t res, ca_ext_t x, slong prec, ca_ctx_t ctx)
             flint_abort();
     }
 
-    acb_set(CA_EXT_FUNC_ENCLOSURE(x), res);
-    CA_EXT_FUNC_PREC(x) = prec;
+    _ca_ctx_lock(ctx);
+    if (prec > CA_EXT_FUNC_PREC(x))
+    {
+        acb_set(CA_EXT_FUNC_ENCLOSURE(x), res);
+        CA_EXT_FUNC_PREC(x) = prec;
+    }
+    _ca_ctx_unlock(ctx);
 }
 
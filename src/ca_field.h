@@ -52,6 +52,14 @@ void ca_field_cache_init(ca_field_cache_t cache, ca_ctx_t ctx);
 void ca_field_cache_clear(ca_field_cache_t cache, ca_ctx_t ctx);
 ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, ca_ctx_t ctx);
 
+#define CA_FIELD_MERGE_CACHE_WAYS 4
+#define CA_FIELD_MERGE_CACHE_SETS 64
+
+void ca_field_merge_cache_init(ca_field_merge_cache_t cache, slong num_sets, ca_ctx_t ctx);
+void ca_field_merge_cache_clear(ca_field_merge_cache_t cache, ca_ctx_t ctx);
+ca_field_ptr ca_field_merge_cache_lookup(slong * xgen_map, slong * ygen_map, ca_field_merge_cache_t cache, ca_field_srcptr x, ca_field_srcptr y, ca_ctx_t ctx);
+void ca_field_merge_cache_insert(ca_field_merge_cache_t cache, ca_field_srcptr x, ca_field_srcptr y, ca_field_srcptr field, const slong * xgen_map, const slong * ygen_map, ca_ctx_t ctx);
+
 #ifdef __cplusplus
 }
 #endif
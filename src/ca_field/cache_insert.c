@@ -20,18 +20,26 @@ ca_field_ptr ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x
 
     xhash = qqbar_hash(x);
 
+    _ca_ctx_lock(ctx);
+
     loc = xhash % ((ulong) cache->hash_size);
 
     for (i = 0; i < cache->hash_size; i++)
     {
         /* not found */
         if (cache->hash_table[loc] == -1)
+        {
+            _ca_ctx_unlock(ctx);
             return NULL;
+        }
 
         K = cache->items[cache->hash_table[loc]];
         /* found */
         if (CA_FIELD_IS_NF(K) && qqbar_equal(x, CA_FIELD_NF_QQBAR(K)))
+        {
+            _ca_ctx_unlock(ctx);
             return K;
+        }
 
         loc++;
         if (loc == cache->hash_size)
@@ -111,6 +119,10 @@ ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct **
 
     xhash = _ca_field_hash(x, length, ctx);
 
+    /* the lock is recursive, since building the ideal of a new field
+       may create further extension numbers and fields */
+    _ca_ctx_lock(ctx);
+
     /* make room for inserting entry if needed */
     if (cache->length == cache->alloc)
     {
@@ -179,12 +191,18 @@ ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct **
 
             ca_field_build_ideal(res, ctx);
 
+            _ca_ctx_unlock(ctx);
             return res;
         }
 
         /* found */
         if (_ca_field_equal_ext(cache->items[cache->hash_table[loc]], x, length, ctx))
-            return cache->items[cache->hash_table[loc]];
+        {
+            ca_field_ptr res = cache->items[cache->hash_table[loc]];
+
+            _ca_ctx_unlock(ctx);
+            return res;
+        }
 
         loc++;
         if (loc == cache->hash_size)
@@ -16,19 +16,35 @@
 void
 _ca_ctx_init_mctx(ca_ctx_t ctx, slong len)
 {
+    _ca_ctx_lock(ctx);
+
     while (ctx->mctx_len < len)
     {
         slong i, alloc;
+        fmpz_mpoly_ctx_struct ** mctx;
+
         alloc = FLINT_MAX(1, 2 * ctx->mctx_len);
-        ctx->mctx = flint_realloc(ctx->mctx, alloc * sizeof(fmpz_mpoly_ctx_struct *));
+
+        /* Other threads may be reading the old array, so instead of
+           reallocating it we keep it linked from an extra slot at the end
+           of the new one; it is freed by ca_ctx_clear. */
+        mctx = flint_malloc((alloc + 1) * sizeof(fmpz_mpoly_ctx_struct *));
+
+        for (i = 0; i < ctx->mctx_len; i++)
+            mctx[i] = ctx->mctx[i];
 
         for (i = ctx->mctx_len; i < alloc; i++)
         {
-            ctx->mctx[i] = flint_malloc(sizeof(fmpz_mpoly_ctx_struct));
-            fmpz_mpoly_ctx_init(ctx->mctx[i], i + 1, ctx->options[CA_OPT_MPOLY_ORD]);
+            mctx[i] = flint_malloc(sizeof(fmpz_mpoly_ctx_struct));
+            fmpz_mpoly_ctx_init(mctx[i], i + 1, ctx->options[CA_OPT_MPOLY_ORD]);
         }
+
+        mctx[alloc] = (fmpz_mpoly_ctx_struct *) ctx->mctx;
+        ctx->mctx = mctx;
         ctx->mctx_len = alloc;
     }
+
+    _ca_ctx_unlock(ctx);
 }
 
 
@@ -0,0 +1,138 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ca_field.h"
+
+void
+ca_field_merge_cache_init(ca_field_merge_cache_t cache, slong num_sets, ca_ctx_t ctx)
+{
+    slong i;
+
+    cache->num_sets = num_sets;
+    cache->clock = 0;
+    cache->items = flint_malloc(sizeof(ca_field_merge_struct) * num_sets * CA_FIELD_MERGE_CACHE_WAYS);
+
+    for (i = 0; i < num_sets * CA_FIELD_MERGE_CACHE_WAYS; i++)
+    {
+        cache->items[i].x = NULL;
+        cache->items[i].y = NULL;
+        cache->items[i].field = NULL;
+        cache->items[i].gen_map = NULL;
+        cache->items[i].last_used = 0;
+    }
+}
+
+void
+ca_field_merge_cache_clear(ca_field_merge_cache_t cache, ca_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < cache->num_sets * CA_FIELD_MERGE_CACHE_WAYS; i++)
+        flint_free(cache->items[i].gen_map);
+
+    flint_free(cache->items);
+}
+
+/* The merge of y and x is looked up as that of x and y with the maps
+   swapped, so entries are keyed on the pair ordered by address. */
+static ca_field_merge_struct *
+_ca_field_merge_cache_set(ca_field_merge_cache_t cache, ca_field_srcptr x, ca_field_srcptr y)
+{
+    ulong h;
+
+    h = CA_FIELD_HASH(x) * CA_FIELD_HASH_C + CA_FIELD_HASH(y);
+    h ^= h >> 17;
+
+    return cache->items + (h % (ulong) cache->num_sets) * CA_FIELD_MERGE_CACHE_WAYS;
+}
+
+ca_field_ptr
+ca_field_merge_cache_lookup(slong * xgen_map, slong * ygen_map, ca_field_merge_cache_t cache, ca_field_srcptr x, ca_field_srcptr y, ca_ctx_t ctx)
+{
+    ca_field_merge_struct * set;
+    ca_field_ptr res = NULL;
+    slong i, j;
+
+    if (x > y)
+        return ca_field_merge_cache_lookup(ygen_map, xgen_map, cache, y, x, ctx);
+
+    _ca_ctx_lock(ctx);
+
+    set = _ca_field_merge_cache_set(cache, x, y);
+
+    for (i = 0; i < CA_FIELD_MERGE_CACHE_WAYS; i++)
+    {
+        if (set[i].x == x && set[i].y == y)
+        {
+            set[i].last_used = ++cache->clock;
+
+            for (j = 0; j < CA_FIELD_LENGTH(x); j++)
+                xgen_map[j] = set[i].gen_map[j];
+            for (j = 0; j < CA_FIELD_LENGTH(y); j++)
+                ygen_map[j] = set[i].gen_map[CA_FIELD_LENGTH(x) + j];
+
+            res = set[i].field;
+            break;
+        }
+    }
+
+    _ca_ctx_unlock(ctx);
+
+    return res;
+}
+
+void
+ca_field_merge_cache_insert(ca_field_merge_cache_t cache, ca_field_srcptr x, ca_field_srcptr y, ca_field_srcptr field, const slong * xgen_map, const slong * ygen_map, ca_ctx_t ctx)
+{
+    ca_field_merge_struct * set, * entry;
+    slong i, xlen, ylen;
+
+    if (x > y)
+    {
+        ca_field_merge_cache_insert(cache, y, x, field, ygen_map, xgen_map, ctx);
+        return;
+    }
+
+    xlen = CA_FIELD_LENGTH(x);
+    ylen = CA_FIELD_LENGTH(y);
+
+    _ca_ctx_lock(ctx);
+
+    set = _ca_field_merge_cache_set(cache, x, y);
+
+    /* replace the least recently used entry, unless another thread
+       already inserted this pair */
+    entry = set;
+    for (i = 0; i < CA_FIELD_MERGE_CACHE_WAYS; i++)
+    {
+        if (set[i].x == x && set[i].y == y)
+        {
+            entry = NULL;
+            break;
+        }
+
+        if (set[i].last_used < entry->last_used)
+            entry = set + i;
+    }
+
+    if (entry != NULL)
+    {
+        entry->x = (ca_field_ptr) x;
+        entry->y = (ca_field_ptr) y;
+        entry->field = (ca_field_ptr) field;
+        entry->gen_map = flint_realloc(entry->gen_map, sizeof(slong) * (xlen + ylen));
+        for (i = 0; i < xlen; i++)
+            entry->gen_map[i] = xgen_map[i];
+        for (i = 0; i < ylen; i++)
+            entry->gen_map[xlen + i] = ygen_map[i];
+        entry->last_used = ++cache->clock;
+    }
+
+    _ca_ctx_unlock(ctx);
+}
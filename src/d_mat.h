@@ -143,6 +143,13 @@ void d_mat_swap_rows(d_mat_t mat, slong r, slong s)
     }
 }
 
+/* LU decomposition and solving */
+
+int d_mat_lu(slong * P, d_mat_t LU, const d_mat_t A);
+
+void d_mat_solve_lu_precomp(d_mat_t X, const slong * P, const d_mat_t LU,
+    const d_mat_t B);
+
 /* Gram-Schmidt Orthogonalisation and QR Decomposition  ********************************************************/
 
 void d_mat_gso(d_mat_t B, const d_mat_t A);
@@ -0,0 +1,76 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include "d_mat.h"
+
+int
+d_mat_lu(slong * P, d_mat_t LU, const d_mat_t A)
+{
+    slong i, j, k, m, n, r, row;
+    double d, e, t;
+    double * a;
+
+    m = A->r;
+    n = A->c;
+
+    if (LU->r != m || LU->c != n)
+    {
+        flint_printf("Exception (d_mat_lu). Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    if (LU != A)
+        d_mat_set(LU, A);
+
+    for (i = 0; i < m; i++)
+        P[i] = i;
+
+    for (row = 0; row < m && row < n; row++)
+    {
+        r = row;
+        t = fabs(d_mat_entry(LU, row, row));
+
+        for (i = row + 1; i < m; i++)
+        {
+            if (fabs(d_mat_entry(LU, i, row)) > t)
+            {
+                r = i;
+                t = fabs(d_mat_entry(LU, i, row));
+            }
+        }
+
+        /* also catches NaN */
+        if (!(t > 0.0))
+            return 0;
+
+        if (r != row)
+        {
+            d_mat_swap_rows(LU, row, r);
+            k = P[row];
+            P[row] = P[r];
+            P[r] = k;
+        }
+
+        a = LU->rows[row];
+        d = 1.0 / a[row];
+
+        for (i = row + 1; i < m; i++)
+        {
+            double * b = LU->rows[i];
+
+            e = b[row] * d;
+            for (j = row + 1; j < n; j++)
+                b[j] -= e * a[j];
+            b[row] = e;
+        }
+    }
+
+    return 1;
+}
@@ -0,0 +1,74 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "d_mat.h"
+
+void
+d_mat_solve_lu_precomp(d_mat_t X, const slong * P, const d_mat_t LU,
+    const d_mat_t B)
+{
+    slong i, j, k, n, m;
+    d_mat_t T;
+
+    n = LU->r;
+    m = B->c;
+
+    if (LU->c != n || B->r != n || X->r != n || X->c != m)
+    {
+        flint_printf("Exception (d_mat_solve_lu_precomp). "
+            "Incompatible dimensions.\n");
+        flint_abort();
+    }
+
+    /* work on rows of the right-hand side, so that the inner loops
+       run over contiguous memory */
+    d_mat_init(T, n, m);
+
+    for (i = 0; i < n; i++)
+        for (j = 0; j < m; j++)
+            d_mat_entry(T, i, j) = d_mat_entry(B, P[i], j);
+
+    for (i = 0; i < n; i++)
+    {
+        double * t = T->rows[i];
+
+        for (k = 0; k < i; k++)
+        {
+            double c = d_mat_entry(LU, i, k);
+            double * s = T->rows[k];
+
+            if (c != 0.0)
+                for (j = 0; j < m; j++)
+                    t[j] -= c * s[j];
+        }
+    }
+
+    for (i = n - 1; i >= 0; i--)
+    {
+        double * t = T->rows[i];
+        double c;
+
+        for (k = i + 1; k < n; k++)
+        {
+            double * s = T->rows[k];
+
+            c = d_mat_entry(LU, i, k);
+            if (c != 0.0)
+                for (j = 0; j < m; j++)
+                    t[j] -= c * s[j];
+        }
+
+        c = d_mat_entry(LU, i, i);
+        for (j = 0; j < m; j++)
+            t[j] /= c;
+    }
+
+    d_mat_swap_entrywise(X, T);
+    d_mat_clear(T);
+}
@@ -0,0 +1,130 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "double_extras.h"
+#include "d_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("lu....");
+    fflush(stdout);
+
+    /* check PA = LU and A (A^-1 B) = B for diagonally dominant A */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        d_mat_t A, LU, L, U, PA, T, B, X;
+        slong * P;
+        slong j, k, n, m;
+
+        n = n_randint(state, 20);
+        m = n_randint(state, 5);
+
+        d_mat_init(A, n, n);
+        d_mat_init(LU, n, n);
+        d_mat_init(L, n, n);
+        d_mat_init(U, n, n);
+        d_mat_init(PA, n, n);
+        d_mat_init(T, n, n);
+        d_mat_init(B, n, m);
+        d_mat_init(X, n, m);
+        P = flint_malloc(sizeof(slong) * FLINT_MAX(n, 1));
+
+        d_mat_randtest(A, state, 0, 0);
+        d_mat_randtest(B, state, 0, 0);
+        for (j = 0; j < n; j++)
+            d_mat_entry(A, j, j) += (n_randint(state, 2) ? 1 : -1) * (n + 1.0);
+
+        if (n_randint(state, 2))
+        {
+            if (!d_mat_lu(P, LU, A))
+            {
+                flint_printf("FAIL (singular)\n");
+                flint_abort();
+            }
+        }
+        else
+        {
+            d_mat_set(LU, A);
+            if (!d_mat_lu(P, LU, LU))
+            {
+                flint_printf("FAIL (singular, aliasing)\n");
+                flint_abort();
+            }
+        }
+
+        for (j = 0; j < n; j++)
+        {
+            for (k = 0; k < n; k++)
+            {
+                d_mat_entry(L, j, k) = (k < j) ? d_mat_entry(LU, j, k) : (j == k);
+                d_mat_entry(U, j, k) = (k >= j) ? d_mat_entry(LU, j, k) : 0.0;
+                d_mat_entry(PA, j, k) = d_mat_entry(A, P[j], k);
+            }
+        }
+
+        d_mat_mul_classical(T, L, U);
+
+        if (!d_mat_approx_equal(T, PA, 100 * n * D_EPS))
+        {
+            flint_printf("FAIL (PA = LU)\n");
+            flint_printf("A:\n"); d_mat_print(A);
+            flint_printf("LU:\n"); d_mat_print(LU);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (n_randint(state, 2))
+        {
+            d_mat_solve_lu_precomp(X, P, LU, B);
+        }
+        else
+        {
+            d_mat_set(X, B);
+            d_mat_solve_lu_precomp(X, P, LU, X);
+        }
+
+        {
+            d_mat_t AX;
+            d_mat_init(AX, n, m);
+            d_mat_mul_classical(AX, A, X);
+
+            if (!d_mat_approx_equal(AX, B, 100 * n * D_EPS))
+            {
+                flint_printf("FAIL (solve)\n");
+                flint_printf("A:\n"); d_mat_print(A);
+                flint_printf("B:\n"); d_mat_print(B);
+                flint_printf("X:\n"); d_mat_print(X);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            d_mat_clear(AX);
+        }
+
+        d_mat_clear(A);
+        d_mat_clear(LU);
+        d_mat_clear(L);
+        d_mat_clear(U);
+        d_mat_clear(PA);
+        d_mat_clear(T);
+        d_mat_clear(B);
+        d_mat_clear(X);
+        flint_free(P);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
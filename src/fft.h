@@ -252,6 +252,13 @@ void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2,
 void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2);
 
+void mul_mfa_truncate_sqrt2_disk(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, flint_bitcnt_t depth,
+                        flint_bitcnt_t w, const char * dir);
+
+void flint_mpn_mul_fft_disk(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, const char * dir);
+
 void fft_convolution_basic(mp_limb_t ** ii, mp_limb_t ** jj,
 		     slong depth, slong limbs, slong trunc, mp_limb_t ** t1,
                             mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt);
@@ -0,0 +1,230 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#define FFT_HAVE_MMAP 0
+#else
+#define FFT_HAVE_MMAP 1
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#endif
+
+#include "flint.h"
+#include "mpn_extras.h"
+#include "fft.h"
+
+/*
+    Coefficient storage for the transforms, backed by an anonymous (unlinked)
+    file in dir, or in $TMPDIR or /tmp if dir is NULL. The pages are written
+    back to the file by the kernel under memory pressure instead of going
+    to swap. Without mmap we fall back to ordinary heap memory.
+*/
+static mp_limb_t *
+_fft_scratch_map(size_t bytes, const char * dir)
+{
+#if FFT_HAVE_MMAP
+    char * path;
+    void * ptr;
+    int fd;
+
+    if (dir == NULL)
+        dir = getenv("TMPDIR");
+    if (dir == NULL)
+        dir = "/tmp";
+
+    path = flint_malloc(strlen(dir) + 20);
+    strcpy(path, dir);
+    strcat(path, "/flint_fft_XXXXXX");
+
+    fd = mkstemp(path);
+    if (fd == -1)
+        flint_throw(FLINT_ERROR, "unable to create a scratch file in %s\n", dir);
+
+    unlink(path);
+    flint_free(path);
+
+    if (ftruncate(fd, bytes) != 0)
+    {
+        close(fd);
+        flint_throw(FLINT_ERROR, "unable to extend a scratch file to %wu bytes\n", (ulong) bytes);
+    }
+
+    ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (ptr == MAP_FAILED)
+        flint_throw(FLINT_ERROR, "unable to map a scratch file of %wu bytes\n", (ulong) bytes);
+
+    return ptr;
+#else
+    return flint_malloc(bytes);
+#endif
+}
+
+static void
+_fft_scratch_unmap(mp_limb_t * ptr, size_t bytes)
+{
+#if FFT_HAVE_MMAP
+    munmap(ptr, bytes);
+#else
+    flint_free(ptr);
+#endif
+}
+
+void mul_mfa_truncate_sqrt2_disk(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, flint_bitcnt_t depth,
+                        flint_bitcnt_t w, const char * dir)
+{
+   mp_size_t n = (UWORD(1)<<depth);
+   flint_bitcnt_t bits1 = (n*w - (depth+1))/2;
+   mp_size_t sqrt = (UWORD(1)<<(depth/2));
+
+   mp_size_t r_limbs = n1 + n2;
+   mp_size_t limbs = (n*w)/FLINT_BITS;
+   mp_size_t size = limbs + 1;
+
+   mp_size_t j1 = (n1*FLINT_BITS - 1)/bits1 + 1;
+   mp_size_t j2 = (n2*FLINT_BITS - 1)/bits1 + 1;
+
+   mp_size_t i, j, trunc;
+   size_t bytes;
+
+   mp_limb_t ** ii, ** jj, * ptr, * data;
+   mp_limb_t ** s1, ** t1, ** t2, ** tt;
+
+   int N, squaring = (i1 == i2);
+
+   /*
+      Only the 4n coefficients of each operand live in the scratch file;
+      the pointer tables and the per-thread temporaries stay in memory.
+      The column and row passes of the matrix Fourier algorithm each
+      touch about sqrt(4n) coefficients at a time.
+   */
+   bytes = (squaring ? 1 : 2)*4*n*size*sizeof(mp_limb_t);
+   data = _fft_scratch_map(bytes, dir);
+
+   N = flint_get_num_threads();
+   ii = flint_malloc(((squaring ? 1 : 2)*4*n + 5*size*N)*sizeof(mp_limb_t));
+   jj = squaring ? ii : ii + 4*n;
+   ptr = (mp_limb_t *) ii + (squaring ? 1 : 2)*4*n;
+
+   for (i = 0; i < 4*n; i++)
+      ii[i] = data + i*size;
+
+   if (!squaring)
+   {
+      for (i = 0; i < 4*n; i++)
+         jj[i] = data + (4*n + i)*size;
+   }
+
+   s1 = flint_malloc(4*N*sizeof(mp_limb_t *));
+   t1 = s1 + N;
+   t2 = t1 + N;
+   tt = t2 + N;
+
+   s1[0] = ptr;
+   t1[0] = s1[0] + size*N;
+   t2[0] = t1[0] + size*N;
+   tt[0] = t2[0] + size*N;
+
+   for (i = 1; i < N; i++)
+   {
+      s1[i] = s1[i - 1] + size;
+      t1[i] = t1[i - 1] + size;
+      t2[i] = t2[i - 1] + size;
+      tt[i] = tt[i - 1] + 2*size;
+   }
+
+   trunc = j1 + j2 - 1;
+   if (trunc <= 2*n) trunc = 2*n + 1;
+   trunc = 2*sqrt*((trunc + 2*sqrt - 1)/(2*sqrt)); /* trunc must be divisible by 2*sqrt */
+
+   j1 = fft_split_bits(ii, i1, n1, bits1, limbs);
+   for (j = j1 ; j < 4*n; j++)
+      flint_mpn_zero(ii[j], limbs + 1);
+
+   fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
+
+   if (!squaring)
+   {
+      j2 = fft_split_bits(jj, i2, n2, bits1, limbs);
+      for (j = j2 ; j < 4*n; j++)
+         flint_mpn_zero(jj[j], limbs + 1);
+
+      fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc);
+   } else j2 = j1;
+
+   fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, s1, sqrt, trunc, tt);
+   ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
+
+   flint_mpn_zero(r1, r_limbs);
+   fft_combine_bits(r1, ii, j1 + j2 - 1, bits1, limbs, r_limbs);
+
+   flint_free(s1);
+   flint_free(ii);
+   _fft_scratch_unmap(data, bytes);
+}
+
+void flint_mpn_mul_fft_disk(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                        mp_srcptr i2, mp_size_t n2, const char * dir)
+{
+   mp_size_t depth = 6;
+   mp_size_t w = 1;
+   mp_size_t n = ((mp_size_t) 1 << depth);
+   flint_bitcnt_t bits = (n*w - (depth+1))/2;
+
+   flint_bitcnt_t bits1 = n1*FLINT_BITS;
+   flint_bitcnt_t bits2 = n2*FLINT_BITS;
+
+   mp_size_t j1 = (bits1 - 1)/bits + 1;
+   mp_size_t j2 = (bits2 - 1)/bits + 1;
+
+   FLINT_ASSERT(n1 >= n2);
+   FLINT_ASSERT(n2 > 0);
+
+   while (j1 + j2 - 1 > 4*n) /* find n, w as in flint_mpn_mul_fft_main */
+   {
+      if (w == 1) w = 2;
+      else
+      {
+         depth++;
+         w = 1;
+         n *= 2;
+      }
+
+      bits = (n*w - (depth+1))/2;
+      j1 = (bits1 - 1)/bits + 1;
+      j2 = (bits2 - 1)/bits + 1;
+   }
+
+   /* too small for the buffers to matter */
+   if (depth < 11)
+   {
+      if (j1 + j2 - 1 > 2*n)
+         flint_mpn_mul_fft_main(r1, i1, n1, i2, n2);
+      else if (i1 == i2 && n1 == n2)
+         mpn_sqr(r1, i1, n1);
+      else
+         mpn_mul(r1, i1, n1, i2, n2);
+      return;
+   }
+
+   if (j1 + j2 - 1 <= 3*n)
+   {
+      depth--;
+      w *= 3;
+   }
+
+   mul_mfa_truncate_sqrt2_disk(r1, i1, n1, i2, n2, depth, w, dir);
+}
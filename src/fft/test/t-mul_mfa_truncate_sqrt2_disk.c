@@ -0,0 +1,121 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "mpn_extras.h"
+#include "fft.h"
+
+int
+main(void)
+{
+    flint_bitcnt_t depth, w;
+    slong iter;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_mfa_truncate_sqrt2_disk....");
+    fflush(stdout);
+
+
+    _flint_rand_init_gmp(state);
+
+    for (depth = 6; depth <= 12; depth++)
+    {
+        for (w = 1; w <= 3 - (depth >= 12); w++)
+        {
+            mp_size_t n = (UWORD(1)<<depth);
+            flint_bitcnt_t bits1 = (n*w - (depth + 1))/2;
+            mp_size_t trunc = 2*n + 2*n_randint(state, n) + 2; /* trunc is even */
+            flint_bitcnt_t bits = (trunc/2)*bits1;
+            mp_size_t int_limbs = (bits - 1)/FLINT_BITS + 1;
+            mp_size_t j;
+            mp_limb_t * i1, *i2, *r1, *r2;
+            int squaring = n_randint(state, 2);
+
+            i1 = flint_malloc(6*int_limbs*sizeof(mp_limb_t));
+            i2 = squaring ? i1 : i1 + int_limbs;
+            r1 = i1 + 2*int_limbs;
+            r2 = r1 + 2*int_limbs;
+
+            random_fermat(i1, state, int_limbs);
+            random_fermat(i2, state, int_limbs);
+
+            flint_set_num_threads(1 + n_randint(state, 4));
+
+            mpn_mul(r2, i1, int_limbs, i2, int_limbs);
+            mul_mfa_truncate_sqrt2_disk(r1, i1, int_limbs, i2, int_limbs, depth, w, NULL);
+
+            for (j = 0; j < 2*int_limbs; j++)
+            {
+                if (r1[j] != r2[j])
+                {
+                    flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+
+            flint_free(i1);
+        }
+    }
+
+    /* flint_mpn_mul_fft_disk and the global switch in flint_mpn_mul */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        mp_size_t n1, n2, j;
+        mp_limb_t * i1, *i2, *r1, *r2;
+        int squaring = n_randint(state, 3) == 0;
+
+        n1 = 1 + n_randint(state, 100000);
+        n2 = squaring ? n1 : 1 + n_randint(state, n1);
+
+        i1 = flint_malloc((3*n1 + 3*n2)*sizeof(mp_limb_t));
+        i2 = squaring ? i1 : i1 + n1;
+        r1 = i1 + n1 + n2;
+        r2 = r1 + n1 + n2;
+
+        flint_mpn_rrandom(i1, state->gmp_state, n1);
+        flint_mpn_rrandom(i1 + n1, state->gmp_state, n2);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        mpn_mul(r2, i1, n1, i2, n2);
+
+        if (n_randint(state, 2))
+        {
+            flint_mpn_mul_fft_disk(r1, i1, n1, i2, n2, NULL);
+        }
+        else
+        {
+            flint_mpn_mul_set_disk_threshold(1 + n_randint(state, n1 + n2), NULL);
+            flint_mpn_mul(r1, i1, n1, i2, n2);
+            flint_mpn_mul_set_disk_threshold(0, NULL);
+        }
+
+        for (j = 0; j < n1 + n2; j++)
+        {
+            if (r1[j] != r2[j])
+            {
+                flint_printf("FAIL\n");
+                flint_printf("n1 = %wd, n2 = %wd\n", n1, n2);
+                flint_printf("error in limb %wd, %wx != %wx\n", j, r1[j], r2[j]);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_free(i1);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -398,6 +398,8 @@ typedef profile_entry_struct profile_entry_t[1];
 
 #define MPN_CTX_NCRTS 8
 #define MAX_NPROFILES 20
+/* max threads used by a single multiplication (huge operands only) */
+#define MPN_CTX_MAX_THREADS 16
 #define VEC_SZ 4
 
 /*
@@ -514,6 +516,13 @@ void _nmod_poly_divrem_precomp_init(
     nmod_t mod,
     mpn_ctx_t R);
 
+void _nmod_poly_divrem_precomp_init_preinv(
+    nmod_poly_divrem_precomp_struct* M,
+    const ulong* b, ulong bn,
+    const ulong* binv, ulong Bn,
+    nmod_t mod,
+    mpn_ctx_t R);
+
 
 int _nmod_poly_divrem_precomp(
     ulong* q,
@@ -540,6 +549,56 @@ int _fmpz_poly_mul_mid_default_mpn_ctx(
     const fmpz * a, slong an,
     const fmpz * b, slong bn);
 
+int _fmpz_mod_poly_mul_mid_mpn_ctx(
+    fmpz * z, ulong zl, ulong zh,
+    const fmpz * a, ulong an,
+    const fmpz * b, ulong bn,
+    const fmpz_t mod,
+    mpn_ctx_t R);
+
+int _fmpz_mod_poly_mul_mid_default_mpn_ctx(
+    fmpz * z, slong zl, slong zh,
+    const fmpz * a, slong an,
+    const fmpz * b, slong bn,
+    const fmpz_t mod);
+
+/* number-theoretic transforms over a user supplied prime */
+
+typedef struct {
+    sd_fft_ctx_struct ffts[1];
+    ulong depth;
+    ulong blk_sz;
+    ulong Ninv;
+    double* twist;
+    double* untwist;
+} nmod_fft_ctx_struct;
+
+typedef nmod_fft_ctx_struct nmod_fft_ctx_t[1];
+
+void nmod_fft_ctx_init(nmod_fft_ctx_t F, ulong p, ulong depth);
+void nmod_fft_ctx_clear(nmod_fft_ctx_t F);
+ulong nmod_fft_ctx_point(const nmod_fft_ctx_t F, ulong i);
+
+double* nmod_fft_buf_init(const nmod_fft_ctx_t F);
+void nmod_fft_buf_clear(double* d);
+
+void nmod_fft_buf_set_nmod_vec(double* d, const ulong* a, ulong an, const nmod_fft_ctx_t F);
+void nmod_fft_buf_get_nmod_vec(ulong* a, const double* d, ulong an, const nmod_fft_ctx_t F);
+void nmod_fft_buf_set_transform(double* d, const ulong* a, ulong an, const nmod_fft_ctx_t F);
+void nmod_fft_buf_get_transform(ulong* a, const double* d, ulong an, const nmod_fft_ctx_t F);
+
+void nmod_fft_forward_trunc(double* d, ulong itrunc, ulong otrunc, nmod_fft_ctx_t F);
+void nmod_fft_inverse_trunc(double* d, ulong trunc, nmod_fft_ctx_t F);
+void nmod_fft_forward(double* d, nmod_fft_ctx_t F);
+void nmod_fft_inverse(double* d, nmod_fft_ctx_t F);
+void nmod_fft_forward_negacyclic(double* d, nmod_fft_ctx_t F);
+void nmod_fft_inverse_negacyclic(double* d, nmod_fft_ctx_t F);
+
+void nmod_fft_mul(double* a, const double* b, nmod_fft_ctx_t F);
+
+void nmod_fft_mul_cyclic(ulong* z, const ulong* a, const ulong* b, nmod_fft_ctx_t F);
+void nmod_fft_mul_negacyclic(ulong* z, const ulong* a, const ulong* b, nmod_fft_ctx_t F);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,525 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "nmod.h"
+#include "mpn_extras.h"
+#include "fft_small.h"
+#include "crt_helpers.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+/*
+    Multiplication of polynomials with coefficients in [0, n) for a multi-limb
+    modulus n. Each coefficient is cut into k chunks of s bits and the chunks
+    are laid out with stride K = 2k - 1, i.e. a(x) = sum a_{i,j} 2^(s j) x^i
+    becomes A(z) = sum a_{i,j} z^(K i + j). The coefficients of A*B are
+    nonnegative and smaller than the product of the np primes, so one unsigned
+    CRT recovers them exactly, and coefficient i of a*b is
+    sum_{m < K} c_{K i + m} 2^(s m). The final pass does the CRT, this
+    recombination and the reduction mod n without creating any intermediate
+    fmpz.
+*/
+
+#define MAX_CHUNKS 16
+
+typedef struct {
+    ulong k;        /* chunks per coefficient */
+    ulong K;        /* stride 2k - 1 */
+    ulong s;        /* bits per chunk */
+    ulong L;        /* limbs per chunk */
+    ulong accn;     /* limbs of the recombination accumulator */
+    ulong nn;       /* limbs of n */
+    ulong norm;
+    ulong * dnorm;  /* n << norm */
+    ulong * dinv;
+} _red_struct;
+
+static void _split(ulong * c, const fmpz * a, ulong an, const _red_struct * Z)
+{
+    ulong i, j, t, q, sh, off, dn, lo, hi;
+    ulong k = Z->k, s = Z->s, L = Z->L;
+    const ulong * d;
+    ulong d0;
+
+    for (i = 0; i < an; i++)
+    {
+        if (COEFF_IS_MPZ(a[i]))
+        {
+            __mpz_struct * z = COEFF_TO_PTR(a[i]);
+            d = z->_mp_d;
+            dn = z->_mp_size;
+        }
+        else
+        {
+            d0 = a[i];
+            d = &d0;
+            dn = (d0 != 0);
+        }
+
+        FLINT_ASSERT(fmpz_sgn(a + i) >= 0);
+
+        for (j = 0; j < k; j++)
+        {
+            off = j*s;
+            q = off / FLINT_BITS;
+            sh = off % FLINT_BITS;
+
+            for (t = 0; t < L; t++)
+            {
+                lo = (q + t < dn) ? d[q + t] : 0;
+                hi = (q + t + 1 < dn) ? d[q + t + 1] : 0;
+                c[t] = (sh == 0) ? lo : (lo >> sh) | (hi << (FLINT_BITS - sh));
+            }
+
+            if (s % FLINT_BITS != 0)
+                c[L - 1] &= (UWORD(1) << (s % FLINT_BITS)) - 1;
+
+            c += L;
+        }
+    }
+}
+
+static void _mod(
+    double* abuf, ulong atrunc,
+    const ulong * c, ulong an,
+    const _red_struct * Z,
+    const sd_fft_ctx_struct* fft)
+{
+    ulong i, j, t, r, w, hi, lo;
+    ulong k = Z->k, K = Z->K, L = Z->L;
+    nmod_t mod = fft->mod;
+
+    /* w = 2^FLINT_BITS mod p; since r*w < 2^FLINT_BITS*w, the high limb of
+       r*w + c stays below p and a single NMOD_RED2 suffices per limb */
+    NMOD_RED2(w, 1, 0, mod);
+
+    for (i = 0; i < an; i++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            r = c[L - 1];
+            for (t = L - 1; t > 0; t--)
+            {
+                umul_ppmm(hi, lo, r, w);
+                add_ssaaaa(hi, lo, hi, lo, 0, c[t - 1]);
+                NMOD_RED2(r, hi, lo, mod);
+            }
+
+            if (L == 1 && r >= mod.n)
+                NMOD_RED(r, r, mod);
+
+            sd_fft_ctx_set_index(abuf, i*K + j, r);
+            c += L;
+        }
+
+        if (i + 1 < an)
+            for ( ; j < K; j++)
+                sd_fft_ctx_set_index(abuf, i*K + j, 0);
+    }
+
+    for (i = (an - 1)*K + k; i < atrunc; i++)
+        sd_fft_ctx_set_index(abuf, i, 0);
+}
+
+/* acc += r*2^off */
+FLINT_FORCE_INLINE void _acc_add(ulong * acc, ulong accn,
+                                        const ulong * r, ulong n, ulong off)
+{
+    ulong q = off / FLINT_BITS;
+    ulong sh = off % FLINT_BITS;
+    ulong t[MPN_CTX_NCRTS + 1];
+
+    FLINT_ASSERT(accn >= q + n + 1);
+
+    if (sh == 0)
+    {
+        mpn_add(acc + q, acc + q, accn - q, r, n);
+    }
+    else
+    {
+        t[n] = mpn_lshift(t, r, n, sh);
+        mpn_add(acc + q, acc + q, accn - q, t, n + 1);
+    }
+}
+
+/* z = acc mod n, using t as scratch of accn + 1 limbs */
+static void _acc_reduce(fmpz_t z, const ulong * acc, ulong * t,
+                                                        const _red_struct * Z)
+{
+    ulong accn = Z->accn;
+
+    if (Z->norm != 0)
+        t[accn] = mpn_lshift(t, acc, accn, Z->norm);
+    else
+    {
+        flint_mpn_copyi(t, acc, accn);
+        t[accn] = 0;
+    }
+
+    flint_mpn_mod_preinvn(t, t, accn + 1, Z->dnorm, Z->nn, Z->dinv);
+
+    if (Z->norm != 0)
+        mpn_rshift(t, t, Z->nn, Z->norm);
+
+    fmpz_set_ui_array(z, t, Z->nn);
+}
+
+#define DEFINE_IT(NP, N, M) \
+static void CAT(_crt, NP)( \
+    fmpz * z, ulong zl, ulong zi_start, ulong zi_stop, \
+    sd_fft_ctx_struct* Rffts, double* d, ulong dstride, \
+    crt_data_struct* Rcrts, const _red_struct * Z) \
+{ \
+    ulong np = NP; \
+    ulong n = N; \
+    ulong K = Z->K; \
+    ulong ti_start = zi_start*K; \
+    ulong ti_stop = zi_stop*K; \
+    ulong zi = zi_start; \
+    ulong m = 0; \
+    ulong * acc, * tmp; \
+ \
+    FLINT_ASSERT(n == Rcrts[np-1].coeff_len); \
+ \
+    ulong Xs[BLK_SZ*NP]; \
+ \
+    acc = flint_malloc((2*Z->accn + 1)*sizeof(ulong)); \
+    tmp = acc + Z->accn; \
+ \
+    for (ulong i = n_round_down(ti_start, BLK_SZ); i < ti_stop; i += BLK_SZ) \
+    { \
+        _convert_block(Xs, Rffts, d, dstride, np, i/BLK_SZ); \
+ \
+        ulong jstart = (i < ti_start) ? ti_start - i : 0; \
+        ulong jstop = FLINT_MIN(BLK_SZ, ti_stop - i); \
+        for (ulong j = jstart; j < jstop; j += 1) \
+        { \
+            ulong r[N]; \
+            ulong t[N]; \
+            ulong l = 0; \
+ \
+            CAT3(_big_mul, N, M)(r, t, _crt_data_co_prime(Rcrts + np - 1, l, n), Xs[l*BLK_SZ + j]); \
+            for (l++; l < np; l++) \
+                CAT3(_big_addmul, N, M)(r, t, _crt_data_co_prime(Rcrts + np - 1, l, n), Xs[l*BLK_SZ + j]); \
+ \
+            CAT(_reduce_big_sum, N)(r, t, crt_data_prod_primes(Rcrts + np - 1)); \
+ \
+            if (m == 0) \
+                flint_mpn_zero(acc, Z->accn); \
+ \
+            _acc_add(acc, Z->accn, r, N, m*Z->s); \
+ \
+            if (++m == K) \
+            { \
+                _acc_reduce(z + zi - zl, acc, tmp, Z); \
+                zi++; \
+                m = 0; \
+            } \
+        } \
+    } \
+ \
+    flint_free(acc); \
+}
+
+DEFINE_IT(2, 2, 1)
+DEFINE_IT(3, 3, 2)
+DEFINE_IT(4, 4, 3)
+DEFINE_IT(5, 4, 4)
+DEFINE_IT(6, 5, 4)
+DEFINE_IT(7, 6, 5)
+DEFINE_IT(8, 7, 6)
+#undef DEFINE_IT
+
+typedef struct {
+    ulong np;
+    ulong start_pi;
+    ulong stop_pi;
+    double* abuf;
+    double* bbuf;
+    ulong depth;
+    ulong stride;
+    ulong atrunc;
+    ulong btrunc;
+    ulong ztrunc;
+    const ulong * a;
+    ulong an;
+    const ulong * b;
+    ulong bn;
+    const _red_struct * Z;
+    sd_fft_ctx_struct* ffts;
+    crt_data_struct* crts;
+    int squaring;
+} s1worker_struct;
+
+static void s1worker_func(void* varg)
+{
+    s1worker_struct* X = (s1worker_struct*) varg;
+    sd_fft_lctx_t Q;
+    ulong i, m;
+
+    for (i = X->start_pi; i < X->stop_pi; i++)
+    {
+        double* abuf = X->abuf + X->stride*i;
+        double* bbuf = X->bbuf;
+
+        sd_fft_lctx_init(Q, X->ffts + i, X->depth);
+
+        _mod(abuf, X->atrunc, X->a, X->an, X->Z, X->ffts + i);
+        sd_fft_lctx_fft_trunc(Q, abuf, X->depth, X->atrunc, X->ztrunc);
+
+        if (!X->squaring)
+        {
+            _mod(bbuf, X->btrunc, X->b, X->bn, X->Z, X->ffts + i);
+            sd_fft_lctx_fft_trunc(Q, bbuf, X->depth, X->btrunc, X->ztrunc);
+        }
+
+        ulong cop = *crt_data_co_prime_red(X->crts + X->np - 1, i);
+        NMOD_RED2(m, cop >> (FLINT_BITS - X->depth), cop << X->depth, X->ffts[i].mod);
+        m = nmod_inv(m, X->ffts[i].mod);
+
+        if (X->squaring)
+            sd_fft_lctx_point_sqr(Q, abuf, m, X->depth);
+        else
+            sd_fft_lctx_point_mul(Q, abuf, bbuf, m, X->depth);
+
+        sd_fft_lctx_ifft_trunc(Q, abuf, X->depth, X->ztrunc);
+
+        sd_fft_lctx_clear(Q, X->ffts + i);
+    }
+}
+
+typedef struct {
+    fmpz * z;
+    ulong zl;
+    ulong start_zi;
+    ulong stop_zi;
+    double* buf;
+    ulong stride;
+    sd_fft_ctx_struct* ffts;
+    crt_data_struct* crts;
+    const _red_struct * Z;
+    void (*f)(
+        fmpz * z, ulong zl, ulong zi_start, ulong zi_stop,
+        sd_fft_ctx_struct* Rffts, double* d, ulong dstride,
+        crt_data_struct* Rcrts, const _red_struct * Z);
+} s2worker_struct;
+
+static void s2worker_func(void* varg)
+{
+    s2worker_struct* X = (s2worker_struct*) varg;
+
+    X->f(X->z, X->zl, X->start_zi, X->stop_zi, X->ffts, X->buf,
+         X->stride, X->crts, X->Z);
+}
+
+int _fmpz_mod_poly_mul_mid_mpn_ctx(
+    fmpz * z, ulong zl, ulong zh,
+    const fmpz * a, ulong an,
+    const fmpz * b, ulong bn,
+    const fmpz_t mod,
+    mpn_ctx_t R)
+{
+    ulong zn = an + bn - 1;
+    ulong nbits, bmin, cost, best_cost;
+    ulong k, s, np, best_np;
+    ulong atrunc, btrunc, ztrunc;
+    ulong i, depth, stride;
+    ulong * apack, * bpack;
+    ulong * dnorm;
+    double* buf;
+    int squaring;
+    _red_struct Z[1];
+
+    FLINT_ASSERT(an > 0);
+    FLINT_ASSERT(bn > 0);
+    FLINT_ASSERT(fmpz_size(mod) >= 2);
+
+    if (zl >= zh)
+        return 1;
+
+    nbits = fmpz_bits(mod);
+    bmin = FLINT_MIN(an, bn);
+
+    /* pick the splitting minimising the number of transformed coefficients */
+    best_cost = 0;
+    best_np = 0;
+    Z->k = 0;
+    for (k = 1; k <= MAX_CHUNKS; k++)
+    {
+        s = (nbits + k - 1) / k;
+
+        for (np = 2; np <= MPN_CTX_NCRTS; np++)
+        {
+            if (flint_mpn_cmp_ui_2exp(crt_data_prod_primes(R->crts + np - 1),
+                        R->crts[np - 1].coeff_len, k*bmin, 2*s) >= 0)
+                break;
+        }
+
+        if (np > MPN_CTX_NCRTS)
+            continue;
+
+        cost = np*(2*k - 1);
+
+        if (best_cost == 0 || cost < best_cost)
+        {
+            best_cost = cost;
+            best_np = np;
+            Z->k = k;
+        }
+    }
+
+    if (best_cost == 0)
+        return 0;
+
+    if (zh > zn)
+    {
+        if (zl >= zn)
+        {
+            _fmpz_vec_zero(z, zh - zl);
+            return 1;
+        }
+
+        _fmpz_vec_zero(z + zn - zl, zh - zn);
+        zh = zn;
+    }
+
+    np = best_np;
+    squaring = (a == b) && (an == bn);
+
+    Z->K = 2*Z->k - 1;
+    Z->s = (nbits + Z->k - 1) / Z->k;
+    Z->L = (Z->s + FLINT_BITS - 1) / FLINT_BITS;
+    Z->nn = fmpz_size(mod);
+    Z->accn = (Z->s*(Z->K - 1)) / FLINT_BITS + R->crts[np - 1].coeff_len + 2;
+    Z->accn = FLINT_MAX(Z->accn, 2*Z->nn);
+
+    dnorm = flint_malloc(2*Z->nn*sizeof(ulong));
+    Z->dnorm = dnorm;
+    Z->dinv = dnorm + Z->nn;
+    Z->norm = flint_clz(COEFF_TO_PTR(*mod)->_mp_d[Z->nn - 1]);
+    if (Z->norm != 0)
+        mpn_lshift(Z->dnorm, COEFF_TO_PTR(*mod)->_mp_d, Z->nn, Z->norm);
+    else
+        flint_mpn_copyi(Z->dnorm, COEFF_TO_PTR(*mod)->_mp_d, Z->nn);
+    flint_mpn_preinvn(Z->dinv, Z->dnorm, Z->nn);
+
+    apack = flint_malloc(an*Z->k*Z->L*sizeof(ulong));
+    _split(apack, a, an, Z);
+
+    if (squaring)
+    {
+        bpack = apack;
+    }
+    else
+    {
+        bpack = flint_malloc(bn*Z->k*Z->L*sizeof(ulong));
+        _split(bpack, b, bn, Z);
+    }
+
+    atrunc = n_round_up((an - 1)*Z->K + Z->k, BLK_SZ);
+    btrunc = n_round_up((bn - 1)*Z->K + Z->k, BLK_SZ);
+    ztrunc = n_round_up(zn*Z->K, BLK_SZ);
+    depth = n_max(LG_BLK_SZ, n_clog2(ztrunc));
+
+    stride = n_round_up(sd_fft_ctx_data_size(depth), 128);
+
+    ulong want_threads;
+
+    if (bmin*Z->K >= 1000)
+        want_threads = np;
+    else
+        want_threads = 1;
+
+    thread_pool_handle* handles;
+    slong nworkers = flint_request_threads(&handles, want_threads);
+    ulong nthreads = nworkers + 1;
+
+    buf = (double*) mpn_ctx_fit_buffer(R, (np+nthreads)*stride*sizeof(double));
+
+    s1worker_struct s1args[8];
+    FLINT_ASSERT(nthreads <= 8);
+    for (i = 0; i < nthreads; i++)
+    {
+        s1worker_struct* X = s1args + i;
+        X->np = np;
+        X->start_pi = (i+0)*np/nthreads;
+        X->stop_pi  = (i+1)*np/nthreads;
+        X->abuf = buf;
+        X->bbuf = buf + (np+i)*stride;
+        X->depth = depth;
+        X->stride = stride;
+        X->atrunc = atrunc;
+        X->btrunc = btrunc;
+        X->ztrunc = ztrunc;
+        X->a = apack;
+        X->an = an;
+        X->b = bpack;
+        X->bn = bn;
+        X->Z = Z;
+        X->ffts = R->ffts;
+        X->crts = R->crts;
+        X->squaring = squaring;
+    }
+
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wake(global_thread_pool, handles[i - 1], 0, s1worker_func, s1args + i);
+    s1worker_func(s1args + 0);
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wait(global_thread_pool, handles[i - 1]);
+
+    if ((zh - zl)*Z->K > 800)
+    {
+        flint_give_back_threads(handles, nworkers);
+        nworkers = flint_request_threads(&handles,
+                         ztrunc > 1000000 ? MPN_CTX_MAX_THREADS : 8);
+        nthreads = nworkers + 1;
+    }
+
+    s2worker_struct s2args[MPN_CTX_MAX_THREADS];
+    FLINT_ASSERT(nthreads <= MPN_CTX_MAX_THREADS);
+
+    ulong o = zl;
+    for (i = 0; i < nthreads; i++)
+    {
+        s2worker_struct* X = s2args + i;
+        X->z = z;
+        X->zl = zl;
+        X->start_zi = o;
+        o = i+1 < nthreads ? zl + (i+1)*(zh-zl)/nthreads : zh;
+        X->stop_zi = o;
+        X->buf = buf;
+        X->stride = stride;
+        X->ffts = R->ffts;
+        X->crts = R->crts;
+        X->Z = Z;
+        X->f =  np == 2 ? _crt_2 :
+                np == 3 ? _crt_3 :
+                np == 4 ? _crt_4 :
+                np == 5 ? _crt_5 :
+                np == 6 ? _crt_6 :
+                np == 7 ? _crt_7 :
+                          _crt_8;
+    }
+
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wake(global_thread_pool, handles[i - 1], 0, s2worker_func, s2args + i);
+    s2worker_func(s2args + 0);
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wait(global_thread_pool, handles[i - 1]);
+
+    flint_give_back_threads(handles, nworkers);
+
+    flint_free(apack);
+    if (!squaring)
+        flint_free(bpack);
+    flint_free(dnorm);
+
+    return 1;
+}
@@ -563,12 +563,13 @@ int _fmpz_poly_mul_mid_mpn_ctx(
     if (zn > 50000 || (np >= 2 && zn > 20000) || (np >= 4 && zn > 800))
     {
         flint_give_back_threads(handles, nworkers);
-        nworkers = flint_request_threads(&handles, 8);
+        nworkers = flint_request_threads(&handles,
+                                 zn > 1000000 ? MPN_CTX_MAX_THREADS : 8);
         nthreads = nworkers + 1;
     }
 
-    s2worker_struct s2args[8];
-    FLINT_ASSERT(nthreads <= 8);
+    s2worker_struct s2args[MPN_CTX_MAX_THREADS];
+    FLINT_ASSERT(nthreads <= MPN_CTX_MAX_THREADS);
 
     ulong o = zl;
     for (i = 0; i < nthreads; i++)
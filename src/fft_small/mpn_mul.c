@@ -1053,6 +1053,8 @@ static void mpn_ctx_best_profile(
         thread_limit = 6;
     else if (zn < 32768)
         thread_limit = 7;
+    else if (zn >= 1048576)
+        thread_limit = MPN_CTX_MAX_THREADS;
 
     P->nhandles = flint_request_threads(&P->handles, thread_limit);
     P->nthreads = 1 + P->nhandles;
@@ -1089,7 +1091,12 @@ got_one:
 
     ulong np = R->profiles[i].np;
 
-    if (np % P->nthreads != 0)
+    /*
+        Up to 8 threads the primes should be evenly distributed. With more
+        threads every prime has its own thread(s) in the fft phase and the
+        remaining phases are split by coefficient range anyway.
+    */
+    if (P->nthreads <= 8 && np % P->nthreads != 0)
         goto find_next;
 
     ulong bits = R->profiles[i].bits;
@@ -1274,6 +1281,40 @@ void fft_worker_func(void* varg)
     } while (X = X->next, X != NULL);
 }
 
+/*
+    When there are at least twice as many threads as primes, the forward
+    transforms of a and b are done in parallel by fft_fwd_worker_func, and
+    then the pointwise products and inverse transforms by
+    fft_mul_ifft_worker_func.
+*/
+void fft_fwd_worker_func(void* varg)
+{
+    fft_worker_struct* X = (fft_worker_struct*) varg;
+    sd_fft_lctx_t Q;
+
+    do {
+        sd_fft_lctx_init(Q, X->fctx, X->depth);
+        sd_fft_lctx_fft_trunc(Q, X->abuf, X->depth, X->atrunc, X->ztrunc);
+        sd_fft_lctx_clear(Q, X->fctx);
+    } while (X = X->next, X != NULL);
+}
+
+void fft_mul_ifft_worker_func(void* varg)
+{
+    fft_worker_struct* X = (fft_worker_struct*) varg;
+    sd_fft_lctx_t Q;
+    ulong m;
+
+    do {
+        sd_fft_lctx_init(Q, X->fctx, X->depth);
+        NMOD_RED2(m, X->cop >> (64 - X->depth), X->cop << X->depth, X->fctx->mod);
+        m = nmod_inv(m, X->fctx->mod);
+        sd_fft_lctx_point_mul(Q, X->abuf, X->bbuf, m, X->depth);
+        sd_fft_lctx_ifft_trunc(Q, X->abuf, X->depth, X->ztrunc);
+        sd_fft_lctx_clear(Q, X->fctx);
+    } while (X = X->next, X != NULL);
+}
+
 typedef struct mod_fft_worker_struct {
     ulong bits;
     sd_fft_ctx_struct* fctx;
@@ -1361,7 +1402,7 @@ void mpn_ctx_mpn_mul(mpn_ctx_t R, ulong* z, const ulong* a, ulong an, const ulon
     mpn_ctx_best_profile(R, &P, an, bn);
 
     sz =           sizeof(mod_worker_struct)*P.nthreads;
-    sz = n_max(sz, sizeof(fft_worker_struct)*P.np);
+    sz = n_max(sz, sizeof(fft_worker_struct)*2*P.np);
     sz = n_max(sz, sizeof(mod_fft_worker_struct)*P.np);
     sz = n_max(sz, sizeof(crt_worker_struct)*P.nthreads);
     worker_struct_buffer = flint_malloc(sz);
@@ -1485,28 +1526,79 @@ timeit_start(timer);
 
         wf = (fft_worker_struct*) worker_struct_buffer;
 
-        for (ulong l = 0; l < P.np; l++)
+        if (!squaring && nthreads >= 2*P.np)
         {
-            fft_worker_struct* X = wf + l;
-            X->fctx = R->ffts + l;
-            X->cop = *crt_data_co_prime_red(R->crts + P.np - 1, l);
-            X->depth = depth;
-            X->ztrunc = ztrunc;
-            X->abuf = abuf + l*stride;
-            X->atrunc = atrunc;
-            X->bbuf = bbuf + l*stride;
-            X->btrunc = btrunc;
-            X->next = (l + nthreads < P.np) ? X + nthreads : NULL;
-            X->squaring = squaring;
+            ulong njobs = 2*P.np;
+
+            /* the tables must not be extended concurrently */
+            for (ulong l = 0; l < P.np; l++)
+                sd_fft_ctx_fit_depth(R->ffts + l, depth);
+
+            /* job 2*l transforms a mod p_l and job 2*l + 1 transforms b */
+            for (ulong l = 0; l < njobs; l++)
+            {
+                fft_worker_struct* X = wf + l;
+                X->fctx = R->ffts + l/2;
+                X->depth = depth;
+                X->ztrunc = ztrunc;
+                X->abuf = ((l%2 == 0) ? abuf : bbuf) + (l/2)*stride;
+                X->atrunc = (l%2 == 0) ? atrunc : btrunc;
+                X->next = NULL;
+            }
+
+            for (ulong i = njobs - 1; i > 0; i--)
+                thread_pool_wake(global_thread_pool, P.handles[i - 1], 0,
+                                                  fft_fwd_worker_func, wf + i);
+            fft_fwd_worker_func(wf + 0);
+
+            for (ulong i = njobs - 1; i > 0; i--)
+                thread_pool_wait(global_thread_pool, P.handles[i - 1]);
+
+            for (ulong l = 0; l < P.np; l++)
+            {
+                fft_worker_struct* X = wf + l;
+                X->fctx = R->ffts + l;
+                X->cop = *crt_data_co_prime_red(R->crts + P.np - 1, l);
+                X->depth = depth;
+                X->ztrunc = ztrunc;
+                X->abuf = abuf + l*stride;
+                X->bbuf = bbuf + l*stride;
+                X->next = NULL;
+            }
+
+            for (ulong i = P.np - 1; i > 0; i--)
+                thread_pool_wake(global_thread_pool, P.handles[i - 1], 0,
+                                             fft_mul_ifft_worker_func, wf + i);
+            fft_mul_ifft_worker_func(wf + 0);
+
+            for (ulong i = P.np - 1; i > 0; i--)
+                thread_pool_wait(global_thread_pool, P.handles[i - 1]);
         }
+        else
+        {
+            for (ulong l = 0; l < P.np; l++)
+            {
+                fft_worker_struct* X = wf + l;
+                X->fctx = R->ffts + l;
+                X->cop = *crt_data_co_prime_red(R->crts + P.np - 1, l);
+                X->depth = depth;
+                X->ztrunc = ztrunc;
+                X->abuf = abuf + l*stride;
+                X->atrunc = atrunc;
+                X->bbuf = bbuf + l*stride;
+                X->btrunc = btrunc;
+                X->next = (l + nthreads < P.np) ? X + nthreads : NULL;
+                X->squaring = squaring;
+            }
 
-        for (ulong i = n_min(P.nhandles, P.np - 1); i > 0; i--)
-            thread_pool_wake(global_thread_pool, P.handles[i - 1], 0,
+            for (ulong i = n_min(P.nhandles, P.np - 1); i > 0; i--)
+                thread_pool_wake(global_thread_pool, P.handles[i - 1], 0,
                                                       fft_worker_func, wf + i);
-        fft_worker_func(wf + 0);
+            fft_worker_func(wf + 0);
 
-        for (ulong i = n_min(P.nhandles, P.np - 1); i > 0; i--)
-            thread_pool_wait(global_thread_pool, P.handles[i - 1]);
+            for (ulong i = n_min(P.nhandles, P.np - 1); i > 0; i--)
+                thread_pool_wait(global_thread_pool, P.handles[i - 1]);
+        }
 
 #if TIME_THIS
 timeit_stop(timer);
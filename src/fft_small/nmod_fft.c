@@ -0,0 +1,358 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "fft_small.h"
+
+/*
+    A thin public layer over sd_fft. Buffers hold max(2^depth, BLK_SZ)
+    doubles in the blocked layout of sd_fft_ctx_data_size. Coefficients are
+    stored at sd_fft_ctx_set_index positions and transformed values at
+    sd_fft_ctx_get_fft_index positions. Transforms shorter than a block
+    are not supported by sd_fft and are done by a quadratic basecase that
+    uses the same layout.
+*/
+
+FLINT_FORCE_INLINE ulong _nmod_fft_pos(ulong i)
+{
+    ulong j = i&(BLK_SZ-16);
+    j |= (i&3)<<2;
+    j |= ((i>>2)&3);
+    return sd_fft_ctx_blk_offset(i/BLK_SZ) + j;
+}
+
+FLINT_FORCE_INLINE ulong _nmod_fft_get(double x, const nmod_fft_ctx_t F)
+{
+    return (ulong) vec1d_reduce_to_0n(x, F->ffts->p, F->ffts->pinv);
+}
+
+FLINT_FORCE_INLINE ulong _nmod_fft_round_trunc(ulong trunc, const nmod_fft_ctx_t F)
+{
+    trunc = n_round_up(n_max(trunc, 1), F->blk_sz);
+    return n_min(trunc, n_pow2(F->depth));
+}
+
+static ulong _nmod_fft_buf_size(const nmod_fft_ctx_t F)
+{
+    return sd_fft_ctx_data_size(n_max(F->depth, LG_BLK_SZ));
+}
+
+/*
+    Powers psi^i and psi^-i / 2^depth of a primitive 2^(depth+1)-th root of
+    unity psi, for the negacyclic transforms. They are computed here rather
+    than on first use so that a context can be shared between threads.
+*/
+static void _nmod_fft_ctx_init_twist(nmod_fft_ctx_t F)
+{
+    ulong i, N, psi, psiinv, t, u;
+    nmod_t mod = F->ffts->mod;
+
+    N = n_pow2(F->depth);
+    psi = nmod_pow_ui(F->ffts->primitive_root, (mod.n - 1) >> (F->depth + 1), mod);
+    psiinv = nmod_inv(psi, mod);
+
+    F->twist = nmod_fft_buf_init(F);
+    F->untwist = nmod_fft_buf_init(F);
+    nmod_fft_buf_set_nmod_vec(F->twist, NULL, 0, F);
+    nmod_fft_buf_set_nmod_vec(F->untwist, NULL, 0, F);
+
+    t = 1;
+    u = F->Ninv;
+    for (i = 0; i < N; i++)
+    {
+        sd_fft_ctx_set_index(F->twist, i, (double) t);
+        sd_fft_ctx_set_index(F->untwist, i, (double) u);
+        t = nmod_mul(t, psi, mod);
+        u = nmod_mul(u, psiinv, mod);
+    }
+}
+
+void nmod_fft_ctx_init(nmod_fft_ctx_t F, ulong p, ulong depth)
+{
+    if (p < 3 || p >= n_pow2(50) || depth > 48 ||
+        ((p - 1) & (n_pow2(depth) - 1)) != 0 || !n_is_prime(p))
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_fft_ctx_init). "
+            "Need a prime p < 2^50 with 2^depth dividing p - 1.\n");
+    }
+
+    sd_fft_ctx_init_prime(F->ffts, p);
+    sd_fft_ctx_fit_depth(F->ffts, n_max(depth, LG_BLK_SZ));
+
+    F->depth = depth;
+    F->blk_sz = n_min(n_pow2(depth), BLK_SZ);
+    F->Ninv = nmod_inv(nmod_pow_ui(2, depth, F->ffts->mod), F->ffts->mod);
+    F->twist = NULL;
+    F->untwist = NULL;
+
+    if (((p - 1) & (n_pow2(depth + 1) - 1)) == 0)
+        _nmod_fft_ctx_init_twist(F);
+}
+
+void nmod_fft_ctx_clear(nmod_fft_ctx_t F)
+{
+    if (F->twist != NULL)
+    {
+        nmod_fft_buf_clear(F->twist);
+        nmod_fft_buf_clear(F->untwist);
+    }
+
+    sd_fft_ctx_clear(F->ffts);
+}
+
+ulong nmod_fft_ctx_point(const nmod_fft_ctx_t F, ulong i)
+{
+    FLINT_ASSERT(i < n_pow2(F->depth));
+    return _nmod_fft_get(sd_fft_ctx_w(F->ffts, i), F);
+}
+
+double* nmod_fft_buf_init(const nmod_fft_ctx_t F)
+{
+    return (double*) flint_aligned_alloc(32,
+                                   _nmod_fft_buf_size(F)*sizeof(double));
+}
+
+void nmod_fft_buf_clear(double* d)
+{
+    flint_aligned_free(d);
+}
+
+void nmod_fft_buf_set_nmod_vec(double* d, const ulong* a, ulong an,
+                                                   const nmod_fft_ctx_t F)
+{
+    ulong i, N = n_max(n_pow2(F->depth), BLK_SZ);
+
+    FLINT_ASSERT(an <= n_pow2(F->depth));
+
+    for (i = 0; i < an; i++)
+        sd_fft_ctx_set_index(d, i, (double) a[i]);
+
+    for ( ; i < N; i++)
+        sd_fft_ctx_set_index(d, i, 0);
+}
+
+void nmod_fft_buf_get_nmod_vec(ulong* a, const double* d, ulong an,
+                                                   const nmod_fft_ctx_t F)
+{
+    ulong i;
+
+    FLINT_ASSERT(an <= n_pow2(F->depth));
+
+    for (i = 0; i < an; i++)
+        a[i] = _nmod_fft_get(d[sd_fft_ctx_blk_offset(i/BLK_SZ) + i%BLK_SZ], F);
+}
+
+void nmod_fft_buf_set_transform(double* d, const ulong* a, ulong an,
+                                                   const nmod_fft_ctx_t F)
+{
+    ulong i;
+
+    FLINT_ASSERT(an <= n_pow2(F->depth));
+
+    for (i = 0; i < an; i++)
+        d[_nmod_fft_pos(i)] = (double) a[i];
+}
+
+void nmod_fft_buf_get_transform(ulong* a, const double* d, ulong an,
+                                                   const nmod_fft_ctx_t F)
+{
+    ulong i;
+
+    FLINT_ASSERT(an <= n_pow2(F->depth));
+
+    for (i = 0; i < an; i++)
+        a[i] = _nmod_fft_get(d[_nmod_fft_pos(i)], F);
+}
+
+/* transforms of length < BLK_SZ: evaluation and interpolation at the points */
+static void _nmod_fft_basecase(double* d, const nmod_fft_ctx_t F)
+{
+    ulong a[BLK_SZ/2];
+    ulong i, j, s, w, N = n_pow2(F->depth);
+    nmod_t mod = F->ffts->mod;
+
+    for (j = 0; j < N; j++)
+        a[j] = _nmod_fft_get(d[j], F);
+
+    for (i = 0; i < N; i++)
+    {
+        w = nmod_fft_ctx_point(F, i);
+        s = a[N - 1];
+        for (j = N - 1; j > 0; j--)
+            s = nmod_add(nmod_mul(s, w, mod), a[j - 1], mod);
+        d[_nmod_fft_pos(i)] = (double) s;
+    }
+}
+
+/* output 2^depth times the coefficients */
+static void _nmod_ifft_basecase(double* d, const nmod_fft_ctx_t F)
+{
+    ulong y[BLK_SZ/2], r[BLK_SZ/2];
+    ulong i, j, t, w, N = n_pow2(F->depth);
+    nmod_t mod = F->ffts->mod;
+
+    for (i = 0; i < N; i++)
+    {
+        y[i] = _nmod_fft_get(d[_nmod_fft_pos(i)], F);
+        r[i] = 0;
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        w = nmod_inv(nmod_fft_ctx_point(F, i), mod);
+        t = y[i];
+        for (j = 0; j < N; j++)
+        {
+            r[j] = nmod_add(r[j], t, mod);
+            t = nmod_mul(t, w, mod);
+        }
+    }
+
+    for (j = 0; j < N; j++)
+        d[j] = (double) r[j];
+}
+
+/* multiply the first nblocks blocks by c */
+static void _nmod_fft_buf_scale(double* d, ulong nblocks, ulong c,
+                                                   const nmod_fft_ctx_t F)
+{
+    vec8d m = vec8d_set_d(vec1d_reduce_0n_to_pmhn(c, F->ffts->p));
+    vec8d n = vec8d_set_d(F->ffts->p);
+    vec8d ninv = vec8d_set_d(F->ffts->pinv);
+    ulong I, j;
+
+    for (I = 0; I < nblocks; I++)
+    {
+        double* dI = sd_fft_ctx_blk_index(d, I);
+        for (j = 0; j < BLK_SZ; j += 8)
+            vec8d_store(dI + j, vec8d_mulmod(vec8d_load(dI + j), m, n, ninv));
+    }
+}
+
+static void _nmod_fft_inverse_trunc_noscale(double* d, ulong trunc,
+                                                        nmod_fft_ctx_t F)
+{
+    if (F->depth < LG_BLK_SZ)
+        _nmod_ifft_basecase(d, F);
+    else
+        sd_fft_ctx_ifft_trunc(F->ffts, d, F->depth, trunc);
+}
+
+void nmod_fft_forward_trunc(double* d, ulong itrunc, ulong otrunc,
+                                                        nmod_fft_ctx_t F)
+{
+    if (F->depth < LG_BLK_SZ)
+        _nmod_fft_basecase(d, F);
+    else
+        sd_fft_ctx_fft_trunc(F->ffts, d, F->depth,
+                             _nmod_fft_round_trunc(itrunc, F),
+                             _nmod_fft_round_trunc(otrunc, F));
+}
+
+void nmod_fft_inverse_trunc(double* d, ulong trunc, nmod_fft_ctx_t F)
+{
+    trunc = _nmod_fft_round_trunc(trunc, F);
+    _nmod_fft_inverse_trunc_noscale(d, trunc, F);
+    _nmod_fft_buf_scale(d, n_cdiv(trunc, BLK_SZ), F->Ninv, F);
+}
+
+void nmod_fft_forward(double* d, nmod_fft_ctx_t F)
+{
+    nmod_fft_forward_trunc(d, n_pow2(F->depth), n_pow2(F->depth), F);
+}
+
+void nmod_fft_inverse(double* d, nmod_fft_ctx_t F)
+{
+    nmod_fft_inverse_trunc(d, n_pow2(F->depth), F);
+}
+
+void nmod_fft_mul(double* a, const double* b, nmod_fft_ctx_t F)
+{
+    ulong depth = n_max(F->depth, LG_BLK_SZ);
+    sd_fft_lctx_t Q;
+
+    sd_fft_lctx_init(Q, F->ffts, depth);
+    sd_fft_lctx_point_mul(Q, a, b, 1, depth);
+    sd_fft_lctx_clear(Q, F->ffts);
+}
+
+static void _nmod_fft_check_twist(const nmod_fft_ctx_t F)
+{
+    if (F->twist == NULL)
+        flint_throw(FLINT_ERROR, "Exception (nmod_fft_forward_negacyclic). "
+            "Need 2^(depth+1) dividing p - 1.\n");
+}
+
+void nmod_fft_forward_negacyclic(double* d, nmod_fft_ctx_t F)
+{
+    _nmod_fft_check_twist(F);
+    nmod_fft_mul(d, F->twist, F);
+    nmod_fft_forward(d, F);
+}
+
+void nmod_fft_inverse_negacyclic(double* d, nmod_fft_ctx_t F)
+{
+    _nmod_fft_check_twist(F);
+    _nmod_fft_inverse_trunc_noscale(d, n_pow2(F->depth), F);
+    nmod_fft_mul(d, F->untwist, F);
+}
+
+static void _nmod_fft_mul_wrap(ulong* z, const ulong* a, const ulong* b,
+                                          nmod_fft_ctx_t F, int negacyclic)
+{
+    ulong N = n_pow2(F->depth);
+    double* s = nmod_fft_buf_init(F);
+    double* t = NULL;
+
+    nmod_fft_buf_set_nmod_vec(s, a, N, F);
+
+    if (negacyclic)
+        nmod_fft_forward_negacyclic(s, F);
+    else
+        nmod_fft_forward(s, F);
+
+    if (a == b)
+    {
+        nmod_fft_mul(s, s, F);
+    }
+    else
+    {
+        t = nmod_fft_buf_init(F);
+        nmod_fft_buf_set_nmod_vec(t, b, N, F);
+
+        if (negacyclic)
+            nmod_fft_forward_negacyclic(t, F);
+        else
+            nmod_fft_forward(t, F);
+
+        nmod_fft_mul(s, t, F);
+        nmod_fft_buf_clear(t);
+    }
+
+    if (negacyclic)
+        nmod_fft_inverse_negacyclic(s, F);
+    else
+        nmod_fft_inverse(s, F);
+
+    nmod_fft_buf_get_nmod_vec(z, s, N, F);
+    nmod_fft_buf_clear(s);
+}
+
+void nmod_fft_mul_cyclic(ulong* z, const ulong* a, const ulong* b,
+                                                        nmod_fft_ctx_t F)
+{
+    _nmod_fft_mul_wrap(z, a, b, F, 0);
+}
+
+void nmod_fft_mul_negacyclic(ulong* z, const ulong* a, const ulong* b,
+                                                        nmod_fft_ctx_t F)
+{
+    _nmod_fft_mul_wrap(z, a, b, F, 1);
+}
@@ -1185,20 +1185,17 @@ void _nmod_poly_divrem_mpn_ctx(
     flint_free(t);
 }
 
-void _nmod_poly_divrem_precomp_init(
+/* binv = rev(b)^-1 mod x^Bn, as for the _preinv functions in nmod_poly */
+void _nmod_poly_divrem_precomp_init_preinv(
     nmod_poly_divrem_precomp_struct* M,
     const ulong* b, ulong bn,
-    ulong Bn,
+    const ulong* binv, ulong Bn,
     nmod_t mod,
     mpn_ctx_t R)
 {
     ulong* B = FLINT_ARRAY_ALLOC(Bn, ulong);
-    ulong* t = FLINT_ARRAY_ALLOC(bn, ulong);
-
-    _nmod_poly_reverse(t, b, bn, bn);
-    _nmod_poly_inv_series(B, t, bn, Bn, mod);
-    _nmod_poly_reverse(B, B, Bn, Bn);
 
+    _nmod_poly_reverse(B, binv, Bn, Bn);
 
     _mul_precomp_init(M->quo_maker, B, Bn, Bn, n_max(LG_BLK_SZ, n_clog2(2*Bn-1)), mod, R);
 
@@ -1206,6 +1203,24 @@ void _nmod_poly_divrem_precomp_init(
     ulong N = n_pow2(lgN);
     _mul_precomp_init(M->rem_maker, b, bn, N, lgN, mod, R);
 
+    flint_free(B);
+}
+
+void _nmod_poly_divrem_precomp_init(
+    nmod_poly_divrem_precomp_struct* M,
+    const ulong* b, ulong bn,
+    ulong Bn,
+    nmod_t mod,
+    mpn_ctx_t R)
+{
+    ulong* B = FLINT_ARRAY_ALLOC(Bn, ulong);
+    ulong* t = FLINT_ARRAY_ALLOC(bn, ulong);
+
+    _nmod_poly_reverse(t, b, bn, bn);
+    _nmod_poly_inv_series(B, t, bn, Bn, mod);
+
+    _nmod_poly_divrem_precomp_init_preinv(M, b, bn, B, Bn, mod, R);
+
     flint_free(B);
     flint_free(t);
 }
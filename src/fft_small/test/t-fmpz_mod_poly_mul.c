@@ -0,0 +1,116 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+#include "fft_small.h"
+
+int main(void)
+{
+    mpn_ctx_t R;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("fmpz_mod_poly_mul....");
+    fflush(stdout);
+
+    mpn_ctx_init(R, UWORD(0x0003f00000000001));
+
+    {
+        fmpz * a, * b, * c, * d;
+        fmpz_t n;
+        ulong an, bn, zn, zl, zh, sz, i, reps;
+        int squaring;
+
+        fmpz_init(n);
+
+        for (reps = 0; reps < 300 * flint_test_multiplier(); reps++)
+        {
+            flint_set_num_threads(1 + n_randint(state, 10));
+
+            do {
+                fmpz_randtest_unsigned(n, state, 2*FLINT_BITS + n_randint(state, 2000));
+            } while (fmpz_size(n) < 2);
+
+            squaring = n_randint(state, 4) == 0;
+
+            an = 1 + n_randint(state, 2000);
+            an = 1 + n_randint(state, 1 + an);
+            bn = squaring ? an : 1 + n_randint(state, an);
+            zn = an + bn - 1;
+            zl = n_randint(state, zn+10);
+            zh = n_randint(state, zn+20);
+
+            sz = FLINT_MAX(zl, zh);
+            sz = FLINT_MAX(sz, zn);
+
+            a = _fmpz_vec_init(an);
+            b = _fmpz_vec_init(bn);
+            c = _fmpz_vec_init(sz);
+            d = _fmpz_vec_init(sz);
+
+            for (i = 0; i < an; i++)
+                fmpz_randtest_mod(a + i, state, n);
+            for (i = 0; i < bn; i++)
+                fmpz_randtest_mod(b + i, state, n);
+
+            /* extreme values */
+            if (n_randint(state, 2))
+            {
+                for (i = 0; i < an; i++)
+                    fmpz_sub_ui(a + i, n, 1);
+                for (i = 0; i < bn; i++)
+                    fmpz_sub_ui(b + i, n, 1);
+            }
+
+            if (squaring)
+                _fmpz_vec_set(b, a, an);
+
+            _fmpz_vec_randtest(d, state, sz, 100);
+
+            if (_fmpz_mod_poly_mul_mid_mpn_ctx(d, zl, zh, a, an,
+                                            squaring ? a : b, bn, n, R))
+            {
+                _fmpz_poly_mul(c, a, an, b, bn);
+                _fmpz_vec_scalar_mod_fmpz(c, c, zn, n);
+
+                for (i = zl; i < zh; i++)
+                {
+                    if (!fmpz_equal(c + i, d + i - zl))
+                    {
+                        flint_printf("FAIL: mulmid error at index %wu\n", i);
+                        flint_printf("squaring = %d, bits = %wu\n", squaring, fmpz_bits(n));
+                        flint_printf("zl=%wu, zh=%wu, an=%wu, bn=%wu\n", zl, zh, an, bn);
+                        flint_abort();
+                    }
+                }
+            }
+            else if (fmpz_bits(n) <= 1000)
+            {
+                flint_printf("FAIL: multiplication not done\n");
+                flint_printf("bits = %wu, an=%wu, bn=%wu\n", fmpz_bits(n), an, bn);
+                flint_abort();
+            }
+
+            _fmpz_vec_clear(a, an);
+            _fmpz_vec_clear(b, bn);
+            _fmpz_vec_clear(c, sz);
+            _fmpz_vec_clear(d, sz);
+        }
+
+        fmpz_clear(n);
+    }
+
+    mpn_ctx_clear(R);
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
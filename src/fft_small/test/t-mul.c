@@ -119,6 +119,53 @@ void test_mul(mpn_ctx_t R, ulong minsize, ulong maxsize, ulong nreps, flint_rand
     fflush(stdout);
 }
 
+/* products with zn >= 2^20 limbs may use more threads than primes */
+void test_mul_huge(mpn_ctx_t R, ulong nreps, flint_rand_t state)
+{
+    for (ulong rep = 0; rep < nreps; rep++)
+    {
+        ulong an = 600000 + n_randint(state, 200000);
+        ulong bn = 450000 + n_randint(state, 150000);
+        ulong* a = FLINT_ARRAY_ALLOC(an, ulong);
+        ulong* b = FLINT_ARRAY_ALLOC(bn, ulong);
+        ulong* c = FLINT_ARRAY_ALLOC(2*an, ulong);
+        ulong* d = FLINT_ARRAY_ALLOC(2*an, ulong);
+
+        flint_set_num_threads(8 + n_randint(state, 9));
+
+        for (ulong i = 0; i < an; i++)
+            a[i] = n_randlimb(state);
+        for (ulong i = 0; i < bn; i++)
+            b[i] = n_randlimb(state);
+
+        mpn_ctx_mpn_mul(R, d, a, an, b, bn);
+        mpn_mul(c, a, an, b, bn);
+        if (mpn_cmp(c, d, an + bn) != 0)
+        {
+            flint_printf("\nFAILED (huge)\n");
+            flint_printf("an = %wu, bn = %wu\n", an, bn);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        mpn_ctx_mpn_mul(R, d, a, an, a, an);
+        mpn_sqr(c, a, an);
+        if (mpn_cmp(c, d, 2*an) != 0)
+        {
+            flint_printf("\nFAILED (huge squaring)\n");
+            flint_printf("an = %wu\n", an);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(a);
+        flint_free(b);
+        flint_free(c);
+        flint_free(d);
+    }
+
+    flint_set_num_threads(1);
+}
 
 int main(void)
 {
@@ -131,6 +178,7 @@ int main(void)
         mpn_ctx_t R;
         mpn_ctx_init(R, UWORD(0x0003f00000000001));
         test_mul(R, 10, 50000, 5000, state);
+        test_mul_huge(R, 2, state);
         mpn_ctx_clear(R);
     }
 
@@ -0,0 +1,210 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "fft_small.h"
+
+/* random prime p < 2^50 with 2^(depth+1) | p - 1 */
+static ulong
+_random_fft_prime(flint_rand_t state, ulong depth)
+{
+    ulong p;
+
+    do {
+        p = (1 + n_randint(state, n_pow2(48 - depth))) * n_pow2(depth + 1) + 1;
+    } while (!n_is_prime(p));
+
+    return p;
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nmod_fft....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 200 * flint_test_multiplier(); iter++)
+    {
+        nmod_fft_ctx_t F;
+        nmod_t mod;
+        nmod_poly_t A, B, C;
+        ulong depth, N, p, i, k, an, itrunc, otrunc;
+        ulong * a, * b, * c;
+        double * d, * e;
+
+        depth = n_randint(state, 14);
+        N = n_pow2(depth);
+        p = _random_fft_prime(state, depth);
+        nmod_init(&mod, p);
+
+        nmod_fft_ctx_init(F, p, depth);
+        d = nmod_fft_buf_init(F);
+        e = nmod_fft_buf_init(F);
+        a = _nmod_vec_init(N);
+        b = _nmod_vec_init(N);
+        c = _nmod_vec_init(N);
+        nmod_poly_init(A, p);
+        nmod_poly_init(B, p);
+        nmod_poly_init(C, p);
+
+        /* truncated forward transform = evaluation at the points */
+        itrunc = 1 + n_randint(state, N);
+        otrunc = 1 + n_randint(state, N);
+        an = 1 + n_randint(state, itrunc);
+        for (i = 0; i < an; i++)
+            a[i] = n_randint(state, p);
+        nmod_poly_fit_length(A, an);
+        _nmod_vec_set(A->coeffs, a, an);
+        A->length = an;
+        _nmod_poly_normalise(A);
+
+        nmod_fft_buf_set_nmod_vec(d, a, an, F);
+        nmod_fft_forward_trunc(d, itrunc, otrunc, F);
+        nmod_fft_buf_get_transform(b, d, otrunc, F);
+
+        for (k = 0; k < 5; k++)
+        {
+            i = n_randint(state, otrunc);
+            if (b[i] != nmod_poly_evaluate_nmod(A, nmod_fft_ctx_point(F, i)))
+            {
+                flint_printf("FAIL (forward)\n");
+                flint_printf("p = %wu, depth = %wu, i = %wu\n", p, depth, i);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        /* truncated inverse undoes the truncated forward */
+        itrunc = 1 + n_randint(state, N);
+        for (i = 0; i < itrunc; i++)
+            a[i] = n_randint(state, p);
+
+        nmod_fft_buf_set_nmod_vec(d, a, itrunc, F);
+        nmod_fft_forward_trunc(d, itrunc, itrunc, F);
+        nmod_fft_inverse_trunc(d, itrunc, F);
+        nmod_fft_buf_get_nmod_vec(b, d, itrunc, F);
+
+        if (!_nmod_vec_equal(a, b, itrunc))
+        {
+            flint_printf("FAIL (inverse_trunc)\n");
+            flint_printf("p = %wu, depth = %wu, trunc = %wu\n", p, depth, itrunc);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* interpolation from values in transform order */
+        for (i = 0; i < N; i++)
+            a[i] = n_randint(state, p);
+
+        nmod_fft_buf_set_transform(d, a, N, F);
+        nmod_fft_inverse(d, F);
+        nmod_fft_forward(d, F);
+        nmod_fft_buf_get_transform(b, d, N, F);
+
+        if (!_nmod_vec_equal(a, b, N))
+        {
+            flint_printf("FAIL (set_transform)\n");
+            flint_printf("p = %wu, depth = %wu\n", p, depth);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* cyclic and negacyclic products */
+        for (i = 0; i < N; i++)
+        {
+            a[i] = n_randint(state, p);
+            b[i] = n_randint(state, p);
+        }
+
+        nmod_poly_fit_length(A, N);
+        nmod_poly_fit_length(B, N);
+        _nmod_vec_set(A->coeffs, a, N);
+        _nmod_vec_set(B->coeffs, b, N);
+        A->length = B->length = N;
+        _nmod_poly_normalise(A);
+        _nmod_poly_normalise(B);
+        nmod_poly_mul(C, A, B);
+
+        for (k = 0; k < 2; k++)
+        {
+            if (k == 0)
+                nmod_fft_mul_cyclic(c, a, b, F);
+            else
+                nmod_fft_mul_negacyclic(c, a, b, F);
+
+            for (i = N; i < (ulong) C->length; i++)
+            {
+                if (k == 0)
+                    C->coeffs[i - N] = nmod_add(C->coeffs[i - N], C->coeffs[i], mod);
+                else
+                    C->coeffs[i - N] = nmod_sub(C->coeffs[i - N], C->coeffs[i], mod);
+            }
+
+            for (i = 0; i < N; i++)
+            {
+                if (c[i] != nmod_poly_get_coeff_ui(C, i))
+                {
+                    flint_printf("FAIL (%s)\n", k == 0 ? "cyclic" : "negacyclic");
+                    flint_printf("p = %wu, depth = %wu, i = %wu\n", p, depth, i);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+
+            nmod_poly_mul(C, A, B);
+        }
+
+        /* a cached transform reused against several operands */
+        nmod_fft_buf_set_nmod_vec(e, b, N, F);
+        nmod_fft_forward_negacyclic(e, F);
+
+        for (k = 0; k < 2; k++)
+        {
+            for (i = 0; i < N; i++)
+                a[i] = n_randint(state, p);
+
+            nmod_fft_buf_set_nmod_vec(d, a, N, F);
+            nmod_fft_forward_negacyclic(d, F);
+            nmod_fft_mul(d, e, F);
+            nmod_fft_inverse_negacyclic(d, F);
+            nmod_fft_buf_get_nmod_vec(c, d, N, F);
+
+            nmod_fft_mul_negacyclic(a, a, b, F);
+
+            if (!_nmod_vec_equal(a, c, N))
+            {
+                flint_printf("FAIL (cached negacyclic)\n");
+                flint_printf("p = %wu, depth = %wu\n", p, depth);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_fft_buf_clear(d);
+        nmod_fft_buf_clear(e);
+        _nmod_vec_clear(a);
+        _nmod_vec_clear(b);
+        _nmod_vec_clear(c);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(C);
+        nmod_fft_ctx_clear(F);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
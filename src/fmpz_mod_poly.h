@@ -33,6 +33,14 @@ extern "C" {
 #define FMPZ_MOD_POLY_INV_NEWTON_CUTOFF  64 /* Inv series newton: Basecase -> Newton */
 #define FMPZ_MOD_POLY_DIV_DIVCONQUER_CUTOFF
 
+/* Mul: Kronecker substitution -> fft_small, for moduli of nlimbs >= 2 limbs.
+   Measured with one thread on x86-64 (AVX2): fft_small is faster from about
+   length 128 for 2-4 limbs, 256 for 5-6 limbs, 2048 for 7-10 limbs and 4096
+   for longer moduli, where the splitting into more primes and chunks makes
+   the crossover irregular. */
+#define FMPZ_MOD_POLY_MUL_FFT_SMALL_CUTOFF(nlimbs) \
+    ((nlimbs) <= 4 ? 128 : (nlimbs) <= 6 ? 256 : (nlimbs) <= 10 ? 2048 : 4096)
+
 /*  Type definitions *********************************************************/
 
 typedef struct
@@ -10,16 +10,31 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "fmpz_mod.h"
 #include "fmpz_mod_vec.h"
 #include "fmpz_mod_poly.h"
 
+#ifdef FLINT_HAVE_FFT_SMALL
+#include "fft_small.h"
+#endif
+
 void _fmpz_mod_poly_mullow(fmpz *res, const fmpz *poly1, slong len1,
                                       const fmpz *poly2, slong len2,
                                       slong n, const fmpz_mod_ctx_t ctx)
 {
+#ifdef FLINT_HAVE_FFT_SMALL
+    slong nlimbs = fmpz_size(fmpz_mod_ctx_modulus(ctx));
+
+    if (nlimbs >= 2 &&
+        FLINT_MIN(len1, len2) >= FMPZ_MOD_POLY_MUL_FFT_SMALL_CUTOFF(nlimbs) &&
+        _fmpz_mod_poly_mul_mid_default_mpn_ctx(res, 0, n,
+                poly1, len1, poly2, len2, fmpz_mod_ctx_modulus(ctx)))
+        return;
+#endif
+
     _fmpz_poly_mullow(res, poly1, len1, poly2, len2, n);
     _fmpz_mod_vec_set_fmpz_vec(res, res, n, ctx);
 }
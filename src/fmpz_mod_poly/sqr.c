@@ -10,14 +10,29 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "fmpz_mod.h"
 #include "fmpz_mod_vec.h"
 #include "fmpz_mod_poly.h"
 
+#ifdef FLINT_HAVE_FFT_SMALL
+#include "fft_small.h"
+#endif
+
 void _fmpz_mod_poly_sqr(fmpz *res, const fmpz *poly, slong len, const fmpz_mod_ctx_t ctx)
 {
+#ifdef FLINT_HAVE_FFT_SMALL
+    slong nlimbs = fmpz_size(fmpz_mod_ctx_modulus(ctx));
+
+    if (nlimbs >= 2 &&
+        len >= FMPZ_MOD_POLY_MUL_FFT_SMALL_CUTOFF(nlimbs) &&
+        _fmpz_mod_poly_mul_mid_default_mpn_ctx(res, 0, 2 * len - 1,
+                poly, len, poly, len, fmpz_mod_ctx_modulus(ctx)))
+        return;
+#endif
+
     _fmpz_poly_sqr(res, poly, len);
     _fmpz_mod_vec_set_fmpz_vec(res, res, 2 * len - 1, ctx);
 }
@@ -12,6 +12,7 @@
 
 #include "fmpz.h"
 #include "fmpz_mod.h"
+#include "fmpz_poly.h"
 #include "fmpz_mod_poly.h"
 
 int
@@ -154,6 +155,119 @@ main(void)
         fmpz_clear(p);
     }
 
+    /* Compare with fmpz_poly multiplication for multi-limb moduli */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        fmpz_mod_poly_t a, b, c;
+        fmpz_poly_t A, B, C;
+        fmpz_t p;
+
+        fmpz_init(p);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+        fmpz_randtest_unsigned(p, state, FLINT_BITS + n_randint(state, 1000));
+        fmpz_add_ui(p, p, 2);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        fmpz_poly_init(A);
+        fmpz_poly_init(B);
+        fmpz_poly_init(C);
+
+        fmpz_mod_poly_randtest(b, state, 1 + n_randint(state, 300), ctx);
+        if (n_randint(state, 4) == 0)
+            fmpz_mod_poly_set(c, b, ctx);
+        else
+            fmpz_mod_poly_randtest(c, state, 1 + n_randint(state, 300), ctx);
+
+        if (fmpz_mod_poly_equal(b, c, ctx))
+            fmpz_mod_poly_sqr(a, b, ctx);
+        else
+            fmpz_mod_poly_mul(a, b, c, ctx);
+
+        fmpz_mod_poly_get_fmpz_poly(B, b, ctx);
+        fmpz_mod_poly_get_fmpz_poly(C, c, ctx);
+        fmpz_poly_mul(A, B, C);
+        fmpz_mod_poly_set_fmpz_poly(c, A, ctx);
+
+        result = (fmpz_mod_poly_equal(a, c, ctx));
+        if (!result)
+        {
+            flint_printf("FAIL (multi-limb modulus):\n");
+            fmpz_print(p), flint_printf("\n\n");
+            fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+            fmpz_mod_poly_print(c, ctx), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_poly_clear(A);
+        fmpz_poly_clear(B);
+        fmpz_poly_clear(C);
+        fmpz_clear(p);
+    }
+
+    /* Lengths above the fft_small cutoff for each modulus size */
+    for (i = 0; i < 2 * flint_test_multiplier(); i++)
+    {
+        fmpz_mod_poly_t a, b, c;
+        fmpz_poly_t A, B, C;
+        fmpz_t p;
+        slong nlimbs, cutoff;
+
+        fmpz_init(p);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+        nlimbs = 2 + n_randint(state, 11);
+        fmpz_randbits(p, state, nlimbs * FLINT_BITS);
+        fmpz_abs(p, p);
+        fmpz_setbit(p, nlimbs * FLINT_BITS - 1);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+        cutoff = FMPZ_MOD_POLY_MUL_FFT_SMALL_CUTOFF(nlimbs);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        fmpz_poly_init(A);
+        fmpz_poly_init(B);
+        fmpz_poly_init(C);
+
+        fmpz_mod_poly_randtest_monic(b, state, cutoff + n_randint(state, cutoff), ctx);
+        fmpz_mod_poly_randtest_monic(c, state, cutoff + n_randint(state, cutoff), ctx);
+
+        fmpz_mod_poly_mul(a, b, c, ctx);
+
+        fmpz_mod_poly_get_fmpz_poly(B, b, ctx);
+        fmpz_mod_poly_get_fmpz_poly(C, c, ctx);
+        fmpz_poly_mul(A, B, C);
+        fmpz_mod_poly_set_fmpz_poly(c, A, ctx);
+
+        result = (fmpz_mod_poly_equal(a, c, ctx));
+        if (!result)
+        {
+            flint_printf("FAIL (long product):\n");
+            fmpz_print(p), flint_printf("\n\n");
+            flint_printf("len1 = %wd, len2 = %wd\n", b->length, C->length);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_poly_clear(A);
+        fmpz_poly_clear(B);
+        fmpz_poly_clear(C);
+        fmpz_clear(p);
+    }
+
+    flint_set_num_threads(1);
+
     fmpz_mod_ctx_clear(ctx);
     FLINT_TEST_CLEANUP(state);
 
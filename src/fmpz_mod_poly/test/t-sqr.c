@@ -0,0 +1,119 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz.h"
+#include "fmpz_mod.h"
+#include "fmpz_poly.h"
+#include "fmpz_mod_poly.h"
+
+int
+main(void)
+{
+    int i, result;
+    fmpz_mod_ctx_t ctx;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("sqr....");
+    fflush(stdout);
+
+    fmpz_mod_ctx_init_ui(ctx, 2);
+
+    /* Check aliasing and compare with mul */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t a, b, c;
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 3 * FLINT_BITS);
+        fmpz_add_ui(p, p, 2);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        fmpz_mod_poly_randtest(b, state, n_randint(state, 50), ctx);
+
+        fmpz_mod_poly_sqr(a, b, ctx);
+        fmpz_mod_poly_mul(c, b, b, ctx);
+        fmpz_mod_poly_sqr(b, b, ctx);
+
+        result = (fmpz_mod_poly_equal(a, b, ctx) && fmpz_mod_poly_equal(a, c, ctx));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+            fmpz_mod_poly_print(b, ctx), flint_printf("\n\n");
+            fmpz_mod_poly_print(c, ctx), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_clear(p);
+    }
+
+    /* Lengths above the fft_small cutoff for each modulus size */
+    for (i = 0; i < 2 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t a, b;
+        fmpz_poly_t A, B;
+        slong nlimbs, cutoff;
+
+        fmpz_init(p);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+        nlimbs = 2 + n_randint(state, 11);
+        fmpz_randbits(p, state, nlimbs * FLINT_BITS);
+        fmpz_abs(p, p);
+        fmpz_setbit(p, nlimbs * FLINT_BITS - 1);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+        cutoff = FMPZ_MOD_POLY_MUL_FFT_SMALL_CUTOFF(nlimbs);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_poly_init(A);
+        fmpz_poly_init(B);
+
+        fmpz_mod_poly_randtest_monic(b, state, cutoff + n_randint(state, cutoff), ctx);
+
+        fmpz_mod_poly_sqr(a, b, ctx);
+
+        fmpz_mod_poly_get_fmpz_poly(B, b, ctx);
+        fmpz_poly_sqr(A, B);
+        fmpz_mod_poly_set_fmpz_poly(b, A, ctx);
+
+        result = (fmpz_mod_poly_equal(a, b, ctx));
+        if (!result)
+        {
+            flint_printf("FAIL (long square):\n");
+            fmpz_print(p), flint_printf("\n\n");
+            flint_printf("len = %wd\n", B->length);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_poly_clear(A);
+        fmpz_poly_clear(B);
+        fmpz_clear(p);
+    }
+
+    flint_set_num_threads(1);
+
+    fmpz_mod_ctx_clear(ctx);
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
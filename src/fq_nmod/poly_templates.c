@@ -78,7 +78,7 @@
 /* #include "fq_poly_templates/mul_reorder.c" */
 #include "fq_poly_templates/mulhigh.c"
 #include "fq_poly_templates/mulhigh_classical.c"
-#include "fq_poly_templates/mullow.c"
+/* #include "fq_poly_templates/mullow.c" */
 #include "fq_poly_templates/mullow_classical.c"
 #include "fq_poly_templates/mullow_KS.c"
 #include "fq_poly_templates/mulmod.c"
@@ -115,7 +115,7 @@
 #include "fq_poly_templates/set_trunc.c"
 #include "fq_poly_templates/shift_left.c"
 #include "fq_poly_templates/shift_right.c"
-#include "fq_poly_templates/sqr.c"
+/* #include "fq_poly_templates/sqr.c" */
 #include "fq_poly_templates/sqr_classical.c"
 #include "fq_poly_templates/sqr_KS.c"
 /* #include "fq_poly_templates/sqr_reorder.c" */
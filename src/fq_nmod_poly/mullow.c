@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2012 Sebastian Pancratz
+    Copyright (C) 2013 Mike Hansen
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fq_nmod.h"
+#include "fq_nmod_poly.h"
+
+/*
+    Above the classical range the product is done as a single nmod_poly
+    multiplication (which uses fft_small when available) instead of
+    packing into an fmpz_poly.
+*/
+void _fq_nmod_poly_mullow(fq_nmod_struct * rop,
+                          const fq_nmod_struct * op1, slong len1,
+                          const fq_nmod_struct * op2, slong len2,
+                          slong n, const fq_nmod_ctx_t ctx)
+{
+    if (n < FQ_NMOD_MULLOW_CLASSICAL_CUTOFF || FLINT_MAX(len1, len2) < 6)
+        _fq_nmod_poly_mullow_classical(rop, op1, len1, op2, len2, n, ctx);
+    else
+        _fq_nmod_poly_mullow_univariate(rop, op1, len1, op2, len2, n, ctx);
+}
+
+void fq_nmod_poly_mullow(fq_nmod_poly_t rop, const fq_nmod_poly_t op1,
+                    const fq_nmod_poly_t op2, slong n, const fq_nmod_ctx_t ctx)
+{
+    const slong len1 = op1->length;
+    const slong len2 = op2->length;
+    const slong lenr = op1->length + op2->length - 1;
+
+    if (len1 == 0 || len2 == 0 || n == 0)
+    {
+        fq_nmod_poly_zero(rop, ctx);
+        return;
+    }
+
+    if (n > lenr)
+        n = lenr;
+
+    if (rop == op1 || rop == op2)
+    {
+        fq_nmod_poly_t t;
+
+        fq_nmod_poly_init2(t, n, ctx);
+        _fq_nmod_poly_mullow(t->coeffs, op1->coeffs, op1->length,
+                                   op2->coeffs, op2->length, n, ctx);
+        fq_nmod_poly_swap(rop, t, ctx);
+        fq_nmod_poly_clear(t, ctx);
+    }
+    else
+    {
+        fq_nmod_poly_fit_length(rop, n, ctx);
+        _fq_nmod_poly_mullow(rop->coeffs, op1->coeffs, op1->length,
+                                   op2->coeffs, op2->length, n, ctx);
+    }
+
+    _fq_nmod_poly_set_length(rop, n, ctx);
+    _fq_nmod_poly_normalise(rop, ctx);
+}
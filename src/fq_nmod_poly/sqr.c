@@ -0,0 +1,53 @@
+/*
+    Copyright (C) 2012 Sebastian Pancratz
+    Copyright (C) 2013 Mike Hansen
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fq_nmod.h"
+#include "fq_nmod_poly.h"
+
+void _fq_nmod_poly_sqr(fq_nmod_struct * rop,
+                       const fq_nmod_struct * op, slong len,
+                       const fq_nmod_ctx_t ctx)
+{
+    if (len < FQ_NMOD_SQR_CLASSICAL_CUTOFF)
+        _fq_nmod_poly_sqr_classical(rop, op, len, ctx);
+    else
+        _fq_nmod_poly_mul_univariate(rop, op, len, op, len, ctx);
+}
+
+void fq_nmod_poly_sqr(fq_nmod_poly_t rop, const fq_nmod_poly_t op,
+                                                     const fq_nmod_ctx_t ctx)
+{
+    const slong rlen = 2 * op->length - 1;
+
+    if (op->length == 0)
+    {
+        fq_nmod_poly_zero(rop, ctx);
+        return;
+    }
+
+    if (rop == op)
+    {
+        fq_nmod_poly_t t;
+
+        fq_nmod_poly_init2(t, rlen, ctx);
+        _fq_nmod_poly_sqr(t->coeffs, op->coeffs, op->length, ctx);
+        fq_nmod_poly_swap(rop, t, ctx);
+        fq_nmod_poly_clear(t, ctx);
+    }
+    else
+    {
+        fq_nmod_poly_fit_length(rop, rlen, ctx);
+        _fq_nmod_poly_sqr(rop->coeffs, op->coeffs, op->length, ctx);
+    }
+
+    _fq_nmod_poly_set_length(rop, rlen, ctx);
+}
@@ -57,6 +57,12 @@ void fq_zech_ctx_randtest_reducible(fq_zech_ctx_t ctx, flint_rand_t state);
 
 void fq_zech_ctx_clear(fq_zech_ctx_t ctx);
 
+int _fq_zech_tables_build(fq_zech_tables_struct * T, const fq_nmod_ctx_t fq_nmod_ctx);
+
+fq_zech_tables_struct * _fq_zech_tables_acquire(const fq_nmod_ctx_t fq_nmod_ctx);
+
+void _fq_zech_tables_release(fq_zech_tables_struct * T);
+
 const nmod_poly_struct * fq_zech_ctx_modulus(const fq_zech_ctx_t ctx);
 
 slong fq_zech_ctx_degree(const fq_zech_ctx_t ctx);
@@ -0,0 +1,283 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "fq_nmod.h"
+#include "fq_zech.h"
+
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+static pthread_mutex_t _fq_zech_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Linked list of the tables currently referenced by some context. */
+static fq_zech_tables_struct * _fq_zech_tables_head = NULL;
+
+/* Below this order the tables are built by a single thread. */
+#define FQ_ZECH_TABLES_PARALLEL_CUTOFF 65536
+
+typedef struct
+{
+    const fq_nmod_ctx_struct * ctx;
+    mp_ptr eval_table;
+    mp_srcptr pw;           /* pw[i] = p^i */
+    mp_limb_t qm1;
+    slong chunk;
+}
+_eval_args_t;
+
+/*
+    Fills eval_table[e] for e in [i * chunk, (i + 1) * chunk), where
+    eval_table[e] is the value at p of the canonical lift of gen^e.
+    Instead of a full multiplication in F_q per step we keep the
+    coefficients of gen^e and multiply by x directly using the sparse
+    representation of the modulus, updating the packed value in O(len).
+*/
+static void
+_fq_zech_eval_worker(slong i, void * _args)
+{
+    _eval_args_t * args = (_eval_args_t *) _args;
+    const fq_nmod_ctx_struct * ctx = args->ctx;
+    slong d = fq_nmod_ctx_degree(ctx);
+    nmod_t mod = ctx->mod;
+    mp_srcptr pw = args->pw;
+    mp_limb_t e, start, end, value, top, c;
+    mp_ptr coeffs;
+    fq_nmod_t r;
+    slong k;
+
+    start = i * args->chunk;
+    end = FLINT_MIN(start + args->chunk, args->qm1);
+
+    if (start >= end)
+        return;
+
+    coeffs = _nmod_vec_init(d);
+    fq_nmod_init(r, ctx);
+    fq_nmod_gen(r, ctx);
+    fq_nmod_pow_ui(r, r, start, ctx);
+
+    value = 0;
+    for (k = 0; k < d; k++)
+    {
+        coeffs[k] = (k < r->length) ? r->coeffs[k] : 0;
+        value += coeffs[k] * pw[k];
+    }
+
+    for (e = start; e < end; e++)
+    {
+        args->eval_table[e] = value;
+
+        /* multiply by x */
+        top = coeffs[d - 1];
+        value = (value - top * pw[d - 1]) * mod.n;
+        for (k = d - 1; k > 0; k--)
+            coeffs[k] = coeffs[k - 1];
+        coeffs[0] = 0;
+
+        if (top != 0)
+        {
+            /* x^d = -sum a[k] x^j[k] */
+            for (k = 0; k < ctx->len - 1; k++)
+            {
+                c = coeffs[ctx->j[k]];
+                coeffs[ctx->j[k]] = nmod_sub(c, nmod_mul(top, ctx->a[k], mod), mod);
+                value = value - c * pw[ctx->j[k]] + coeffs[ctx->j[k]] * pw[ctx->j[k]];
+            }
+        }
+    }
+
+    fq_nmod_clear(r, ctx);
+    _nmod_vec_clear(coeffs);
+}
+
+typedef struct
+{
+    mp_ptr zech_log_table;
+    mp_srcptr reverse_table;
+    mp_limb_t p;
+    mp_limb_t q;
+    slong chunk;
+}
+_zech_args_t;
+
+static void
+_fq_zech_log_worker(slong i, void * _args)
+{
+    _zech_args_t * args = (_zech_args_t *) _args;
+    mp_srcptr rev = args->reverse_table;
+    mp_limb_t n, nz, start, end, up = args->p;
+
+    start = i * args->chunk;
+    end = FLINT_MIN(start + args->chunk, args->q);
+
+    for (n = start; n < end; n++)
+    {
+        /* nz is the value of n + 1, i.e. n with its lowest digit incremented */
+        nz = (n % up == up - 1) ? n - up + 1 : n + 1;
+        args->zech_log_table[rev[n]] = rev[nz];
+    }
+}
+
+int
+_fq_zech_tables_build(fq_zech_tables_struct * T, const fq_nmod_ctx_t fq_nmod_ctx)
+{
+    slong i, d, num_chunks;
+    mp_limb_t q, qm1, up, v;
+    mp_ptr pw, rev;
+    _eval_args_t eval_args;
+    _zech_args_t zech_args;
+
+    d = fq_nmod_ctx_degree(fq_nmod_ctx);
+    up = fq_nmod_ctx->mod.n;
+    q = n_pow(up, d);
+    qm1 = q - 1;
+
+    T->zech_log_table = (mp_limb_t *) flint_malloc(q * sizeof(mp_limb_t));
+    T->prime_field_table = (mp_limb_t *) flint_malloc(up * sizeof(mp_limb_t));
+    T->eval_table = (mp_limb_t *) flint_malloc(q * sizeof(mp_limb_t));
+    rev = (mp_limb_t *) flint_malloc(q * sizeof(mp_limb_t));
+
+    pw = _nmod_vec_init(d + 1);
+    pw[0] = 1;
+    for (i = 1; i <= d; i++)
+        pw[i] = pw[i - 1] * up;
+
+    if (q < FQ_ZECH_TABLES_PARALLEL_CUTOFF)
+        num_chunks = 1;
+    else
+        num_chunks = FLINT_MIN(flint_get_num_threads(), qm1);
+
+    eval_args.ctx = fq_nmod_ctx;
+    eval_args.eval_table = T->eval_table;
+    eval_args.pw = pw;
+    eval_args.qm1 = qm1;
+    eval_args.chunk = (qm1 + num_chunks - 1) / num_chunks;
+
+    flint_parallel_do(_fq_zech_eval_worker, &eval_args, num_chunks, -1, FLINT_PARALLEL_UNIFORM);
+
+    T->eval_table[qm1] = 0;
+    T->prime_field_table[0] = qm1;
+    for (v = 0; v < q; v++)
+        rev[v] = qm1;
+
+    /* the inversion also checks that gen is primitive */
+    for (v = 0; v < qm1; v++)
+    {
+        mp_limb_t r = T->eval_table[v];
+
+        if (rev[r] != qm1)
+        {
+            flint_free(T->zech_log_table);
+            flint_free(T->prime_field_table);
+            flint_free(T->eval_table);
+            flint_free(rev);
+            _nmod_vec_clear(pw);
+            return 0;
+        }
+
+        rev[r] = v;
+
+        if (r < up)
+            T->prime_field_table[r] = v;
+    }
+
+    zech_args.zech_log_table = T->zech_log_table;
+    zech_args.reverse_table = rev;
+    zech_args.p = up;
+    zech_args.q = q;
+    zech_args.chunk = (q + num_chunks - 1) / num_chunks;
+
+    flint_parallel_do(_fq_zech_log_worker, &zech_args, num_chunks, -1, FLINT_PARALLEL_UNIFORM);
+
+    flint_free(rev);
+    _nmod_vec_clear(pw);
+
+    return 1;
+}
+
+fq_zech_tables_struct *
+_fq_zech_tables_acquire(const fq_nmod_ctx_t fq_nmod_ctx)
+{
+    fq_zech_tables_struct * T;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_fq_zech_tables_lock);
+#endif
+
+    for (T = _fq_zech_tables_head; T != NULL; T = T->next)
+    {
+        if (T->modulus->mod.n == fq_nmod_ctx->mod.n &&
+            nmod_poly_equal(T->modulus, fq_nmod_ctx->modulus))
+        {
+            T->refcount++;
+            break;
+        }
+    }
+
+    if (T == NULL)
+    {
+        T = flint_malloc(sizeof(fq_zech_tables_struct));
+
+        if (_fq_zech_tables_build(T, fq_nmod_ctx))
+        {
+            nmod_poly_init_mod(T->modulus, fq_nmod_ctx->mod);
+            nmod_poly_set(T->modulus, fq_nmod_ctx->modulus);
+            T->refcount = 1;
+            T->next = _fq_zech_tables_head;
+            _fq_zech_tables_head = T;
+        }
+        else
+        {
+            flint_free(T);
+            T = NULL;
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_fq_zech_tables_lock);
+#endif
+
+    return T;
+}
+
+void
+_fq_zech_tables_release(fq_zech_tables_struct * T)
+{
+    fq_zech_tables_struct ** prev;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_fq_zech_tables_lock);
+#endif
+
+    T->refcount--;
+
+    if (T->refcount == 0)
+    {
+        for (prev = &_fq_zech_tables_head; *prev != T;
+                                    prev = (fq_zech_tables_struct **) &((*prev)->next))
+            ;
+
+        *prev = T->next;
+
+        flint_free(T->zech_log_table);
+        flint_free(T->prime_field_table);
+        flint_free(T->eval_table);
+        nmod_poly_clear(T->modulus);
+        flint_free(T);
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_fq_zech_tables_lock);
+#endif
+}
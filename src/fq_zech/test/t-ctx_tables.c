@@ -0,0 +1,127 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "fq_nmod.h"
+#include "fq_zech.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("ctx_tables... ");
+    fflush(stdout);
+
+    /* contexts with the same modulus share tables */
+    for (iter = 0; iter < 20 * flint_test_multiplier(); iter++)
+    {
+        fq_zech_ctx_t ctx1, ctx2;
+        fq_zech_t a, b, c;
+
+        fq_zech_ctx_randtest(ctx1, state);
+        fq_zech_ctx_init_modulus(ctx2, fq_zech_ctx_modulus(ctx1), "b");
+
+        if (ctx1->zech_log_table != ctx2->zech_log_table ||
+            ctx1->eval_table != ctx2->eval_table ||
+            ctx1->prime_field_table != ctx2->prime_field_table)
+        {
+            flint_printf("FAIL (sharing)\n");
+            fq_zech_ctx_print(ctx1);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fq_zech_ctx_clear(ctx1);
+
+        fq_zech_init(a, ctx2);
+        fq_zech_init(b, ctx2);
+        fq_zech_init(c, ctx2);
+
+        fq_zech_randtest(a, state, ctx2);
+        fq_zech_randtest(b, state, ctx2);
+        fq_zech_add(c, a, b, ctx2);
+        fq_zech_sub(c, c, b, ctx2);
+
+        if (!fq_zech_equal(a, c, ctx2))
+        {
+            flint_printf("FAIL (tables released too early)\n");
+            fq_zech_ctx_print(ctx2);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fq_zech_clear(a, ctx2);
+        fq_zech_clear(b, ctx2);
+        fq_zech_clear(c, ctx2);
+
+        fq_zech_ctx_clear(ctx2);
+    }
+
+    /* threaded construction agrees with the serial one */
+    for (iter = 0; iter < 2 * flint_test_multiplier(); iter++)
+    {
+        slong primes[4] = { 2, 3, 17, 257 };
+        slong degrees[4] = { 17, 11, 4, 2 };
+        fq_nmod_ctx_t fctx;
+        fq_zech_tables_struct T1, T2;
+        nmod_poly_t modulus;
+        slong i, q;
+
+        i = n_randint(state, 4);
+        q = n_pow(primes[i], degrees[i]);
+
+        nmod_poly_init(modulus, primes[i]);
+        nmod_poly_randtest_monic_primitive(modulus, state, degrees[i] + 1);
+        fq_nmod_ctx_init_modulus(fctx, modulus, "a");
+
+        flint_set_num_threads(1);
+        if (!_fq_zech_tables_build(&T1, fctx))
+        {
+            flint_printf("FAIL (primitive modulus rejected)\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_set_num_threads(2 + n_randint(state, 4));
+        if (!_fq_zech_tables_build(&T2, fctx))
+        {
+            flint_printf("FAIL (primitive modulus rejected, threaded)\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (!_nmod_vec_equal(T1.zech_log_table, T2.zech_log_table, q) ||
+            !_nmod_vec_equal(T1.eval_table, T2.eval_table, q) ||
+            !_nmod_vec_equal(T1.prime_field_table, T2.prime_field_table, primes[i]))
+        {
+            flint_printf("FAIL (threaded tables)\n");
+            flint_printf("p = %wd, d = %wd\n", primes[i], degrees[i]);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(T1.zech_log_table);
+        flint_free(T1.prime_field_table);
+        flint_free(T1.eval_table);
+        flint_free(T2.zech_log_table);
+        flint_free(T2.prime_field_table);
+        flint_free(T2.eval_table);
+
+        fq_nmod_ctx_clear(fctx);
+        nmod_poly_clear(modulus);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -26,6 +26,17 @@ fq_zech_struct;
 
 typedef fq_zech_struct fq_zech_t[1];
 
+typedef struct
+{
+    mp_limb_t * zech_log_table;
+    mp_limb_t * prime_field_table;
+    mp_limb_t * eval_table;
+    nmod_poly_struct modulus[1];    /* monic modulus the tables belong to */
+    slong refcount;
+    void * next;
+}
+fq_zech_tables_struct;
+
 typedef struct
 {
     mp_limb_t qm1;              /* q - 1 */
@@ -37,6 +48,7 @@ typedef struct
     mp_limb_t * zech_log_table;
     mp_limb_t * prime_field_table;
     mp_limb_t * eval_table;
+    fq_zech_tables_struct * tables;     /* shared owner of the above tables */
 
     fq_nmod_ctx_struct * fq_nmod_ctx;
     int owns_fq_nmod_ctx;
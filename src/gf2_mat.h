@@ -0,0 +1,144 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GF2_MAT_H
+#define GF2_MAT_H
+
+#ifdef GF2_MAT_INLINES_C
+#define GF2_MAT_INLINE
+#else
+#define GF2_MAT_INLINE static __inline__
+#endif
+
+#include "nmod_types.h"
+#include "bool_mat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Entry (i, j) is bit j % FLINT_BITS of word j / FLINT_BITS of row i.
+   The unused bits of the last word of each row are kept zero. */
+typedef struct
+{
+    ulong * entries;
+    slong r;
+    slong c;
+    slong stride;       /* number of words per row */
+    ulong ** rows;
+}
+gf2_mat_struct;
+
+typedef gf2_mat_struct gf2_mat_t[1];
+
+#define gf2_mat_nrows(mat) ((mat)->r)
+#define gf2_mat_ncols(mat) ((mat)->c)
+
+#define GF2_MAT_M4RM_CUTOFF 16
+
+GF2_MAT_INLINE int
+gf2_mat_get_entry(const gf2_mat_t mat, slong i, slong j)
+{
+    return (mat->rows[i][j / FLINT_BITS] >> (j % FLINT_BITS)) & 1;
+}
+
+GF2_MAT_INLINE void
+gf2_mat_set_entry(gf2_mat_t mat, slong i, slong j, int x)
+{
+    ulong b = UWORD(1) << (j % FLINT_BITS);
+
+    if (x & 1)
+        mat->rows[i][j / FLINT_BITS] |= b;
+    else
+        mat->rows[i][j / FLINT_BITS] &= ~b;
+}
+
+/* Memory management */
+
+void gf2_mat_init(gf2_mat_t mat, slong r, slong c);
+
+void gf2_mat_clear(gf2_mat_t mat);
+
+GF2_MAT_INLINE void
+gf2_mat_swap(gf2_mat_t mat1, gf2_mat_t mat2)
+{
+    gf2_mat_struct t = *mat1;
+    *mat1 = *mat2;
+    *mat2 = t;
+}
+
+GF2_MAT_INLINE int
+gf2_mat_is_empty(const gf2_mat_t mat)
+{
+    return (mat->r == 0) || (mat->c == 0);
+}
+
+/* Basic assignment and comparison */
+
+void gf2_mat_set(gf2_mat_t dest, const gf2_mat_t src);
+
+void gf2_mat_zero(gf2_mat_t mat);
+
+void gf2_mat_one(gf2_mat_t mat);
+
+int gf2_mat_equal(const gf2_mat_t mat1, const gf2_mat_t mat2);
+
+int gf2_mat_is_zero(const gf2_mat_t mat);
+
+void gf2_mat_randtest(gf2_mat_t mat, flint_rand_t state);
+
+void gf2_mat_print(const gf2_mat_t mat);
+
+/* Conversions */
+
+void gf2_mat_set_nmod_mat(gf2_mat_t dest, const nmod_mat_t src);
+
+void gf2_mat_get_nmod_mat(nmod_mat_t dest, const gf2_mat_t src);
+
+void gf2_mat_set_bool_mat(gf2_mat_t dest, const bool_mat_t src);
+
+void gf2_mat_get_bool_mat(bool_mat_t dest, const gf2_mat_t src);
+
+/* Arithmetic */
+
+void gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A);
+
+void gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+void _gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean);
+
+void gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+void _gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean);
+
+void gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+void _gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean);
+
+void gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+/* Boolean semiring operations */
+
+void gf2_mat_bool_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+void gf2_mat_bool_transitive_closure(gf2_mat_t B, const gf2_mat_t A);
+
+/* Row reduction */
+
+slong gf2_mat_rref(gf2_mat_t A);
+
+slong gf2_mat_rank(const gf2_mat_t A);
+
+slong gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, j;
+
+    if (A->r != B->r || A->c != B->c || A->r != C->r || A->c != C->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_add). Incompatible dimensions.\n");
+
+    if (gf2_mat_is_empty(C))
+        return;
+
+    for (i = 0; i < C->r; i++)
+        for (j = 0; j < C->stride; j++)
+            C->rows[i][j] = A->rows[i][j] ^ B->rows[i][j];
+}
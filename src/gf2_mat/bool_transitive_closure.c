@@ -0,0 +1,41 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/* Warshall's algorithm with whole rows: if i reaches k, then i reaches
+   everything k reaches. */
+void
+gf2_mat_bool_transitive_closure(gf2_mat_t B, const gf2_mat_t A)
+{
+    slong i, k, w, n;
+
+    if (A->r != A->c || B->r != A->r || B->c != A->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_bool_transitive_closure). "
+            "Incompatible dimensions.\n");
+
+    gf2_mat_set(B, A);
+    n = B->stride;
+
+    for (k = 0; k < B->r; k++)
+    {
+        const ulong * b = B->rows[k];
+
+        for (i = 0; i < B->r; i++)
+        {
+            if (gf2_mat_get_entry(B, i, k))
+            {
+                ulong * c = B->rows[i];
+
+                for (w = 0; w < n; w++)
+                    c[w] |= b[w];
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "mpn_extras.h"
+#include "gf2_mat.h"
+
+int
+gf2_mat_equal(const gf2_mat_t mat1, const gf2_mat_t mat2)
+{
+    slong i;
+
+    if (mat1->r != mat2->r || mat1->c != mat2->c)
+        return 0;
+
+    if (gf2_mat_is_empty(mat1))
+        return 1;
+
+    for (i = 0; i < mat1->r; i++)
+        if (mpn_cmp(mat1->rows[i], mat2->rows[i], mat1->stride) != 0)
+            return 0;
+
+    return 1;
+}
+
+int
+gf2_mat_is_zero(const gf2_mat_t mat)
+{
+    slong i;
+
+    if (gf2_mat_is_empty(mat))
+        return 1;
+
+    for (i = 0; i < mat->r; i++)
+        if (!flint_mpn_zero_p(mat->rows[i], mat->stride))
+            return 0;
+
+    return 1;
+}
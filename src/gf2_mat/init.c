@@ -0,0 +1,29 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_init(gf2_mat_t mat, slong r, slong c)
+{
+    mat->entries = NULL;
+    mat->rows = NULL;
+    mat->r = r;
+    mat->c = c;
+    mat->stride = (c + FLINT_BITS - 1) / FLINT_BITS;
+
+    if (r != 0 && c != 0)
+    {
+        slong i;
+        mat->entries = flint_calloc(r * mat->stride, sizeof(ulong));
+        mat->rows = flint_malloc(r * sizeof(ulong *));
+        for (i = 0; i < r; i++)
+            mat->rows[i] = mat->entries + i * mat->stride;
+    }
+}
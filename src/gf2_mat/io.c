@@ -0,0 +1,28 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_print(const gf2_mat_t mat)
+{
+    slong i, j;
+
+    for (i = 0; i < mat->r; i++)
+    {
+        flint_printf("[");
+        for (j = 0; j < mat->c; j++)
+        {
+            flint_printf("%d", gf2_mat_get_entry(mat, i, j));
+            if (j + 1 < mat->c)
+                flint_printf(", ");
+        }
+        flint_printf("]\n");
+    }
+}
@@ -0,0 +1,54 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+_gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean)
+{
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, C->r, C->c);
+        _gf2_mat_mul(T, A, B, boolean);
+        gf2_mat_swap(T, C);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    /* building the tables costs 256 row operations per 8 rows of B */
+    if (A->r < GF2_MAT_M4RM_CUTOFF || A->c < 8)
+        _gf2_mat_mul_classical(C, A, B, boolean);
+    else
+        _gf2_mat_mul_m4rm(C, A, B, boolean);
+}
+
+void
+gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    if (A->c != B->r || A->r != C->r || B->c != C->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_mul). Incompatible dimensions.\n");
+
+    if (gf2_mat_is_empty(C))
+        return;
+
+    _gf2_mat_mul(C, A, B, 0);
+}
+
+void
+gf2_mat_bool_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    if (A->c != B->r || A->r != C->r || B->c != C->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_bool_mul). Incompatible dimensions.\n");
+
+    if (gf2_mat_is_empty(C))
+        return;
+
+    _gf2_mat_mul(C, A, B, 1);
+}
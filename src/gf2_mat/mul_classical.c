@@ -0,0 +1,64 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/* Row i of C is the sum (or the union if boolean is set) of the rows k
+   of B for which entry (i, k) of A is set. */
+void
+_gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean)
+{
+    slong i, k, w, n = B->stride;
+    ulong * c;
+    const ulong * b;
+
+    gf2_mat_zero(C);
+
+    for (i = 0; i < A->r; i++)
+    {
+        c = C->rows[i];
+
+        for (k = 0; k < A->c; k++)
+        {
+            if (gf2_mat_get_entry(A, i, k))
+            {
+                b = B->rows[k];
+
+                if (boolean)
+                    for (w = 0; w < n; w++)
+                        c[w] |= b[w];
+                else
+                    for (w = 0; w < n; w++)
+                        c[w] ^= b[w];
+            }
+        }
+    }
+}
+
+void
+gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    if (A->c != B->r || A->r != C->r || B->c != C->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_mul_classical). Incompatible dimensions.\n");
+
+    if (gf2_mat_is_empty(C))
+        return;
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, C->r, C->c);
+        _gf2_mat_mul_classical(T, A, B, 0);
+        gf2_mat_swap(T, C);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    _gf2_mat_mul_classical(C, A, B, 0);
+}
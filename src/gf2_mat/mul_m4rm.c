@@ -0,0 +1,91 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+/*
+    Method of Four Russians: for each block of 8 rows of B, tabulate all
+    2^8 sums (or unions) of these rows, so that the contribution of the
+    block to a row of C costs a single row operation, indexed by the
+    corresponding 8 bits of the row of A. The blocks are aligned to 8 bits
+    so the index never straddles two words.
+*/
+void
+_gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B, int boolean)
+{
+    slong i, j, k, kk, w, n = B->stride;
+    ulong * T, * t, * c;
+    const ulong * u, * b;
+
+    gf2_mat_zero(C);
+
+    T = flint_malloc(sizeof(ulong) * 256 * n);
+    flint_mpn_zero(T, n);
+
+    for (k = 0; k < B->r; k += 8)
+    {
+        kk = FLINT_MIN(8, B->r - k);
+
+        for (j = 1; j < (WORD(1) << kk); j++)
+        {
+            t = T + j * n;
+            u = T + (j & (j - 1)) * n;
+            b = B->rows[k + flint_ctz(j)];
+
+            if (boolean)
+                for (w = 0; w < n; w++)
+                    t[w] = u[w] | b[w];
+            else
+                for (w = 0; w < n; w++)
+                    t[w] = u[w] ^ b[w];
+        }
+
+        for (i = 0; i < A->r; i++)
+        {
+            j = (A->rows[i][k / FLINT_BITS] >> (k % FLINT_BITS)) & 255;
+
+            if (j != 0)
+            {
+                c = C->rows[i];
+                t = T + j * n;
+
+                if (boolean)
+                    for (w = 0; w < n; w++)
+                        c[w] |= t[w];
+                else
+                    for (w = 0; w < n; w++)
+                        c[w] ^= t[w];
+            }
+        }
+    }
+
+    flint_free(T);
+}
+
+void
+gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    if (A->c != B->r || A->r != C->r || B->c != C->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_mul_m4rm). Incompatible dimensions.\n");
+
+    if (gf2_mat_is_empty(C))
+        return;
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, C->r, C->c);
+        _gf2_mat_mul_m4rm(T, A, B, 0);
+        gf2_mat_swap(T, C);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    _gf2_mat_mul_m4rm(C, A, B, 0);
+}
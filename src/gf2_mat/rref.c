@@ -0,0 +1,121 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+#define GF2_MAT_RREF_BLOCK 8
+
+static void
+_gf2_vec_add(ulong * a, const ulong * b, slong n)
+{
+    slong i;
+
+    for (i = 0; i < n; i++)
+        a[i] ^= b[i];
+}
+
+/*
+    Gauss-Jordan elimination with the Method of Four Russians (M4RI).
+    Pivots are found in blocks of up to 8. Within a block, the pivot rows
+    are kept reduced against each other, and a candidate row is tested
+    against the pivots found so far without modifying it. Once the block
+    is complete, the 2^k sums of its pivot rows are tabulated and every
+    other row is reduced with a single row operation indexed by its
+    entries in the pivot columns.
+
+    The invariant is that rows r, r + 1, ... vanish in all columns before
+    col, so the table only needs the words from col onwards.
+*/
+slong
+gf2_mat_rref(gf2_mat_t A)
+{
+    slong m = A->r, n = A->c, r, col, c, kk, i, j, w0, len;
+    slong pc[GF2_MAT_RREF_BLOCK];
+    ulong * T, * t;
+    int b;
+
+    if (gf2_mat_is_empty(A))
+        return 0;
+
+    T = flint_malloc(sizeof(ulong) * (WORD(1) << GF2_MAT_RREF_BLOCK) * A->stride);
+
+    r = 0;
+    col = 0;
+
+    while (r < m && col < n)
+    {
+        w0 = col / FLINT_BITS;
+        len = A->stride - w0;
+        kk = 0;
+
+        for (c = col; c < n && kk < GF2_MAT_RREF_BLOCK && r + kk < m; c++)
+        {
+            /* look for a row with a nonzero entry in column c after
+               reduction by the pivots of the block */
+            for (i = r + kk; i < m; i++)
+            {
+                b = gf2_mat_get_entry(A, i, c);
+                for (j = 0; j < kk; j++)
+                    if (gf2_mat_get_entry(A, i, pc[j]))
+                        b ^= gf2_mat_get_entry(A, r + j, c);
+                if (b)
+                    break;
+            }
+
+            if (i == m)
+                continue;
+
+            for (j = 0; j < kk; j++)
+                if (gf2_mat_get_entry(A, i, pc[j]))
+                    _gf2_vec_add(A->rows[i] + w0, A->rows[r + j] + w0, len);
+
+            t = A->rows[i];
+            A->rows[i] = A->rows[r + kk];
+            A->rows[r + kk] = t;
+
+            for (j = 0; j < kk; j++)
+                if (gf2_mat_get_entry(A, r + j, c))
+                    _gf2_vec_add(A->rows[r + j] + w0, A->rows[r + kk] + w0, len);
+
+            pc[kk] = c;
+            kk++;
+        }
+
+        col = c;
+
+        if (kk == 0)
+            break;
+
+        flint_mpn_zero(T, len);
+        for (j = 1; j < (WORD(1) << kk); j++)
+        {
+            t = T + j * len;
+            flint_mpn_copyi(t, T + (j & (j - 1)) * len, len);
+            _gf2_vec_add(t, A->rows[r + flint_ctz(j)] + w0, len);
+        }
+
+        for (i = 0; i < m; i++)
+        {
+            if (i >= r && i < r + kk)
+                continue;
+
+            for (j = 0, c = 0; j < kk; j++)
+                c |= gf2_mat_get_entry(A, i, pc[j]) << j;
+
+            if (c != 0)
+                _gf2_vec_add(A->rows[i] + w0, T + c * len, len);
+        }
+
+        r += kk;
+    }
+
+    flint_free(T);
+
+    return r;
+}
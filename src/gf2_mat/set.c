@@ -0,0 +1,25 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_set(gf2_mat_t dest, const gf2_mat_t src)
+{
+    slong i;
+
+    if (dest == src || gf2_mat_is_empty(src))
+        return;
+
+    if (dest->r != src->r || dest->c != src->c)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_set). Incompatible dimensions.\n");
+
+    for (i = 0; i < src->r; i++)
+        flint_mpn_copyi(dest->rows[i], src->rows[i], src->stride);
+}
@@ -0,0 +1,33 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_set_bool_mat(gf2_mat_t dest, const bool_mat_t src)
+{
+    slong i, j;
+
+    gf2_mat_zero(dest);
+
+    for (i = 0; i < src->r; i++)
+        for (j = 0; j < src->c; j++)
+            if (bool_mat_get_entry(src, i, j))
+                dest->rows[i][j / FLINT_BITS] |= UWORD(1) << (j % FLINT_BITS);
+}
+
+void
+gf2_mat_get_bool_mat(bool_mat_t dest, const gf2_mat_t src)
+{
+    slong i, j;
+
+    for (i = 0; i < src->r; i++)
+        for (j = 0; j < src->c; j++)
+            bool_mat_set_entry(dest, i, j, gf2_mat_get_entry(src, i, j));
+}
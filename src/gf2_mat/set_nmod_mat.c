@@ -0,0 +1,42 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_set_nmod_mat(gf2_mat_t dest, const nmod_mat_t src)
+{
+    slong i, j;
+    ulong w;
+
+    for (i = 0; i < src->r; i++)
+    {
+        for (j = 0, w = 0; j < src->c; j++)
+        {
+            w |= (nmod_mat_entry(src, i, j) & 1) << (j % FLINT_BITS);
+
+            if (j % FLINT_BITS == FLINT_BITS - 1 || j == src->c - 1)
+            {
+                dest->rows[i][j / FLINT_BITS] = w;
+                w = 0;
+            }
+        }
+    }
+}
+
+void
+gf2_mat_get_nmod_mat(nmod_mat_t dest, const gf2_mat_t src)
+{
+    slong i, j;
+
+    for (i = 0; i < src->r; i++)
+        for (j = 0; j < src->c; j++)
+            nmod_mat_entry(dest, i, j) = gf2_mat_get_entry(src, i, j);
+}
@@ -0,0 +1,112 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("bool_mul....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C, D;
+        slong m, k, n, i, j, l;
+
+        m = n_randint(state, 100);
+        k = n_randint(state, 100);
+        n = n_randint(state, 100);
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        gf2_mat_init(D, m, n);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+
+        gf2_mat_bool_mul(C, A, B);
+
+        for (i = 0; i < m; i++)
+        {
+            for (j = 0; j < n; j++)
+            {
+                int x = 0;
+                for (l = 0; l < k; l++)
+                    x |= gf2_mat_get_entry(A, i, l) & gf2_mat_get_entry(B, l, j);
+                gf2_mat_set_entry(D, i, j, x);
+            }
+        }
+
+        if (!gf2_mat_equal(C, D))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("m = %wd, k = %wd, n = %wd\n", m, k, n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(D);
+    }
+
+    /* transitive closure: the closure T of A is the least transitive
+       matrix containing A, and A T + A = T */
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, T, U, V;
+        slong n, i, j;
+
+        n = n_randint(state, 100);
+
+        gf2_mat_init(A, n, n);
+        gf2_mat_init(T, n, n);
+        gf2_mat_init(U, n, n);
+        gf2_mat_init(V, n, n);
+
+        /* sparse graphs have the most interesting closures */
+        for (i = 0; i < n; i++)
+            for (j = 0; j < n; j++)
+                gf2_mat_set_entry(A, i, j, n_randint(state, n + 1) == 0);
+
+        gf2_mat_bool_transitive_closure(T, A);
+
+        /* U = A T, V = (A T) | A */
+        gf2_mat_bool_mul(U, A, T);
+        for (i = 0; i < n; i++)
+            for (j = 0; j < n; j++)
+                gf2_mat_set_entry(V, i, j,
+                    gf2_mat_get_entry(U, i, j) | gf2_mat_get_entry(A, i, j));
+
+        if (!gf2_mat_equal(V, T))
+        {
+            flint_printf("FAIL (transitive closure)\n");
+            flint_printf("n = %wd\n", n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(T);
+        gf2_mat_clear(U);
+        gf2_mat_clear(V);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
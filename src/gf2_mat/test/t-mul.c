@@ -0,0 +1,112 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C, D;
+        nmod_mat_t AA, BB, CC, DD;
+        slong m, k, n, N;
+
+        N = n_randint(state, 10) == 0 ? 300 : 80;
+        m = n_randint(state, N);
+        k = n_randint(state, N);
+        n = n_randint(state, N);
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        gf2_mat_init(D, m, n);
+        nmod_mat_init(AA, m, k, 2);
+        nmod_mat_init(BB, k, n, 2);
+        nmod_mat_init(CC, m, n, 2);
+        nmod_mat_init(DD, m, n, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_randtest(C, state);
+
+        switch (n_randint(state, 3))
+        {
+            case 0:
+                gf2_mat_mul(C, A, B);
+                break;
+            case 1:
+                gf2_mat_mul_classical(C, A, B);
+                break;
+            default:
+                gf2_mat_mul_m4rm(C, A, B);
+        }
+
+        gf2_mat_get_nmod_mat(AA, A);
+        gf2_mat_get_nmod_mat(BB, B);
+        gf2_mat_get_nmod_mat(CC, C);
+        nmod_mat_mul(DD, AA, BB);
+
+        if (!nmod_mat_equal(CC, DD))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("m = %wd, k = %wd, n = %wd\n", m, k, n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* round trip through nmod_mat */
+        gf2_mat_set_nmod_mat(D, DD);
+
+        if (!gf2_mat_equal(C, D))
+        {
+            flint_printf("FAIL (conversion)\n");
+            flint_printf("m = %wd, k = %wd, n = %wd\n", m, k, n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* aliasing */
+        if (m == k)
+        {
+            gf2_mat_set(D, B);
+            gf2_mat_mul(D, A, D);
+
+            if (!gf2_mat_equal(C, D))
+            {
+                flint_printf("FAIL (aliasing)\n");
+                flint_printf("m = %wd, k = %wd, n = %wd\n", m, k, n);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(D);
+        nmod_mat_clear(AA);
+        nmod_mat_clear(BB);
+        nmod_mat_clear(CC);
+        nmod_mat_clear(DD);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C, X, AX;
+        slong m, n, k, rank, nullity;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+        k = n_randint(state, 30);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(B, m, k);
+        gf2_mat_init(C, k, n);
+        gf2_mat_init(X, n, n);
+        gf2_mat_init(AX, m, n);
+
+        gf2_mat_randtest(B, state);
+        gf2_mat_randtest(C, state);
+        gf2_mat_mul(A, B, C);
+
+        rank = gf2_mat_rank(A);
+        nullity = gf2_mat_nullspace(X, A);
+        gf2_mat_mul(AX, A, X);
+
+        if (nullity + rank != n || !gf2_mat_is_zero(AX) || gf2_mat_rank(X) != nullity)
+        {
+            flint_printf("FAIL\n");
+            flint_printf("m = %wd, n = %wd, rank = %wd, nullity = %wd\n", m, n, rank, nullity);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(X);
+        gf2_mat_clear(AX);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "perm.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("rref....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B, C, D;
+        nmod_mat_t AA, CC;
+        slong m, n, k, rank1, rank2;
+        slong * p, * P;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(C, m, n);
+        nmod_mat_init(AA, m, n, 2);
+        nmod_mat_init(CC, m, n, 2);
+
+        /* low rank matrices as products */
+        if (n_randint(state, 2))
+        {
+            k = n_randint(state, 20);
+            gf2_mat_init(B, m, k);
+            gf2_mat_init(D, k, n);
+            gf2_mat_randtest(B, state);
+            gf2_mat_randtest(D, state);
+            gf2_mat_mul(A, B, D);
+            gf2_mat_clear(B);
+            gf2_mat_clear(D);
+        }
+        else
+        {
+            gf2_mat_randtest(A, state);
+        }
+
+        gf2_mat_get_nmod_mat(AA, A);
+        p = flint_malloc(sizeof(slong) * FLINT_MAX(n, 1));
+        P = _perm_init(m);
+
+        gf2_mat_set(C, A);
+        rank1 = gf2_mat_rref(C);
+        rank2 = (m == 0 || n == 0) ? 0 : _nmod_mat_rref(AA, p, P);
+        gf2_mat_get_nmod_mat(CC, C);
+
+        if (rank1 != rank2 || !nmod_mat_equal(AA, CC) || rank1 != gf2_mat_rank(A))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("m = %wd, n = %wd, rank1 = %wd, rank2 = %wd\n", m, n, rank1, rank2);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(p);
+        _perm_clear(P);
+        gf2_mat_clear(A);
+        gf2_mat_clear(C);
+        nmod_mat_clear(AA);
+        nmod_mat_clear(CC);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
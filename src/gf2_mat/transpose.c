@@ -0,0 +1,36 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gf2_mat.h"
+
+void
+gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A)
+{
+    slong i, j;
+
+    if (B->r != A->c || B->c != A->r)
+        flint_throw(FLINT_ERROR, "Exception (gf2_mat_transpose). Incompatible dimensions.\n");
+
+    if (A == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, B->r, B->c);
+        gf2_mat_transpose(T, A);
+        gf2_mat_swap(T, B);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    gf2_mat_zero(B);
+
+    for (i = 0; i < A->r; i++)
+        for (j = 0; j < A->c; j++)
+            if (gf2_mat_get_entry(A, i, j))
+                B->rows[j][i / FLINT_BITS] |= UWORD(1) << (i % FLINT_BITS);
+}
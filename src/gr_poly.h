@@ -414,6 +414,43 @@ GR_POLY_INLINE WARN_UNUSED_RESULT int _gr_poly_exp_series(gr_ptr res, gr_srcptr
 WARN_UNUSED_RESULT int _gr_poly_exp_series_generic(gr_ptr f, gr_srcptr h, slong hlen, slong n, gr_ctx_t ctx);
 WARN_UNUSED_RESULT int gr_poly_exp_series(gr_poly_t f, const gr_poly_t h, slong n, gr_ctx_t ctx);
 
+WARN_UNUSED_RESULT int _gr_poly_integral_offset(gr_ptr res, gr_srcptr poly, slong len, slong m, gr_ctx_t ctx);
+
+/* Lazily extended power series */
+
+#define GR_POLY_LAZY_SERIES_INV 0
+#define GR_POLY_LAZY_SERIES_EXP 1
+
+typedef struct
+{
+    gr_poly_t input;
+    gr_poly_t res;
+    gr_poly_t aux;
+    slong len;
+    slong input_len;
+    int op;
+}
+gr_poly_lazy_series_struct;
+
+typedef gr_poly_lazy_series_struct gr_poly_lazy_series_t[1];
+
+WARN_UNUSED_RESULT int _gr_poly_lazy_series_extend(gr_ptr f, gr_ptr g, gr_srcptr h, slong hlen, int op, slong m, slong n, gr_ctx_t ctx);
+
+void gr_poly_lazy_series_init(gr_poly_lazy_series_t S, gr_ctx_t ctx);
+void gr_poly_lazy_series_clear(gr_poly_lazy_series_t S, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_set_inv(gr_poly_lazy_series_t S, const gr_poly_t Q, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_set_exp(gr_poly_lazy_series_t S, const gr_poly_t h, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_set_input(gr_poly_lazy_series_t S, const gr_poly_t h, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_fit_length(gr_poly_lazy_series_t S, slong len, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_get_coeff(gr_ptr c, gr_poly_lazy_series_t S, slong i, gr_ctx_t ctx);
+WARN_UNUSED_RESULT int gr_poly_lazy_series_get_series(gr_poly_t res, gr_poly_lazy_series_t S, slong len, gr_ctx_t ctx);
+
+GR_POLY_INLINE slong
+gr_poly_lazy_series_length(const gr_poly_lazy_series_t S, gr_ctx_t ctx)
+{
+    return S->len;
+}
+
 WARN_UNUSED_RESULT int _gr_poly_sin_cos_series_basecase(gr_ptr s, gr_ptr c, gr_srcptr h, slong hlen, slong n, int times_pi, gr_ctx_t ctx);
 WARN_UNUSED_RESULT int gr_poly_sin_cos_series_basecase(gr_poly_t s, gr_poly_t c, const gr_poly_t h, slong n, int times_pi, gr_ctx_t ctx);
 WARN_UNUSED_RESULT int _gr_poly_sin_cos_series_tangent(gr_ptr s, gr_ptr c, gr_srcptr h, slong hlen, slong n, int times_pi, gr_ctx_t ctx);
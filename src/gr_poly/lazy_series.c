@@ -0,0 +1,317 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gr_vec.h"
+#include "gr_poly.h"
+
+/* extensions by at most this many terms use the recurrences */
+#define LAZY_SERIES_BASECASE_STEP 8
+
+/* f = 1/h: f_i = -f_0 (h_1 f_{i-1} + ... + h_l f_{i-l}) */
+static int
+_gr_poly_lazy_series_inv_basecase(gr_ptr f, gr_srcptr h, slong hlen,
+                                        slong m, slong n, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+    slong sz = ctx->sizeof_elem;
+    slong i, l;
+
+    for (i = m; i < n; i++)
+    {
+        l = FLINT_MIN(i, hlen - 1);
+        status |= _gr_vec_dot_rev(GR_ENTRY(f, i, sz), NULL, 0,
+                    GR_ENTRY(h, 1, sz), GR_ENTRY(f, i - l, sz), l, ctx);
+        status |= gr_mul(GR_ENTRY(f, i, sz), GR_ENTRY(f, i, sz), f, ctx);
+        status |= gr_neg(GR_ENTRY(f, i, sz), GR_ENTRY(f, i, sz), ctx);
+    }
+
+    return status;
+}
+
+/* one Newton step, as in _gr_poly_inv_series_newton; requires n <= 2m */
+static int
+_gr_poly_lazy_series_inv_newton(gr_ptr f, gr_srcptr h, slong hlen,
+                                        slong m, slong n, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+    slong sz = ctx->sizeof_elem;
+    slong hnlen, Wlen, W2len;
+    gr_ptr W;
+
+    hnlen = FLINT_MIN(hlen, n);
+    Wlen = FLINT_MIN(hnlen + m - 1, n);
+    W2len = Wlen - m;
+
+    if (W2len <= 0)
+        return _gr_vec_zero(GR_ENTRY(f, m, sz), n - m, ctx);
+
+    GR_TMP_INIT_VEC(W, Wlen, ctx);
+
+    status |= _gr_poly_mullow(W, h, hnlen, f, m, Wlen, ctx);
+    status |= _gr_poly_mullow(GR_ENTRY(f, m, sz), f, m, GR_ENTRY(W, m, sz), W2len, n - m, ctx);
+    status |= _gr_vec_neg(GR_ENTRY(f, m, sz), GR_ENTRY(f, m, sz), n - m, ctx);
+
+    GR_TMP_CLEAR_VEC(W, Wlen, ctx);
+
+    return status;
+}
+
+/*
+    f = exp(h), g = 1/f, using f' = h' f:
+    f_i = (h'_0 f_{i-1} + ... + h'_{l-1} f_{i-l}) / i
+*/
+static int
+_gr_poly_lazy_series_exp_basecase(gr_ptr f, gr_ptr g, gr_srcptr h, slong hlen,
+                                        slong m, slong n, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+    slong sz = ctx->sizeof_elem;
+    slong i, l;
+    gr_ptr hprime;
+
+    hlen = FLINT_MIN(hlen, n);
+
+    if (hlen <= 1)
+    {
+        status |= _gr_vec_zero(GR_ENTRY(f, m, sz), n - m, ctx);
+        status |= _gr_vec_zero(GR_ENTRY(g, m, sz), n - m, ctx);
+        return status;
+    }
+
+    GR_TMP_INIT_VEC(hprime, hlen - 1, ctx);
+    status |= _gr_poly_derivative(hprime, h, hlen, ctx);
+
+    for (i = m; i < n && status == GR_SUCCESS; i++)
+    {
+        l = FLINT_MIN(i, hlen - 1);
+        status |= _gr_vec_dot_rev(GR_ENTRY(f, i, sz), NULL, 0,
+                    hprime, GR_ENTRY(f, i - l, sz), l, ctx);
+        status |= gr_div_ui(GR_ENTRY(f, i, sz), GR_ENTRY(f, i, sz), i, ctx);
+    }
+
+    GR_TMP_CLEAR_VEC(hprime, hlen - 1, ctx);
+
+    if (status == GR_SUCCESS)
+        status |= _gr_poly_lazy_series_inv_basecase(g, f, n, m, n, ctx);
+
+    return status;
+}
+
+/* one Newton step, as in _gr_poly_exp_series_newton; requires n <= 2m */
+static int
+_gr_poly_lazy_series_exp_newton(gr_ptr f, gr_ptr g, gr_srcptr h, slong hlen,
+                                        slong m, slong n, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+    slong sz = ctx->sizeof_elem;
+    slong l, r;
+    gr_ptr t, hprime;
+
+    hlen = FLINT_MIN(hlen, n);
+
+    if (hlen <= 1)
+    {
+        status |= _gr_vec_zero(GR_ENTRY(f, m, sz), n - m, ctx);
+        status |= _gr_vec_zero(GR_ENTRY(g, m, sz), n - m, ctx);
+        return status;
+    }
+
+    GR_TMP_INIT_VEC(t, n, ctx);
+    GR_TMP_INIT_VEC(hprime, hlen - 1, ctx);
+
+    status |= _gr_poly_derivative(hprime, h, hlen, ctx);
+
+    /* f := f (1 + h - log(f)) + O(x^n), with g = 1/f + O(x^m) */
+    l = hlen - 1;
+    r = FLINT_MIN(l + m - 1, n - 1);
+    status |= _gr_poly_mullow(t, hprime, l, f, m, r, ctx);
+    status |= _gr_poly_mullow(GR_ENTRY(g, m, sz), g, n - m, GR_ENTRY(t, m - 1, sz), r + 1 - m, n - m, ctx);
+    status |= _gr_poly_integral_offset(GR_ENTRY(g, m, sz), GR_ENTRY(g, m, sz), n - m, m, ctx);
+    status |= _gr_poly_mullow(GR_ENTRY(f, m, sz), f, n - m, GR_ENTRY(g, m, sz), n - m, n - m, ctx);
+
+    /* g := 1/f + O(x^n) */
+    status |= _gr_poly_mullow(t, f, n, g, m, n, ctx);
+    status |= _gr_poly_mullow(GR_ENTRY(g, m, sz), g, m, GR_ENTRY(t, m, sz), n - m, n - m, ctx);
+    status |= _gr_vec_neg(GR_ENTRY(g, m, sz), GR_ENTRY(g, m, sz), n - m, ctx);
+
+    GR_TMP_CLEAR_VEC(hprime, hlen - 1, ctx);
+    GR_TMP_CLEAR_VEC(t, n, ctx);
+
+    return status;
+}
+
+int
+_gr_poly_lazy_series_extend(gr_ptr f, gr_ptr g, gr_srcptr h, slong hlen,
+                                int op, slong m, slong n, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+    slong sz = ctx->sizeof_elem;
+    slong k;
+
+    if (n <= m)
+        return GR_SUCCESS;
+
+    if (m == 0)
+    {
+        if (op == GR_POLY_LAZY_SERIES_INV)
+        {
+            if (hlen == 0)
+                return GR_DOMAIN;
+
+            return _gr_poly_inv_series(f, h, hlen, n, ctx);
+        }
+        else if (hlen == 0)
+        {
+            status |= gr_one(f, ctx);
+            status |= gr_one(g, ctx);
+            status |= _gr_vec_zero(GR_ENTRY(f, 1, sz), n - 1, ctx);
+            status |= _gr_vec_zero(GR_ENTRY(g, 1, sz), n - 1, ctx);
+            return status;
+        }
+        else
+        {
+            status |= _gr_poly_exp_series(f, h, hlen, n, ctx);
+            if (status == GR_SUCCESS)
+                status |= _gr_poly_inv_series(g, f, n, n, ctx);
+            return status;
+        }
+    }
+
+    while (m < n && status == GR_SUCCESS)
+    {
+        k = FLINT_MIN(n, 2 * m);
+
+        if (op == GR_POLY_LAZY_SERIES_INV)
+        {
+            if (k - m <= LAZY_SERIES_BASECASE_STEP)
+                status |= _gr_poly_lazy_series_inv_basecase(f, h, hlen, m, k, ctx);
+            else
+                status |= _gr_poly_lazy_series_inv_newton(f, h, hlen, m, k, ctx);
+        }
+        else
+        {
+            if (k - m <= LAZY_SERIES_BASECASE_STEP)
+                status |= _gr_poly_lazy_series_exp_basecase(f, g, h, hlen, m, k, ctx);
+            else
+                status |= _gr_poly_lazy_series_exp_newton(f, g, h, hlen, m, k, ctx);
+        }
+
+        m = k;
+    }
+
+    return status;
+}
+
+void
+gr_poly_lazy_series_init(gr_poly_lazy_series_t S, gr_ctx_t ctx)
+{
+    gr_poly_init(S->input, ctx);
+    gr_poly_init(S->res, ctx);
+    gr_poly_init(S->aux, ctx);
+    S->len = 0;
+    S->input_len = WORD_MAX;
+    S->op = GR_POLY_LAZY_SERIES_INV;
+}
+
+void
+gr_poly_lazy_series_clear(gr_poly_lazy_series_t S, gr_ctx_t ctx)
+{
+    gr_poly_clear(S->input, ctx);
+    gr_poly_clear(S->res, ctx);
+    gr_poly_clear(S->aux, ctx);
+}
+
+int
+gr_poly_lazy_series_set_inv(gr_poly_lazy_series_t S, const gr_poly_t Q, gr_ctx_t ctx)
+{
+    S->len = 0;
+    S->input_len = WORD_MAX;
+    S->op = GR_POLY_LAZY_SERIES_INV;
+    return gr_poly_set(S->input, Q, ctx);
+}
+
+int
+gr_poly_lazy_series_set_exp(gr_poly_lazy_series_t S, const gr_poly_t h, gr_ctx_t ctx)
+{
+    S->len = 0;
+    S->input_len = WORD_MAX;
+    S->op = GR_POLY_LAZY_SERIES_EXP;
+    return gr_poly_set(S->input, h, ctx);
+}
+
+int
+gr_poly_lazy_series_set_input(gr_poly_lazy_series_t S, const gr_poly_t h, gr_ctx_t ctx)
+{
+    S->input_len = h->length;
+    return gr_poly_set(S->input, h, ctx);
+}
+
+int
+gr_poly_lazy_series_fit_length(gr_poly_lazy_series_t S, slong len, gr_ctx_t ctx)
+{
+    int status;
+
+    if (len <= S->len)
+        return GR_SUCCESS;
+
+    gr_poly_fit_length(S->res, len, ctx);
+    if (S->op == GR_POLY_LAZY_SERIES_EXP)
+        gr_poly_fit_length(S->aux, len, ctx);
+
+    status = _gr_poly_lazy_series_extend(S->res->coeffs, S->aux->coeffs,
+                    S->input->coeffs, S->input->length, S->op, S->len, len, ctx);
+
+    if (status == GR_SUCCESS)
+        S->len = len;
+
+    return status;
+}
+
+int
+gr_poly_lazy_series_get_coeff(gr_ptr c, gr_poly_lazy_series_t S, slong i, gr_ctx_t ctx)
+{
+    int status = GR_SUCCESS;
+
+    /* extend geometrically so that reading coefficients one at a time
+       costs O(M(n)) in total, but not past the input supplied so far,
+       which may still be incomplete; the doubled length may also not be
+       computable (e.g. exp past the characteristic), in which case
+       extend exactly */
+    if (i >= S->len)
+    {
+        slong len = FLINT_MAX(i + 1, FLINT_MIN(2 * S->len, S->input_len));
+
+        status = gr_poly_lazy_series_fit_length(S, len, ctx);
+        if (status != GR_SUCCESS && len > i + 1)
+            status = gr_poly_lazy_series_fit_length(S, i + 1, ctx);
+    }
+
+    if (status == GR_SUCCESS)
+        status |= gr_set(c, GR_ENTRY(S->res->coeffs, i, ctx->sizeof_elem), ctx);
+
+    return status;
+}
+
+int
+gr_poly_lazy_series_get_series(gr_poly_t res, gr_poly_lazy_series_t S, slong len, gr_ctx_t ctx)
+{
+    int status;
+
+    status = gr_poly_lazy_series_fit_length(S, len, ctx);
+
+    if (status == GR_SUCCESS)
+    {
+        gr_poly_fit_length(res, len, ctx);
+        status |= _gr_vec_set(res->coeffs, S->res->coeffs, len, ctx);
+        _gr_poly_set_length(res, len, ctx);
+        _gr_poly_normalise(res, ctx);
+    }
+
+    return status;
+}
@@ -0,0 +1,208 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "gr_poly.h"
+
+FLINT_DLL extern gr_static_method_table _ca_methods;
+
+int
+test_lazy_series(flint_rand_t state)
+{
+    gr_ctx_t ctx;
+    gr_poly_lazy_series_t S;
+    gr_poly_t a, b, c;
+    slong i, j, n, maxlen;
+    int op, status = GR_SUCCESS;
+
+    gr_ctx_init_random(ctx, state);
+
+    if (ctx->methods == _ca_methods)
+        maxlen = 8;
+    else
+        maxlen = 100;
+
+    gr_poly_lazy_series_init(S, ctx);
+    gr_poly_init(a, ctx);
+    gr_poly_init(b, ctx);
+    gr_poly_init(c, ctx);
+
+    op = n_randint(state, 2) ? GR_POLY_LAZY_SERIES_INV : GR_POLY_LAZY_SERIES_EXP;
+
+    GR_MUST_SUCCEED(gr_poly_randtest(a, state, 1 + n_randint(state, maxlen), ctx));
+
+    if (op == GR_POLY_LAZY_SERIES_INV)
+    {
+        if (n_randint(state, 4) != 0)
+            status |= gr_poly_set_coeff_si(a, 0, 1, ctx);
+        status |= gr_poly_lazy_series_set_inv(S, a, ctx);
+    }
+    else
+    {
+        if (n_randint(state, 4) != 0)
+            status |= gr_poly_set_coeff_si(a, 0, 0, ctx);
+        status |= gr_poly_lazy_series_set_exp(S, a, ctx);
+    }
+
+    /* extend in random increments, by single coefficients or whole blocks */
+    for (i = 0; i < 6 && status == GR_SUCCESS; i++)
+    {
+        n = n_randint(state, maxlen);
+
+        if (n_randint(state, 2))
+        {
+            status |= gr_poly_lazy_series_get_series(b, S, n, ctx);
+        }
+        else
+        {
+            status |= gr_poly_lazy_series_fit_length(S, FLINT_MIN(n, gr_poly_lazy_series_length(S, ctx) + n_randint(state, 3)), ctx);
+
+            gr_poly_fit_length(b, n, ctx);
+            for (j = 0; j < n && status == GR_SUCCESS; j++)
+                status |= gr_poly_lazy_series_get_coeff(GR_ENTRY(b->coeffs, j, ctx->sizeof_elem), S, j, ctx);
+            _gr_poly_set_length(b, n, ctx);
+            _gr_poly_normalise(b, ctx);
+        }
+
+        if (status == GR_SUCCESS)
+        {
+            if (op == GR_POLY_LAZY_SERIES_INV)
+                status |= gr_poly_inv_series(c, a, n, ctx);
+            else
+                status |= gr_poly_exp_series(c, a, n, ctx);
+
+            if (status == GR_SUCCESS && gr_poly_equal(b, c, ctx) == T_FALSE)
+            {
+                flint_printf("FAIL\n\n");
+                gr_ctx_println(ctx);
+                flint_printf("op = %d, n = %wd\n", op, n);
+                flint_printf("a = "); gr_poly_print(a, ctx); flint_printf("\n\n");
+                flint_printf("b = "); gr_poly_print(b, ctx); flint_printf("\n\n");
+                flint_printf("c = "); gr_poly_print(c, ctx); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+    }
+
+    gr_poly_lazy_series_clear(S, ctx);
+    gr_poly_clear(a, ctx);
+    gr_poly_clear(b, ctx);
+    gr_poly_clear(c, ctx);
+
+    gr_ctx_clear(ctx);
+
+    return status;
+}
+
+/* f = 1/(1 - x f) or f = exp(x f), the input being supplied one term
+   at a time as the output becomes known */
+int
+test_lazy_series_recursive(flint_rand_t state)
+{
+    gr_ctx_t ctx;
+    gr_poly_lazy_series_t S;
+    gr_poly_t a, b, c;
+    slong j, n;
+    int op, status = GR_SUCCESS;
+
+    gr_ctx_init_random(ctx, state);
+
+    if (ctx->methods == _ca_methods)
+        n = n_randint(state, 8);
+    else
+        n = n_randint(state, 100);
+
+    gr_poly_lazy_series_init(S, ctx);
+    gr_poly_init(a, ctx);
+    gr_poly_init(b, ctx);
+    gr_poly_init(c, ctx);
+
+    op = n_randint(state, 2) ? GR_POLY_LAZY_SERIES_INV : GR_POLY_LAZY_SERIES_EXP;
+
+    if (op == GR_POLY_LAZY_SERIES_INV)
+    {
+        status |= gr_poly_one(a, ctx);
+        status |= gr_poly_lazy_series_set_inv(S, a, ctx);
+    }
+    else
+    {
+        status |= gr_poly_lazy_series_set_exp(S, a, ctx);
+    }
+
+    gr_poly_fit_length(b, n, ctx);
+
+    for (j = 0; j < n && status == GR_SUCCESS; j++)
+    {
+        if (j > 0)
+        {
+            if (op == GR_POLY_LAZY_SERIES_INV)
+                status |= gr_neg(GR_ENTRY(b->coeffs, j, ctx->sizeof_elem), GR_ENTRY(b->coeffs, j - 1, ctx->sizeof_elem), ctx);
+            else
+                status |= gr_set(GR_ENTRY(b->coeffs, j, ctx->sizeof_elem), GR_ENTRY(b->coeffs, j - 1, ctx->sizeof_elem), ctx);
+
+            status |= gr_poly_set_coeff_scalar(a, j, GR_ENTRY(b->coeffs, j, ctx->sizeof_elem), ctx);
+            status |= gr_poly_lazy_series_set_input(S, a, ctx);
+        }
+
+        status |= gr_poly_lazy_series_get_coeff(GR_ENTRY(b->coeffs, j, ctx->sizeof_elem), S, j, ctx);
+    }
+
+    if (status == GR_SUCCESS)
+    {
+        _gr_poly_set_length(b, n, ctx);
+        _gr_poly_normalise(b, ctx);
+
+        if (op == GR_POLY_LAZY_SERIES_INV)
+            status |= gr_poly_inv_series(c, a, n, ctx);
+        else
+            status |= gr_poly_exp_series(c, a, n, ctx);
+
+        if (status == GR_SUCCESS && gr_poly_equal(b, c, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL (recursive)\n\n");
+            gr_ctx_println(ctx);
+            flint_printf("op = %d, n = %wd\n", op, n);
+            flint_printf("a = "); gr_poly_print(a, ctx); flint_printf("\n\n");
+            flint_printf("b = "); gr_poly_print(b, ctx); flint_printf("\n\n");
+            flint_printf("c = "); gr_poly_print(c, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+    }
+
+    gr_poly_lazy_series_clear(S, ctx);
+    gr_poly_clear(a, ctx);
+    gr_poly_clear(b, ctx);
+    gr_poly_clear(c, ctx);
+
+    gr_ctx_clear(ctx);
+
+    return status;
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("lazy_series....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        test_lazy_series(state);
+        test_lazy_series_recursive(state);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -38,7 +38,7 @@ typedef struct
     ulong sieve_b;
     slong sieve_i;
     slong sieve_num;
-    char * sieve;
+    unsigned char * sieve;
 }
 n_primes_struct;
 
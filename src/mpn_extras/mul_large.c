@@ -20,6 +20,16 @@
 #define FLINT_FFT_SMALL_MUL_THRESHOLD 400
 #define FLINT_FFT_SMALL_SQR_THRESHOLD 800
 
+/* Products of at least this many limbs keep their transforms in
+   scratch files; see flint_mpn_mul_set_disk_threshold. */
+static mp_size_t flint_mpn_mul_disk_threshold = WORD_MAX;
+static const char * flint_mpn_mul_disk_dir = NULL;
+
+void flint_mpn_mul_set_disk_threshold(mp_size_t limbs, const char * dir)
+{
+    flint_mpn_mul_disk_threshold = (limbs <= 0) ? WORD_MAX : limbs;
+    flint_mpn_mul_disk_dir = dir;
+}
 
 
 
@@ -54,7 +64,11 @@ mp_limb_t flint_mpn_mul_large(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
         return flint_mpn_mul_large(r1, i2, n2, i1, n1);
 #endif
 
-    if (n2 < FLINT_FFT_SMALL_MUL_THRESHOLD || (i1 == i2 && n1 == n2 && n2 < FLINT_FFT_SMALL_SQR_THRESHOLD))
+    if (FLINT_UNLIKELY(n1 + n2 >= flint_mpn_mul_disk_threshold))
+    {
+        flint_mpn_mul_fft_disk(r1, i1, n1, i2, n2, flint_mpn_mul_disk_dir);
+    }
+    else if (n2 < FLINT_FFT_SMALL_MUL_THRESHOLD || (i1 == i2 && n1 == n2 && n2 < FLINT_FFT_SMALL_SQR_THRESHOLD))
     {
         if (n1 == n2)
             if (i1 == i2)
@@ -77,7 +91,11 @@ mp_limb_t flint_mpn_mul_large(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
 mp_limb_t flint_mpn_mul_large(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2)
 {
-    if (n2 < FLINT_FFT_MUL_THRESHOLD)
+    if (FLINT_UNLIKELY(n1 + n2 >= flint_mpn_mul_disk_threshold))
+    {
+        flint_mpn_mul_fft_disk(r1, i1, n1, i2, n2, flint_mpn_mul_disk_dir);
+    }
+    else if (n2 < FLINT_FFT_MUL_THRESHOLD)
     {
         if (n1 == n2)
             if (i1 == i2)
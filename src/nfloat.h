@@ -0,0 +1,181 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef NFLOAT_H
+#define NFLOAT_H
+
+#ifdef NFLOAT_INLINES_C
+#define NFLOAT_INLINE
+#else
+#define NFLOAT_INLINE static __inline__
+#endif
+
+#include <string.h>
+#include "mpn_extras.h"
+#include "arf_types.h"
+#include "gr.h"
+#include "gr_mat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    An nfloat with n limbs is stored as n + 2 consecutive limbs: the
+    exponent, the sign bit and the n limbs of the mantissa, least
+    significant first. A nonzero value is (-1)^sgnbit * 0.d * 2^exp
+    with the top bit of d[n - 1] set, as for arf.
+*/
+
+#define NFLOAT_MIN_LIMBS 1
+#define NFLOAT_MAX_LIMBS 33
+#define NFLOAT_HEADER_LIMBS 2
+
+#define NFLOAT_MIN_EXP (-(WORD_MAX / 4))
+#define NFLOAT_MAX_EXP (WORD_MAX / 4)
+#define NFLOAT_EXP_ZERO WORD_MIN
+
+/* context flags */
+#define NFLOAT_ALLOW_UNDERFLOW 1
+
+typedef struct
+{
+    ulong head[NFLOAT_HEADER_LIMBS];
+    ulong d[NFLOAT_MAX_LIMBS];
+}
+nfloat_struct;
+
+typedef nfloat_struct nfloat_t[1];
+
+typedef void * nfloat_ptr;
+typedef const void * nfloat_srcptr;
+
+#define NFLOAT_CTX_NLIMBS(ctx) (((slong *)((ctx)->data))[0])
+#define NFLOAT_CTX_FLAGS(ctx) (((slong *)((ctx)->data))[1])
+#define NFLOAT_CTX_PREC(ctx) (NFLOAT_CTX_NLIMBS(ctx) * FLINT_BITS)
+
+#define NFLOAT_EXP(x) (((slong *) (x))[0])
+#define NFLOAT_SGNBIT(x) (((ulong *) (x))[1])
+#define NFLOAT_D(x) (((mp_ptr) (x)) + NFLOAT_HEADER_LIMBS)
+#define NFLOAT_IS_ZERO(x) (NFLOAT_EXP(x) == NFLOAT_EXP_ZERO)
+
+/* Context */
+
+int nfloat_ctx_init(gr_ctx_t ctx, slong prec, int flags);
+
+/* Memory management and basic assignment */
+
+NFLOAT_INLINE int
+nfloat_zero(nfloat_ptr res, gr_ctx_t ctx)
+{
+    NFLOAT_EXP(res) = NFLOAT_EXP_ZERO;
+    NFLOAT_SGNBIT(res) = 0;
+    return GR_SUCCESS;
+}
+
+NFLOAT_INLINE void
+nfloat_init(nfloat_ptr res, gr_ctx_t ctx)
+{
+    nfloat_zero(res, ctx);
+}
+
+NFLOAT_INLINE void
+nfloat_clear(nfloat_ptr res, gr_ctx_t ctx)
+{
+}
+
+NFLOAT_INLINE int
+nfloat_set(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    if (res != x)
+        memcpy(res, x, ctx->sizeof_elem);
+    return GR_SUCCESS;
+}
+
+NFLOAT_INLINE void
+nfloat_swap(nfloat_ptr x, nfloat_ptr y, gr_ctx_t ctx)
+{
+    nfloat_struct t;
+    memcpy(&t, x, ctx->sizeof_elem);
+    memcpy(x, y, ctx->sizeof_elem);
+    memcpy(y, &t, ctx->sizeof_elem);
+}
+
+int _nfloat_set_mpn_2exp(nfloat_ptr res, slong exp, mp_srcptr x, slong xn, int sgnbit, gr_ctx_t ctx);
+
+int nfloat_one(nfloat_ptr res, gr_ctx_t ctx);
+int nfloat_neg_one(nfloat_ptr res, gr_ctx_t ctx);
+int nfloat_set_ui(nfloat_ptr res, ulong x, gr_ctx_t ctx);
+int nfloat_set_si(nfloat_ptr res, slong x, gr_ctx_t ctx);
+int nfloat_set_fmpz(nfloat_ptr res, const fmpz_t x, gr_ctx_t ctx);
+int nfloat_set_arf(nfloat_ptr res, const arf_t x, gr_ctx_t ctx);
+int nfloat_get_arf(arf_t res, nfloat_srcptr x, gr_ctx_t ctx);
+int nfloat_set_d(nfloat_ptr res, double x, gr_ctx_t ctx);
+int nfloat_get_d(double * res, nfloat_srcptr x, gr_ctx_t ctx);
+
+int nfloat_randtest(nfloat_ptr res, flint_rand_t state, gr_ctx_t ctx);
+int nfloat_write(gr_stream_t out, nfloat_srcptr x, gr_ctx_t ctx);
+
+/* Comparisons */
+
+NFLOAT_INLINE truth_t
+nfloat_is_zero(nfloat_srcptr x, gr_ctx_t ctx)
+{
+    return NFLOAT_IS_ZERO(x) ? T_TRUE : T_FALSE;
+}
+
+truth_t nfloat_is_one(nfloat_srcptr x, gr_ctx_t ctx);
+truth_t nfloat_is_neg_one(nfloat_srcptr x, gr_ctx_t ctx);
+truth_t nfloat_equal(nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_cmp(int * res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_cmpabs(int * res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_sgn(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx);
+
+/* Arithmetic */
+
+NFLOAT_INLINE int
+nfloat_neg(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    nfloat_set(res, x, ctx);
+    if (!NFLOAT_IS_ZERO(res))
+        NFLOAT_SGNBIT(res) ^= 1;
+    return GR_SUCCESS;
+}
+
+NFLOAT_INLINE int
+nfloat_abs(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    nfloat_set(res, x, ctx);
+    NFLOAT_SGNBIT(res) = 0;
+    return GR_SUCCESS;
+}
+
+int nfloat_add(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_sub(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_mul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_sqr(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx);
+int nfloat_addmul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_submul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_div(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx);
+int nfloat_inv(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx);
+int nfloat_sqrt(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx);
+int nfloat_mul_2exp_si(nfloat_ptr res, nfloat_srcptr x, slong y, gr_ctx_t ctx);
+
+/* Vectors and matrices */
+
+int _nfloat_vec_dot(nfloat_ptr res, nfloat_srcptr initial, int subtract, nfloat_srcptr x, nfloat_srcptr y, slong len, gr_ctx_t ctx);
+int _nfloat_vec_dot_rev(nfloat_ptr res, nfloat_srcptr initial, int subtract, nfloat_srcptr x, nfloat_srcptr y, slong len, gr_ctx_t ctx);
+
+int nfloat_mat_mul(gr_mat_t C, const gr_mat_t A, const gr_mat_t B, gr_ctx_t ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,200 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "arf.h"
+#include "gr_generic.h"
+#include "nfloat.h"
+
+static int
+_nfloat_ctx_write(gr_stream_t out, gr_ctx_t ctx)
+{
+    gr_stream_write(out, "Floating-point numbers (nfloat, prec = ");
+    gr_stream_write_si(out, NFLOAT_CTX_PREC(ctx));
+    gr_stream_write(out, ")");
+    return GR_SUCCESS;
+}
+
+static int
+_nfloat_ctx_get_real_prec(slong * res, gr_ctx_t ctx)
+{
+    *res = NFLOAT_CTX_PREC(ctx);
+    return GR_SUCCESS;
+}
+
+/* the element size depends on the precision */
+static int
+_nfloat_ctx_set_real_prec(gr_ctx_t ctx, slong prec)
+{
+    return GR_UNABLE;
+}
+
+static void
+_nfloat_set_shallow(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    nfloat_set(res, x, ctx);
+}
+
+static int
+_nfloat_im(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    return nfloat_zero(res, ctx);
+}
+
+static int
+_nfloat_set_other(nfloat_ptr res, gr_srcptr x, gr_ctx_t x_ctx, gr_ctx_t ctx)
+{
+    gr_ctx_t RR;
+    arf_t t;
+    int status;
+
+    if (x_ctx->which_ring == GR_CTX_NFLOAT)
+    {
+        if (NFLOAT_CTX_NLIMBS(x_ctx) == NFLOAT_CTX_NLIMBS(ctx))
+            return nfloat_set(res, x, ctx);
+
+        arf_init(t);
+        nfloat_get_arf(t, x, x_ctx);
+        status = nfloat_set_arf(res, t, ctx);
+        arf_clear(t);
+        return status;
+    }
+
+    if (x_ctx->which_ring == GR_CTX_FMPZ)
+        return nfloat_set_fmpz(res, x, ctx);
+
+    if (x_ctx->which_ring == GR_CTX_REAL_FLOAT_ARF)
+        return nfloat_set_arf(res, x, ctx);
+
+    gr_ctx_init_real_float_arf(RR, NFLOAT_CTX_PREC(ctx) + 20);
+    arf_init(t);
+
+    status = gr_set_other(t, x, x_ctx, RR);
+    if (status == GR_SUCCESS)
+        status = nfloat_set_arf(res, t, ctx);
+
+    arf_clear(t);
+    gr_ctx_clear(RR);
+    return status;
+}
+
+int _nfloat_methods_initialized = 0;
+
+gr_static_method_table _nfloat_methods;
+
+gr_method_tab_input _nfloat_methods_input[] =
+{
+    {GR_METHOD_CTX_WRITE,       (gr_funcptr) _nfloat_ctx_write},
+    {GR_METHOD_CTX_IS_RING,     (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_COMMUTATIVE_RING, (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_INTEGRAL_DOMAIN,  (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_FIELD,            (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_UNIQUE_FACTORIZATION_DOMAIN,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_FINITE,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_FINITE_CHARACTERISTIC,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_ALGEBRAICALLY_CLOSED,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_ORDERED_RING,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_EXACT,    (gr_funcptr) gr_generic_ctx_predicate_false},
+    {GR_METHOD_CTX_IS_CANONICAL,
+                                (gr_funcptr) gr_generic_ctx_predicate_false},
+
+    {GR_METHOD_CTX_HAS_REAL_PREC, (gr_funcptr) gr_generic_ctx_predicate_true},
+    {GR_METHOD_CTX_SET_REAL_PREC, (gr_funcptr) _nfloat_ctx_set_real_prec},
+    {GR_METHOD_CTX_GET_REAL_PREC, (gr_funcptr) _nfloat_ctx_get_real_prec},
+
+    {GR_METHOD_INIT,            (gr_funcptr) nfloat_init},
+    {GR_METHOD_CLEAR,           (gr_funcptr) nfloat_clear},
+    {GR_METHOD_SWAP,            (gr_funcptr) nfloat_swap},
+    {GR_METHOD_SET_SHALLOW,     (gr_funcptr) _nfloat_set_shallow},
+    {GR_METHOD_RANDTEST,        (gr_funcptr) nfloat_randtest},
+    {GR_METHOD_WRITE,           (gr_funcptr) nfloat_write},
+    {GR_METHOD_ZERO,            (gr_funcptr) nfloat_zero},
+    {GR_METHOD_ONE,             (gr_funcptr) nfloat_one},
+    {GR_METHOD_NEG_ONE,         (gr_funcptr) nfloat_neg_one},
+    {GR_METHOD_IS_ZERO,         (gr_funcptr) nfloat_is_zero},
+    {GR_METHOD_IS_ONE,          (gr_funcptr) nfloat_is_one},
+    {GR_METHOD_IS_NEG_ONE,      (gr_funcptr) nfloat_is_neg_one},
+    {GR_METHOD_EQUAL,           (gr_funcptr) nfloat_equal},
+    {GR_METHOD_SET,             (gr_funcptr) nfloat_set},
+    {GR_METHOD_SET_SI,          (gr_funcptr) nfloat_set_si},
+    {GR_METHOD_SET_UI,          (gr_funcptr) nfloat_set_ui},
+    {GR_METHOD_SET_FMPZ,        (gr_funcptr) nfloat_set_fmpz},
+    {GR_METHOD_SET_D,           (gr_funcptr) nfloat_set_d},
+    {GR_METHOD_SET_OTHER,       (gr_funcptr) _nfloat_set_other},
+    {GR_METHOD_GET_D,           (gr_funcptr) nfloat_get_d},
+
+    {GR_METHOD_NEG,             (gr_funcptr) nfloat_neg},
+    {GR_METHOD_ADD,             (gr_funcptr) nfloat_add},
+    {GR_METHOD_SUB,             (gr_funcptr) nfloat_sub},
+    {GR_METHOD_MUL,             (gr_funcptr) nfloat_mul},
+    {GR_METHOD_ADDMUL,          (gr_funcptr) nfloat_addmul},
+    {GR_METHOD_SUBMUL,          (gr_funcptr) nfloat_submul},
+    {GR_METHOD_SQR,             (gr_funcptr) nfloat_sqr},
+    {GR_METHOD_DIV,             (gr_funcptr) nfloat_div},
+    {GR_METHOD_INV,             (gr_funcptr) nfloat_inv},
+    {GR_METHOD_MUL_2EXP_SI,     (gr_funcptr) nfloat_mul_2exp_si},
+    {GR_METHOD_SQRT,            (gr_funcptr) nfloat_sqrt},
+
+    {GR_METHOD_POS_INF,         (gr_funcptr) gr_not_in_domain},
+    {GR_METHOD_NEG_INF,         (gr_funcptr) gr_not_in_domain},
+    {GR_METHOD_UINF,            (gr_funcptr) gr_not_in_domain},
+    {GR_METHOD_UNDEFINED,       (gr_funcptr) gr_not_in_domain},
+    {GR_METHOD_UNKNOWN,         (gr_funcptr) gr_not_in_domain},
+
+    {GR_METHOD_ABS,             (gr_funcptr) nfloat_abs},
+    {GR_METHOD_CONJ,            (gr_funcptr) nfloat_set},
+    {GR_METHOD_RE,              (gr_funcptr) nfloat_set},
+    {GR_METHOD_IM,              (gr_funcptr) _nfloat_im},
+    {GR_METHOD_SGN,             (gr_funcptr) nfloat_sgn},
+    {GR_METHOD_CSGN,            (gr_funcptr) nfloat_sgn},
+    {GR_METHOD_CMP,             (gr_funcptr) nfloat_cmp},
+    {GR_METHOD_CMPABS,          (gr_funcptr) nfloat_cmpabs},
+    {GR_METHOD_I,               (gr_funcptr) gr_not_in_domain},
+
+    {GR_METHOD_VEC_DOT,         (gr_funcptr) _nfloat_vec_dot},
+    {GR_METHOD_VEC_DOT_REV,     (gr_funcptr) _nfloat_vec_dot_rev},
+
+    {GR_METHOD_MAT_MUL,         (gr_funcptr) nfloat_mat_mul},
+    {GR_METHOD_MAT_DET,         (gr_funcptr) gr_mat_det_generic_field},
+    {GR_METHOD_MAT_FIND_NONZERO_PIVOT,     (gr_funcptr) gr_mat_find_nonzero_pivot_large_abs},
+
+    {0,                         (gr_funcptr) NULL},
+};
+
+int
+nfloat_ctx_init(gr_ctx_t ctx, slong prec, int flags)
+{
+    slong nlimbs;
+
+    if (prec <= 0 || prec > NFLOAT_MAX_LIMBS * FLINT_BITS)
+        return GR_UNABLE;
+
+    nlimbs = (prec + FLINT_BITS - 1) / FLINT_BITS;
+
+    ctx->which_ring = GR_CTX_NFLOAT;
+    ctx->sizeof_elem = sizeof(ulong) * (nlimbs + NFLOAT_HEADER_LIMBS);
+    ctx->size_limit = WORD_MAX;
+
+    NFLOAT_CTX_NLIMBS(ctx) = nlimbs;
+    NFLOAT_CTX_FLAGS(ctx) = flags;
+
+    ctx->methods = _nfloat_methods;
+
+    if (!_nfloat_methods_initialized)
+    {
+        gr_method_tab_init(_nfloat_methods, _nfloat_methods_input);
+        _nfloat_methods_initialized = 1;
+    }
+
+    return GR_SUCCESS;
+}
@@ -0,0 +1,202 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nfloat.h"
+
+/*
+    The terms are added in fixed-point accumulators of n + 2 limbs
+    relative to the largest exponent E among the terms, one for positive
+    and one for negative terms: the top limb holds carries and the n + 1
+    lower limbs the fractional part. Each term is truncated at
+    2^(E - (n + 1) FLINT_BITS), so the error is bounded by
+    (len + 2) ulp(2^E) / 2^FLINT_BITS plus the final truncation to n limbs.
+*/
+
+/* acc += x >> shift where x has n + 1 limbs; x is clobbered */
+static void
+_nfloat_acc_add(mp_ptr acc, mp_ptr x, slong n, slong shift)
+{
+    slong q, xn;
+    unsigned int r;
+
+    q = shift / FLINT_BITS;
+    r = shift % FLINT_BITS;
+    xn = n + 1 - q;
+
+    if (r != 0)
+        mpn_rshift(x, x + q, xn, r);
+    else if (q != 0)
+        flint_mpn_copyi(x, x + q, xn);
+
+    mpn_add(acc, acc, n + 2, x, xn);
+}
+
+/* (t1, t0) = (p1, p0) >> shift for 0 <= shift < 2 FLINT_BITS */
+#define RSHIFT2(t1, t0, p1, p0, shift) \
+    do { \
+        if ((shift) == 0) \
+        { \
+            (t0) = (p0); (t1) = (p1); \
+        } \
+        else if ((shift) < FLINT_BITS) \
+        { \
+            (t0) = ((p0) >> (shift)) | ((p1) << (FLINT_BITS - (shift))); \
+            (t1) = (p1) >> (shift); \
+        } \
+        else \
+        { \
+            (t0) = (p1) >> ((shift) - FLINT_BITS); \
+            (t1) = 0; \
+        } \
+    } while (0)
+
+static int
+_nfloat_dot(nfloat_ptr res, nfloat_srcptr initial, int subtract, nfloat_srcptr x, nfloat_srcptr y, slong ystride, slong len, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    slong sz = ctx->sizeof_elem;
+    slong i, e, E, shift;
+    nfloat_srcptr xi, yi;
+    ulong pos[NFLOAT_MAX_LIMBS + 2];
+    ulong neg[NFLOAT_MAX_LIMBS + 2];
+    ulong t[2 * NFLOAT_MAX_LIMBS];
+    mp_ptr acc;
+    int sgnbit;
+
+    subtract = (subtract != 0);
+    E = WORD_MIN;
+
+    if (initial != NULL && !NFLOAT_IS_ZERO(initial))
+        E = NFLOAT_EXP(initial);
+
+    for (i = 0, xi = x, yi = y; i < len; i++)
+    {
+        if (!NFLOAT_IS_ZERO(xi) && !NFLOAT_IS_ZERO(yi))
+        {
+            e = NFLOAT_EXP(xi) + NFLOAT_EXP(yi);
+            E = FLINT_MAX(E, e);
+        }
+
+        xi = (const char *) xi + sz;
+        yi = (const char *) yi + ystride;
+    }
+
+    if (E == WORD_MIN)
+        return nfloat_zero(res, ctx);
+
+    flint_mpn_zero(pos, n + 2);
+    flint_mpn_zero(neg, n + 2);
+
+    if (initial != NULL && !NFLOAT_IS_ZERO(initial))
+    {
+        shift = E - NFLOAT_EXP(initial);
+
+        if (shift < (n + 1) * FLINT_BITS)
+        {
+            t[0] = 0;
+            flint_mpn_copyi(t + 1, NFLOAT_D(initial), n);
+            _nfloat_acc_add(NFLOAT_SGNBIT(initial) ? neg : pos, t, n, shift);
+        }
+    }
+
+    for (i = 0, xi = x, yi = y; i < len; i++)
+    {
+        if (!NFLOAT_IS_ZERO(xi) && !NFLOAT_IS_ZERO(yi))
+        {
+            shift = E - (NFLOAT_EXP(xi) + NFLOAT_EXP(yi));
+
+            if (shift < (n + 1) * FLINT_BITS)
+            {
+                sgnbit = NFLOAT_SGNBIT(xi) ^ NFLOAT_SGNBIT(yi) ^ subtract;
+                acc = sgnbit ? neg : pos;
+
+                if (n == 1)
+                {
+                    ulong p1, p0, t1, t0;
+
+                    umul_ppmm(p1, p0, NFLOAT_D(xi)[0], NFLOAT_D(yi)[0]);
+                    RSHIFT2(t1, t0, p1, p0, shift);
+                    add_sssaaaaaa(acc[2], acc[1], acc[0], acc[2], acc[1], acc[0], 0, t1, t0);
+                }
+                else if (n == 2)
+                {
+                    mp_srcptr xd = NFLOAT_D(xi), yd = NFLOAT_D(yi);
+                    ulong p3, p2, p1, t2, t1, t0, h, l;
+
+                    /* top three limbs of the product */
+                    umul_ppmm(p1, t0, xd[0], yd[0]);
+                    umul_ppmm(p3, p2, xd[1], yd[1]);
+                    umul_ppmm(h, l, xd[0], yd[1]);
+                    add_sssaaaaaa(p3, p2, p1, p3, p2, p1, 0, h, l);
+                    umul_ppmm(h, l, xd[1], yd[0]);
+                    add_sssaaaaaa(p3, p2, p1, p3, p2, p1, 0, h, l);
+
+                    if (shift < FLINT_BITS)
+                    {
+                        if (shift == 0)
+                        {
+                            t0 = p1; t1 = p2; t2 = p3;
+                        }
+                        else
+                        {
+                            t0 = (p1 >> shift) | (p2 << (FLINT_BITS - shift));
+                            t1 = (p2 >> shift) | (p3 << (FLINT_BITS - shift));
+                            t2 = p3 >> shift;
+                        }
+                    }
+                    else
+                    {
+                        shift -= FLINT_BITS;
+                        RSHIFT2(t1, t0, p3, p2, shift);
+                        t2 = 0;
+                    }
+
+                    add_ssssaaaaaaaa(acc[3], acc[2], acc[1], acc[0],
+                        acc[3], acc[2], acc[1], acc[0], 0, t2, t1, t0);
+                }
+                else
+                {
+                    flint_mpn_mul_n(t, NFLOAT_D(xi), NFLOAT_D(yi), n);
+                    /* only the top n + 1 limbs of the product are used */
+                    _nfloat_acc_add(acc, t + n - 1, n, shift);
+                }
+            }
+        }
+
+        xi = (const char *) xi + sz;
+        yi = (const char *) yi + ystride;
+    }
+
+    if (mpn_cmp(pos, neg, n + 2) >= 0)
+    {
+        mpn_sub_n(pos, pos, neg, n + 2);
+        return _nfloat_set_mpn_2exp(res, E + FLINT_BITS, pos, n + 2, 0, ctx);
+    }
+    else
+    {
+        mpn_sub_n(neg, neg, pos, n + 2);
+        return _nfloat_set_mpn_2exp(res, E + FLINT_BITS, neg, n + 2, 1, ctx);
+    }
+}
+
+int
+_nfloat_vec_dot(nfloat_ptr res, nfloat_srcptr initial, int subtract, nfloat_srcptr x, nfloat_srcptr y, slong len, gr_ctx_t ctx)
+{
+    return _nfloat_dot(res, initial, subtract, x, y, ctx->sizeof_elem, len, ctx);
+}
+
+int
+_nfloat_vec_dot_rev(nfloat_ptr res, nfloat_srcptr initial, int subtract, nfloat_srcptr x, nfloat_srcptr y, slong len, gr_ctx_t ctx)
+{
+    if (len <= 0)
+        return _nfloat_dot(res, initial, subtract, x, y, 0, 0, ctx);
+
+    return _nfloat_dot(res, initial, subtract, x,
+        (const char *) y + (len - 1) * ctx->sizeof_elem, -ctx->sizeof_elem, len, ctx);
+}
@@ -0,0 +1,102 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "nfloat.h"
+
+/* below this number of limb products, use a single thread */
+#define NFLOAT_MAT_MUL_THREAD_CUTOFF 100000
+
+typedef struct
+{
+    gr_mat_struct * C;
+    const gr_mat_struct * A;
+    nfloat_srcptr BT;
+    int * status;
+    gr_ctx_struct * ctx;
+}
+_mat_mul_arg_t;
+
+static void
+_nfloat_mat_mul_row(slong i, void * arg_ptr)
+{
+    _mat_mul_arg_t * arg = (_mat_mul_arg_t *) arg_ptr;
+    gr_ctx_struct * ctx = arg->ctx;
+    slong sz = ctx->sizeof_elem;
+    slong j, br = arg->A->c, bc = arg->C->c;
+    int status = GR_SUCCESS;
+
+    for (j = 0; j < bc; j++)
+        status |= _nfloat_vec_dot(GR_MAT_ENTRY(arg->C, i, j, sz), NULL, 0,
+            arg->A->rows[i], GR_ENTRY(arg->BT, j * br, sz), br, ctx);
+
+    arg->status[i] = status;
+}
+
+int
+nfloat_mat_mul(gr_mat_t C, const gr_mat_t A, const gr_mat_t B, gr_ctx_t ctx)
+{
+    slong ar, ac, br, bc, i, j, sz, n;
+    _mat_mul_arg_t arg;
+    int status, thread_limit;
+    gr_ptr BT;
+
+    ar = A->r;
+    ac = A->c;
+    br = B->r;
+    bc = B->c;
+
+    if (ac != br || ar != C->r || bc != C->c)
+        return GR_DOMAIN;
+
+    if (br == 0)
+        return gr_mat_zero(C, ctx);
+
+    if (A == C || B == C)
+    {
+        gr_mat_t T;
+        gr_mat_init(T, ar, bc, ctx);
+        status = nfloat_mat_mul(T, A, B, ctx);
+        status |= gr_mat_swap_entrywise(T, C, ctx);
+        gr_mat_clear(T, ctx);
+        return status;
+    }
+
+    sz = ctx->sizeof_elem;
+    n = NFLOAT_CTX_NLIMBS(ctx);
+
+    /* elements have no heap data, so the transpose is a plain copy */
+    BT = flint_malloc(sz * br * bc);
+
+    for (i = 0; i < br; i++)
+        for (j = 0; j < bc; j++)
+            memcpy(GR_ENTRY(BT, j * br + i, sz), GR_MAT_ENTRY(B, i, j, sz), sz);
+
+    arg.C = C;
+    arg.A = A;
+    arg.BT = BT;
+    arg.status = flint_malloc(sizeof(int) * ar);
+    arg.ctx = ctx;
+
+    if ((double) ar * bc * br * n * n < NFLOAT_MAT_MUL_THREAD_CUTOFF)
+        thread_limit = 1;
+    else
+        thread_limit = -1;
+
+    flint_parallel_do(_nfloat_mat_mul_row, &arg, ar, thread_limit, FLINT_PARALLEL_UNIFORM);
+
+    status = GR_SUCCESS;
+    for (i = 0; i < ar; i++)
+        status |= arg.status[i];
+
+    flint_free(arg.status);
+    flint_free(BT);
+
+    return status;
+}
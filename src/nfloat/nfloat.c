@@ -0,0 +1,532 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "double_extras.h"
+#include "fmpz.h"
+#include "arf.h"
+#include "nfloat.h"
+
+/*
+    All operations truncate the exact result (or an approximation
+    carrying at least one guard limb) to the precision of the context,
+    so results are within a few ulp but not correctly rounded.
+*/
+
+static int
+_nfloat_underflow(nfloat_ptr res, gr_ctx_t ctx)
+{
+    if (NFLOAT_CTX_FLAGS(ctx) & NFLOAT_ALLOW_UNDERFLOW)
+        return nfloat_zero(res, ctx);
+
+    return GR_UNABLE;
+}
+
+/* res = (-1)^sgnbit * 0.x * 2^exp where x has xn limbs (possibly with
+   leading zero limbs) and 0.x denotes x / 2^(xn * FLINT_BITS) */
+int
+_nfloat_set_mpn_2exp(nfloat_ptr res, slong exp, mp_srcptr x, slong xn, int sgnbit, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    mp_ptr d = NFLOAT_D(res);
+    unsigned int c;
+
+    while (xn > 0 && x[xn - 1] == 0)
+    {
+        xn--;
+        exp -= FLINT_BITS;
+    }
+
+    if (xn == 0)
+        return nfloat_zero(res, ctx);
+
+    c = flint_clz(x[xn - 1]);
+    exp -= c;
+
+    if (xn >= n)
+    {
+        if (c == 0)
+        {
+            flint_mpn_copyi(d, x + xn - n, n);
+        }
+        else
+        {
+            mpn_lshift(d, x + xn - n, n, c);
+            if (xn > n)
+                d[0] |= x[xn - n - 1] >> (FLINT_BITS - c);
+        }
+    }
+    else
+    {
+        flint_mpn_zero(d, n - xn);
+        if (c == 0)
+            flint_mpn_copyi(d + n - xn, x, xn);
+        else
+            mpn_lshift(d + n - xn, x, xn, c);
+    }
+
+    if (exp > NFLOAT_MAX_EXP)
+        return GR_UNABLE;
+    if (exp < NFLOAT_MIN_EXP)
+        return _nfloat_underflow(res, ctx);
+
+    NFLOAT_EXP(res) = exp;
+    NFLOAT_SGNBIT(res) = sgnbit;
+    return GR_SUCCESS;
+}
+
+int
+nfloat_set_ui(nfloat_ptr res, ulong x, gr_ctx_t ctx)
+{
+    return _nfloat_set_mpn_2exp(res, FLINT_BITS, &x, 1, 0, ctx);
+}
+
+int
+nfloat_set_si(nfloat_ptr res, slong x, gr_ctx_t ctx)
+{
+    ulong t = (x < 0) ? -(ulong) x : x;
+    return _nfloat_set_mpn_2exp(res, FLINT_BITS, &t, 1, x < 0, ctx);
+}
+
+int
+nfloat_one(nfloat_ptr res, gr_ctx_t ctx)
+{
+    return nfloat_set_ui(res, 1, ctx);
+}
+
+int
+nfloat_neg_one(nfloat_ptr res, gr_ctx_t ctx)
+{
+    return nfloat_set_si(res, -1, ctx);
+}
+
+int
+nfloat_set_arf(nfloat_ptr res, const arf_t x, gr_ctx_t ctx)
+{
+    mp_srcptr xp;
+    mp_size_t xn;
+
+    if (arf_is_zero(x))
+        return nfloat_zero(res, ctx);
+
+    if (!arf_is_finite(x))
+        return GR_DOMAIN;
+
+    if (COEFF_IS_MPZ(ARF_EXP(x)))
+    {
+        if (fmpz_sgn(ARF_EXPREF(x)) > 0)
+            return GR_UNABLE;
+        return _nfloat_underflow(res, ctx);
+    }
+
+    ARF_GET_MPN_READONLY(xp, xn, x);
+    return _nfloat_set_mpn_2exp(res, ARF_EXP(x), xp, xn, ARF_SGNBIT(x), ctx);
+}
+
+int
+nfloat_get_arf(arf_t res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+
+    if (NFLOAT_IS_ZERO(x))
+    {
+        arf_zero(res);
+    }
+    else
+    {
+        arf_set_mpn(res, NFLOAT_D(x), n, NFLOAT_SGNBIT(x));
+        arf_mul_2exp_si(res, res, NFLOAT_EXP(x) - n * FLINT_BITS);
+    }
+
+    return GR_SUCCESS;
+}
+
+int
+nfloat_set_fmpz(nfloat_ptr res, const fmpz_t x, gr_ctx_t ctx)
+{
+    if (!COEFF_IS_MPZ(*x))
+    {
+        return nfloat_set_si(res, *x, ctx);
+    }
+    else
+    {
+        arf_t t;
+        int status;
+        arf_init(t);
+        arf_set_round_fmpz(t, x, NFLOAT_CTX_PREC(ctx), ARF_RND_DOWN);
+        status = nfloat_set_arf(res, t, ctx);
+        arf_clear(t);
+        return status;
+    }
+}
+
+int
+nfloat_set_d(nfloat_ptr res, double x, gr_ctx_t ctx)
+{
+    arf_t t;
+    int status;
+
+    if (!(x > -D_INF && x < D_INF))
+        return GR_DOMAIN;
+
+    arf_init(t);
+    arf_set_d(t, x);
+    status = nfloat_set_arf(res, t, ctx);
+    arf_clear(t);
+    return status;
+}
+
+int
+nfloat_get_d(double * res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    arf_t t;
+    arf_init(t);
+    nfloat_get_arf(t, x, ctx);
+    *res = arf_get_d(t, ARF_RND_NEAR);
+    arf_clear(t);
+    return GR_SUCCESS;
+}
+
+int
+nfloat_randtest(nfloat_ptr res, flint_rand_t state, gr_ctx_t ctx)
+{
+    arf_t t;
+    int status;
+
+    arf_init(t);
+    if (n_randint(state, 4) == 0)
+        arf_set_si(t, (slong) n_randint(state, 21) - 10);
+    else
+        arf_randtest(t, state, NFLOAT_CTX_PREC(ctx), 10);
+    status = nfloat_set_arf(res, t, ctx);
+    arf_clear(t);
+    return status;
+}
+
+int
+nfloat_write(gr_stream_t out, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    arf_t t;
+    arf_init(t);
+    nfloat_get_arf(t, x, ctx);
+    gr_stream_write_free(out, arf_get_str(t, NFLOAT_CTX_PREC(ctx) * 0.30102999566398 + 1));
+    arf_clear(t);
+    return GR_SUCCESS;
+}
+
+truth_t
+nfloat_equal(nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+
+    if (NFLOAT_EXP(x) != NFLOAT_EXP(y))
+        return T_FALSE;
+
+    if (NFLOAT_IS_ZERO(x))
+        return T_TRUE;
+
+    if (NFLOAT_SGNBIT(x) != NFLOAT_SGNBIT(y))
+        return T_FALSE;
+
+    return (mpn_cmp(NFLOAT_D(x), NFLOAT_D(y), n) == 0) ? T_TRUE : T_FALSE;
+}
+
+static int
+_nfloat_is_pm_one(nfloat_srcptr x, int sgnbit, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    mp_srcptr d = NFLOAT_D(x);
+
+    if (NFLOAT_EXP(x) != 1 || NFLOAT_SGNBIT(x) != sgnbit)
+        return 0;
+
+    if (d[n - 1] != UWORD(1) << (FLINT_BITS - 1))
+        return 0;
+
+    return flint_mpn_zero_p(d, n - 1);
+}
+
+truth_t
+nfloat_is_one(nfloat_srcptr x, gr_ctx_t ctx)
+{
+    return _nfloat_is_pm_one(x, 0, ctx) ? T_TRUE : T_FALSE;
+}
+
+truth_t
+nfloat_is_neg_one(nfloat_srcptr x, gr_ctx_t ctx)
+{
+    return _nfloat_is_pm_one(x, 1, ctx) ? T_TRUE : T_FALSE;
+}
+
+static int
+_nfloat_cmpabs(nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    if (NFLOAT_IS_ZERO(x))
+        return NFLOAT_IS_ZERO(y) ? 0 : -1;
+
+    if (NFLOAT_IS_ZERO(y))
+        return 1;
+
+    if (NFLOAT_EXP(x) != NFLOAT_EXP(y))
+        return (NFLOAT_EXP(x) < NFLOAT_EXP(y)) ? -1 : 1;
+
+    return mpn_cmp(NFLOAT_D(x), NFLOAT_D(y), NFLOAT_CTX_NLIMBS(ctx));
+}
+
+int
+nfloat_cmpabs(int * res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    int c = _nfloat_cmpabs(x, y, ctx);
+    *res = (c > 0) - (c < 0);
+    return GR_SUCCESS;
+}
+
+int
+nfloat_cmp(int * res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    int sx, sy, c;
+
+    sx = NFLOAT_IS_ZERO(x) ? 0 : (NFLOAT_SGNBIT(x) ? -1 : 1);
+    sy = NFLOAT_IS_ZERO(y) ? 0 : (NFLOAT_SGNBIT(y) ? -1 : 1);
+
+    if (sx != sy || sx == 0)
+    {
+        *res = (sx > sy) - (sx < sy);
+    }
+    else
+    {
+        c = _nfloat_cmpabs(x, y, ctx);
+        c = (c > 0) - (c < 0);
+        *res = (sx > 0) ? c : -c;
+    }
+
+    return GR_SUCCESS;
+}
+
+int
+nfloat_sgn(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_zero(res, ctx);
+
+    return NFLOAT_SGNBIT(x) ? nfloat_neg_one(res, ctx) : nfloat_one(res, ctx);
+}
+
+/* |x| + |y| or |x| - |y| with the sign of x, assuming both nonzero */
+static int
+_nfloat_add_sub_nonzero(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, int subtract, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    slong ex, ey, delta, q;
+    unsigned int r;
+    int sgnbit;
+    ulong t[NFLOAT_MAX_LIMBS + 2];
+    ulong u[NFLOAT_MAX_LIMBS + 1];
+
+    ex = NFLOAT_EXP(x);
+    ey = NFLOAT_EXP(y);
+    sgnbit = NFLOAT_SGNBIT(x);
+
+    if (ex < ey || (ex == ey && subtract &&
+            mpn_cmp(NFLOAT_D(x), NFLOAT_D(y), n) < 0))
+    {
+        nfloat_srcptr tmp = x;
+        x = y;
+        y = tmp;
+        delta = ex;
+        ex = ey;
+        ey = delta;
+        sgnbit ^= subtract;
+    }
+
+    delta = ex - ey;
+
+    /* y is below the guard limb */
+    if (delta >= (n + 1) * FLINT_BITS)
+    {
+        nfloat_set(res, x, ctx);
+        NFLOAT_SGNBIT(res) = sgnbit;
+        return GR_SUCCESS;
+    }
+
+    /* t = x with a guard limb, u = y aligned with t */
+    t[0] = 0;
+    flint_mpn_copyi(t + 1, NFLOAT_D(x), n);
+    t[n + 1] = 0;
+
+    q = delta / FLINT_BITS;
+    r = delta % FLINT_BITS;
+
+    u[0] = 0;
+    flint_mpn_copyi(u + 1, NFLOAT_D(y), n);
+
+    if (q != 0)
+    {
+        flint_mpn_copyi(u, u + q, n + 1 - q);
+        flint_mpn_zero(u + n + 1 - q, q);
+    }
+
+    if (r != 0)
+        mpn_rshift(u, u, n + 1 - q, r);
+
+    if (subtract)
+        mpn_sub_n(t, t, u, n + 1);
+    else
+        t[n + 1] = mpn_add_n(t, t, u, n + 1);
+
+    return _nfloat_set_mpn_2exp(res, ex + FLINT_BITS, t, n + 2, sgnbit, ctx);
+}
+
+int
+nfloat_add(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_set(res, y, ctx);
+
+    if (NFLOAT_IS_ZERO(y))
+        return nfloat_set(res, x, ctx);
+
+    return _nfloat_add_sub_nonzero(res, x, y, NFLOAT_SGNBIT(x) != NFLOAT_SGNBIT(y), ctx);
+}
+
+int
+nfloat_sub(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_neg(res, y, ctx);
+
+    if (NFLOAT_IS_ZERO(y))
+        return nfloat_set(res, x, ctx);
+
+    return _nfloat_add_sub_nonzero(res, x, y, NFLOAT_SGNBIT(x) == NFLOAT_SGNBIT(y), ctx);
+}
+
+int
+nfloat_mul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    ulong t[2 * NFLOAT_MAX_LIMBS];
+
+    if (NFLOAT_IS_ZERO(x) || NFLOAT_IS_ZERO(y))
+        return nfloat_zero(res, ctx);
+
+    if (n == 1)
+        umul_ppmm(t[1], t[0], NFLOAT_D(x)[0], NFLOAT_D(y)[0]);
+    else if (x == y)
+        flint_mpn_sqr(t, NFLOAT_D(x), n);
+    else
+        flint_mpn_mul_n(t, NFLOAT_D(x), NFLOAT_D(y), n);
+
+    return _nfloat_set_mpn_2exp(res, NFLOAT_EXP(x) + NFLOAT_EXP(y), t, 2 * n,
+        NFLOAT_SGNBIT(x) ^ NFLOAT_SGNBIT(y), ctx);
+}
+
+int
+nfloat_sqr(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    return nfloat_mul(res, x, x, ctx);
+}
+
+int
+nfloat_addmul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    nfloat_struct t;
+    int status;
+
+    status = nfloat_mul(&t, x, y, ctx);
+    status |= nfloat_add(res, res, &t, ctx);
+    return status;
+}
+
+int
+nfloat_submul(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    nfloat_struct t;
+    int status;
+
+    status = nfloat_mul(&t, x, y, ctx);
+    status |= nfloat_sub(res, res, &t, ctx);
+    return status;
+}
+
+int
+nfloat_div(nfloat_ptr res, nfloat_srcptr x, nfloat_srcptr y, gr_ctx_t ctx)
+{
+    slong n = NFLOAT_CTX_NLIMBS(ctx);
+    ulong a[2 * NFLOAT_MAX_LIMBS + 1];
+    ulong q[NFLOAT_MAX_LIMBS + 2];
+    ulong r[NFLOAT_MAX_LIMBS];
+
+    if (NFLOAT_IS_ZERO(y))
+        return GR_DOMAIN;
+
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_zero(res, ctx);
+
+    /* q = floor(0.x / 0.y * 2^((n + 1) * FLINT_BITS)) < 2^((n + 1) * FLINT_BITS + 1) */
+    flint_mpn_zero(a, n + 1);
+    flint_mpn_copyi(a + n + 1, NFLOAT_D(x), n);
+    mpn_tdiv_qr(q, r, 0, a, 2 * n + 1, NFLOAT_D(y), n);
+
+    return _nfloat_set_mpn_2exp(res, NFLOAT_EXP(x) - NFLOAT_EXP(y) + FLINT_BITS,
+        q, n + 2, NFLOAT_SGNBIT(x) ^ NFLOAT_SGNBIT(y), ctx);
+}
+
+int
+nfloat_inv(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    nfloat_struct t;
+    nfloat_one(&t, ctx);
+    return nfloat_div(res, &t, x, ctx);
+}
+
+int
+nfloat_sqrt(nfloat_ptr res, nfloat_srcptr x, gr_ctx_t ctx)
+{
+    arf_t t;
+    int status;
+
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_zero(res, ctx);
+
+    if (NFLOAT_SGNBIT(x))
+        return GR_DOMAIN;
+
+    arf_init(t);
+    nfloat_get_arf(t, x, ctx);
+    arf_sqrt(t, t, NFLOAT_CTX_PREC(ctx), ARF_RND_DOWN);
+    status = nfloat_set_arf(res, t, ctx);
+    arf_clear(t);
+    return status;
+}
+
+int
+nfloat_mul_2exp_si(nfloat_ptr res, nfloat_srcptr x, slong y, gr_ctx_t ctx)
+{
+    slong exp;
+
+    if (NFLOAT_IS_ZERO(x))
+        return nfloat_zero(res, ctx);
+
+    if (y > 2 * NFLOAT_MAX_EXP)
+        return GR_UNABLE;
+
+    if (y < 2 * NFLOAT_MIN_EXP)
+        return _nfloat_underflow(res, ctx);
+
+    exp = NFLOAT_EXP(x) + y;
+
+    if (exp > NFLOAT_MAX_EXP)
+        return GR_UNABLE;
+    if (exp < NFLOAT_MIN_EXP)
+        return _nfloat_underflow(res, ctx);
+
+    nfloat_set(res, x, ctx);
+    NFLOAT_EXP(res) = exp;
+    return GR_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "arf.h"
+#include "nfloat.h"
+
+/* |x - y| <= 2^(e - prec + 1) where |y| < 2^e */
+static int
+_close(const arf_t x, const arf_t y, slong prec)
+{
+    arf_t t;
+    int res;
+
+    if (arf_is_zero(y))
+        return arf_is_zero(x);
+
+    arf_init(t);
+    arf_sub(t, x, y, ARF_PREC_EXACT, ARF_RND_DOWN);
+    res = arf_cmpabs_2exp_si(t, arf_abs_bound_lt_2exp_si(y) - prec + 1) <= 0;
+    arf_clear(t);
+    return res;
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("arith....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        gr_ctx_t ctx;
+        nfloat_struct x, y, z;
+        arf_t a, b, c, d;
+        slong prec;
+        int op, cmp1, cmp2, status;
+
+        if (n_randint(state, 4) == 0)
+            prec = 1 + n_randint(state, NFLOAT_MAX_LIMBS * FLINT_BITS);
+        else
+            prec = 1 + n_randint(state, 4 * FLINT_BITS);
+
+        if (nfloat_ctx_init(ctx, prec, 0) != GR_SUCCESS)
+            flint_abort();
+
+        prec = NFLOAT_CTX_PREC(ctx);
+
+        arf_init(a);
+        arf_init(b);
+        arf_init(c);
+        arf_init(d);
+
+        status = nfloat_randtest(&x, state, ctx);
+        status |= nfloat_randtest(&y, state, ctx);
+
+        /* cancellation */
+        if (n_randint(state, 4) == 0)
+        {
+            nfloat_get_arf(a, &x, ctx);
+            arf_mul_2exp_si(b, a, -(slong) n_randint(state, prec + 10));
+            if (n_randint(state, 2))
+                arf_neg(b, b);
+            arf_add(b, b, a, prec, ARF_RND_DOWN);
+            if (n_randint(state, 2))
+                arf_neg(b, b);
+            status |= nfloat_set_arf(&y, b, ctx);
+        }
+
+        nfloat_get_arf(a, &x, ctx);
+        nfloat_get_arf(b, &y, ctx);
+
+        /* conversion round trip */
+        status |= nfloat_set_arf(&z, a, ctx);
+        if (nfloat_equal(&z, &x, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL: round trip\n");
+            arf_printd(a, 50); flint_printf("\n");
+            flint_abort();
+        }
+
+        nfloat_cmp(&cmp1, &x, &y, ctx);
+        cmp2 = arf_cmp(a, b);
+        if (cmp1 != cmp2)
+        {
+            flint_printf("FAIL: cmp\n");
+            arf_printd(a, 50); flint_printf("\n");
+            arf_printd(b, 50); flint_printf("\n");
+            flint_abort();
+        }
+
+        op = n_randint(state, 4);
+
+        switch (op)
+        {
+            case 0:
+                status |= nfloat_add(&z, &x, &y, ctx);
+                arf_add(c, a, b, ARF_PREC_EXACT, ARF_RND_DOWN);
+                break;
+            case 1:
+                status |= nfloat_sub(&z, &x, &y, ctx);
+                arf_sub(c, a, b, ARF_PREC_EXACT, ARF_RND_DOWN);
+                break;
+            case 2:
+                status |= nfloat_mul(&z, &x, &y, ctx);
+                arf_mul(c, a, b, ARF_PREC_EXACT, ARF_RND_DOWN);
+                break;
+            default:
+                if (arf_is_zero(b))
+                {
+                    if (nfloat_div(&z, &x, &y, ctx) != GR_DOMAIN)
+                    {
+                        flint_printf("FAIL: division by zero\n");
+                        flint_abort();
+                    }
+                    nfloat_zero(&z, ctx);
+                    arf_zero(c);
+                }
+                else
+                {
+                    status |= nfloat_div(&z, &x, &y, ctx);
+                    arf_div(c, a, b, prec + 100, ARF_RND_DOWN);
+                }
+                break;
+        }
+
+        nfloat_get_arf(d, &z, ctx);
+
+        if (status != GR_SUCCESS || !_close(d, c, prec))
+        {
+            flint_printf("FAIL: op = %d, prec = %wd\n\n", op, prec);
+            flint_printf("a = "); arf_printd(a, 50); flint_printf("\n\n");
+            flint_printf("b = "); arf_printd(b, 50); flint_printf("\n\n");
+            flint_printf("c = "); arf_printd(c, 50); flint_printf("\n\n");
+            flint_printf("d = "); arf_printd(d, 50); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* aliasing */
+        if (op == 0)
+        {
+            status |= nfloat_add(&x, &x, &y, ctx);
+            if (nfloat_equal(&x, &z, ctx) != T_TRUE)
+            {
+                flint_printf("FAIL: aliasing\n");
+                flint_abort();
+            }
+        }
+
+        arf_clear(a);
+        arf_clear(b);
+        arf_clear(c);
+        arf_clear(d);
+
+        gr_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "arf.h"
+#include "gr_vec.h"
+#include "nfloat.h"
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("dot....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        gr_ctx_t ctx;
+        gr_ptr x, y;
+        nfloat_struct s, r;
+        arf_t a, b, t, exact, res;
+        slong i, len, prec, sz, bound;
+        int subtract, initial, reverse, status;
+
+        if (n_randint(state, 4) == 0)
+            prec = 1 + n_randint(state, NFLOAT_MAX_LIMBS * FLINT_BITS);
+        else
+            prec = 1 + n_randint(state, 4 * FLINT_BITS);
+
+        if (nfloat_ctx_init(ctx, prec, 0) != GR_SUCCESS)
+            flint_abort();
+
+        prec = NFLOAT_CTX_PREC(ctx);
+        sz = ctx->sizeof_elem;
+        len = n_randint(state, 30);
+        subtract = n_randint(state, 2);
+        initial = n_randint(state, 2);
+        reverse = n_randint(state, 2);
+
+        x = gr_heap_init_vec(len, ctx);
+        y = gr_heap_init_vec(len, ctx);
+
+        arf_init(a);
+        arf_init(b);
+        arf_init(t);
+        arf_init(exact);
+        arf_init(res);
+
+        status = GR_SUCCESS;
+        for (i = 0; i < len; i++)
+        {
+            status |= nfloat_randtest(GR_ENTRY(x, i, sz), state, ctx);
+            status |= nfloat_randtest(GR_ENTRY(y, i, sz), state, ctx);
+        }
+        status |= nfloat_randtest(&s, state, ctx);
+
+        /* exact result, and a bound 2^bound for all terms and the result */
+        bound = WORD_MIN;
+
+        if (initial)
+        {
+            nfloat_get_arf(exact, &s, ctx);
+            if (!arf_is_zero(exact))
+                bound = arf_abs_bound_lt_2exp_si(exact);
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            nfloat_get_arf(a, GR_ENTRY(x, i, sz), ctx);
+            nfloat_get_arf(b, GR_ENTRY(y, reverse ? len - 1 - i : i, sz), ctx);
+            arf_mul(t, a, b, ARF_PREC_EXACT, ARF_RND_DOWN);
+            if (!arf_is_zero(t))
+                bound = FLINT_MAX(bound, arf_abs_bound_lt_2exp_si(t));
+            if (subtract)
+                arf_sub(exact, exact, t, ARF_PREC_EXACT, ARF_RND_DOWN);
+            else
+                arf_add(exact, exact, t, ARF_PREC_EXACT, ARF_RND_DOWN);
+        }
+
+        if (!arf_is_zero(exact))
+            bound = FLINT_MAX(bound, arf_abs_bound_lt_2exp_si(exact));
+
+        if (reverse)
+            status |= _nfloat_vec_dot_rev(&r, initial ? &s : NULL, subtract, x, y, len, ctx);
+        else
+            status |= _nfloat_vec_dot(&r, initial ? &s : NULL, subtract, x, y, len, ctx);
+
+        nfloat_get_arf(res, &r, ctx);
+        arf_sub(t, res, exact, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+        if (status != GR_SUCCESS || (bound == WORD_MIN && !arf_is_zero(res)) ||
+            (bound != WORD_MIN && arf_cmpabs_2exp_si(t, bound - prec + 1) > 0))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("prec = %wd, len = %wd, subtract = %d, initial = %d, reverse = %d\n\n",
+                prec, len, subtract, initial, reverse);
+            flint_printf("exact = "); arf_printd(exact, 50); flint_printf("\n\n");
+            flint_printf("res = "); arf_printd(res, 50); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* the gr interface dispatches to the same kernel */
+        if (!reverse)
+        {
+            status |= _gr_vec_dot(&s, initial ? &s : NULL, subtract, x, y, len, ctx);
+
+            if (status != GR_SUCCESS || nfloat_equal(&s, &r, ctx) != T_TRUE)
+            {
+                flint_printf("FAIL: gr_vec_dot\n\n");
+                flint_abort();
+            }
+        }
+
+        arf_clear(a);
+        arf_clear(b);
+        arf_clear(t);
+        arf_clear(exact);
+        arf_clear(res);
+
+        gr_heap_clear_vec(x, len, ctx);
+        gr_heap_clear_vec(y, len, ctx);
+        gr_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return 0;
+}
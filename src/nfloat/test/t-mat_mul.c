@@ -0,0 +1,93 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nfloat.h"
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("mat_mul....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        gr_ctx_t ctx;
+        gr_mat_t A, B, C, D;
+        slong m, n, p, prec;
+        int status;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        prec = 1 + n_randint(state, 8 * FLINT_BITS);
+        if (nfloat_ctx_init(ctx, prec, 0) != GR_SUCCESS)
+            flint_abort();
+
+        m = n_randint(state, 20);
+        n = n_randint(state, 20);
+        p = n_randint(state, 20);
+
+        /* occasionally large enough to use threads */
+        if (n_randint(state, 10) == 0)
+        {
+            m += 40;
+            n += 40;
+            p += 40;
+        }
+
+        gr_mat_init(A, m, n, ctx);
+        gr_mat_init(B, n, p, ctx);
+        gr_mat_init(C, m, p, ctx);
+        gr_mat_init(D, m, p, ctx);
+
+        status = gr_mat_randtest(A, state, ctx);
+        status |= gr_mat_randtest(B, state, ctx);
+        status |= gr_mat_randtest(C, state, ctx);
+
+        status |= nfloat_mat_mul(C, A, B, ctx);
+        status |= gr_mat_mul_classical(D, A, B, ctx);
+
+        if (status != GR_SUCCESS || gr_mat_equal(C, D, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("m = %wd, n = %wd, p = %wd, prec = %wd\n\n", m, n, p, prec);
+            gr_mat_print(A, ctx); flint_printf("\n\n");
+            gr_mat_print(B, ctx); flint_printf("\n\n");
+            gr_mat_print(C, ctx); flint_printf("\n\n");
+            gr_mat_print(D, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* aliasing */
+        if (n == p)
+        {
+            status |= gr_mat_mul(A, A, B, ctx);
+
+            if (status != GR_SUCCESS || gr_mat_equal(A, C, ctx) != T_TRUE)
+            {
+                flint_printf("FAIL: aliasing\n\n");
+                flint_abort();
+            }
+        }
+
+        gr_mat_clear(A, ctx);
+        gr_mat_clear(B, ctx);
+        gr_mat_clear(C, ctx);
+        gr_mat_clear(D, ctx);
+        gr_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
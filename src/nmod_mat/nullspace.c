@@ -11,6 +11,7 @@
 
 #include "nmod.h"
 #include "nmod_mat.h"
+#include "gf2_mat.h"
 
 slong
 nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A)
@@ -24,6 +25,21 @@ nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A)
     m = A->r;
     n = A->c;
 
+    if (A->mod.n == 2)
+    {
+        gf2_mat_t B, Y;
+
+        gf2_mat_init(B, m, n);
+        gf2_mat_init(Y, X->r, X->c);
+        gf2_mat_set_nmod_mat(B, A);
+        nullity = gf2_mat_nullspace(Y, B);
+        gf2_mat_get_nmod_mat(X, Y);
+        gf2_mat_clear(B);
+        gf2_mat_clear(Y);
+
+        return nullity;
+    }
+
     p = flint_malloc(sizeof(slong) * FLINT_MAX(m, n));
 
     nmod_mat_init_set(tmp, A);
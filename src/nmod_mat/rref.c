@@ -12,6 +12,7 @@
 #include "perm.h"
 #include "nmod.h"
 #include "nmod_mat.h"
+#include "gf2_mat.h"
 
 slong
 _nmod_mat_rref(nmod_mat_t A, slong * pivots_nonpivots, slong * P)
@@ -138,6 +139,19 @@ nmod_mat_rref(nmod_mat_t A)
         return r;
     }
 
+    if (A->mod.n == 2)
+    {
+        gf2_mat_t B;
+
+        gf2_mat_init(B, A->r, A->c);
+        gf2_mat_set_nmod_mat(B, A);
+        rank = gf2_mat_rref(B);
+        gf2_mat_get_nmod_mat(A, B);
+        gf2_mat_clear(B);
+
+        return rank;
+    }
+
     pivots_nonpivots = flint_malloc(sizeof(slong) * A->c);
     P = _perm_init(nmod_mat_nrows(A));
 
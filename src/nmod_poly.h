@@ -44,6 +44,24 @@ typedef struct
 
 typedef nmod_poly_res_struct nmod_poly_res_t[1];
 
+/* Modulus f with the inverse finv of its reversal, and, when fft_small is
+   available and f is long enough, the transforms needed for reducing
+   modulo f. The coefficients of f and finv are not copied. */
+typedef struct
+{
+    mp_srcptr f;
+    slong lenf;
+    mp_srcptr finv;
+    slong lenfinv;
+    nmod_t mod;
+    void * fft;
+}
+nmod_poly_mod_precomp_struct;
+
+typedef nmod_poly_mod_precomp_struct nmod_poly_mod_precomp_t[1];
+
+#define NMOD_POLY_MOD_PRECOMP_FFT_CUTOFF 200
+
 typedef struct
 {
     nmod_mat_struct * A;
@@ -493,6 +511,23 @@ void nmod_poly_mulmod_preinv(nmod_poly_t res, const nmod_poly_t poly1,
                         const nmod_poly_t poly2, const nmod_poly_t f,
                         const nmod_poly_t finv);
 
+void _nmod_poly_mod_precomp_init(nmod_poly_mod_precomp_t M, mp_srcptr f,
+                    slong lenf, mp_srcptr finv, slong lenfinv, nmod_t mod);
+
+void nmod_poly_mod_precomp_init(nmod_poly_mod_precomp_t M,
+                               const nmod_poly_t f, const nmod_poly_t finv);
+
+void nmod_poly_mod_precomp_clear(nmod_poly_mod_precomp_t M);
+
+void _nmod_poly_divrem_mod_precomp(mp_ptr Q, mp_ptr R, mp_srcptr A,
+                                 slong lenA, const nmod_poly_mod_precomp_t M);
+
+void _nmod_poly_mulmod_precomp(mp_ptr res, mp_srcptr poly1, slong len1,
+           mp_srcptr poly2, slong len2, const nmod_poly_mod_precomp_t M);
+
+void nmod_poly_mulmod_precomp(nmod_poly_t res, const nmod_poly_t poly1,
+                 const nmod_poly_t poly2, const nmod_poly_mod_precomp_t M);
+
 int _nmod_poly_invmod(mp_limb_t *A,
                       const mp_limb_t *B, slong lenB,
                       const mp_limb_t *P, slong lenP, const nmod_t mod);
@@ -785,6 +820,38 @@ void _nmod_poly_interpolate_nmod_vec_fast_precomp(mp_ptr poly, mp_srcptr ys,
 void _nmod_poly_interpolation_weights(mp_ptr w, const mp_ptr * tree,
     slong len, nmod_t mod);
 
+/* Point sets  ***************************************************************/
+
+typedef struct
+{
+    mp_ptr * tree;      /* subproduct tree as built by _nmod_poly_tree_build */
+    mp_ptr root;        /* product of (x - x_i), length len + 1 */
+    mp_ptr rootinv;     /* inverse of the reversal of root mod x^len */
+    mp_ptr weights;     /* 1/root'(x_i), computed on first interpolation */
+    slong len;
+    nmod_t mod;
+}
+nmod_poly_point_set_struct;
+
+typedef nmod_poly_point_set_struct nmod_poly_point_set_t[1];
+
+void nmod_poly_point_set_init(nmod_poly_point_set_t P,
+                                    mp_srcptr xs, slong len, nmod_t mod);
+
+void nmod_poly_point_set_clear(nmod_poly_point_set_t P);
+
+void _nmod_poly_evaluate_nmod_vec_point_set(mp_ptr ys, mp_srcptr poly,
+                             slong plen, const nmod_poly_point_set_t P);
+
+void nmod_poly_evaluate_nmod_vec_point_set(mp_ptr ys,
+                    const nmod_poly_t poly, const nmod_poly_point_set_t P);
+
+void _nmod_poly_interpolate_nmod_vec_point_set(mp_ptr poly,
+                                   mp_srcptr ys, nmod_poly_point_set_t P);
+
+void nmod_poly_interpolate_nmod_vec_point_set(nmod_poly_t poly,
+                                   mp_srcptr ys, nmod_poly_point_set_t P);
+
 /* Composition  **************************************************************/
 
 void _nmod_poly_compose_horner(mp_ptr res, mp_srcptr poly1,
@@ -1116,6 +1183,35 @@ void  _nmod_poly_exp_expinv_series(mp_ptr f, mp_ptr g, mp_srcptr h, slong hlen,
 void _nmod_poly_exp_series(mp_ptr f, mp_srcptr h, slong hlen, slong n, nmod_t mod);
 void nmod_poly_exp_series(nmod_poly_t f, const nmod_poly_t h, slong n);
 
+/* Lazily extended power series  *********************************************/
+
+typedef struct
+{
+    nmod_poly_t input;
+    nmod_poly_t res;
+    nmod_poly_t aux;   /* exp(-input) when res = exp(input) */
+    slong len;              /* number of coefficients of res computed */
+    slong input_len;        /* number of input terms known, or WORD_MAX */
+    int op;
+}
+nmod_poly_lazy_series_struct;
+
+typedef nmod_poly_lazy_series_struct nmod_poly_lazy_series_t[1];
+
+void nmod_poly_lazy_series_init_inv(nmod_poly_lazy_series_t S, const nmod_poly_t Q);
+void nmod_poly_lazy_series_init_exp(nmod_poly_lazy_series_t S, const nmod_poly_t h);
+void nmod_poly_lazy_series_clear(nmod_poly_lazy_series_t S);
+void nmod_poly_lazy_series_set_input(nmod_poly_lazy_series_t S, const nmod_poly_t h);
+void nmod_poly_lazy_series_fit_length(nmod_poly_lazy_series_t S, slong len);
+mp_limb_t nmod_poly_lazy_series_get_coeff_ui(nmod_poly_lazy_series_t S, slong i);
+void nmod_poly_lazy_series_get_series(nmod_poly_t res, nmod_poly_lazy_series_t S, slong len);
+
+NMOD_POLY_INLINE
+slong nmod_poly_lazy_series_length(const nmod_poly_lazy_series_t S)
+{
+    return S->len;
+}
+
 /* Products  *****************************************************************/
 
 void nmod_poly_product_roots_nmod_vec(nmod_poly_t poly, mp_srcptr xs, slong n);
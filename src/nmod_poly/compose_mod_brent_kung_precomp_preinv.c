@@ -104,6 +104,7 @@ _nmod_poly_compose_mod_brent_kung_precomp_preinv(mp_ptr res, mp_srcptr poly1,
                                  mp_srcptr poly3inv, slong len3inv, nmod_t mod)
 {
     nmod_mat_t B, C;
+    nmod_poly_mod_precomp_t M;
     mp_ptr t, h;
     slong i, n, m;
 
@@ -134,6 +135,8 @@ _nmod_poly_compose_mod_brent_kung_precomp_preinv(mp_ptr res, mp_srcptr poly1,
     h = _nmod_vec_init(n);
     t = _nmod_vec_init(n);
 
+    _nmod_poly_mod_precomp_init(M, poly3, len3, poly3inv, len3inv, mod);
+
     /* Set rows of B to the segments of poly1 */
     for (i = 0; i < len1/m; i++)
         _nmod_vec_set(B->rows[i], poly1 + i*m, m);
@@ -144,16 +147,16 @@ _nmod_poly_compose_mod_brent_kung_precomp_preinv(mp_ptr res, mp_srcptr poly1,
 
     /* Evaluate block composition using the Horner scheme */
     _nmod_vec_set(res, C->rows[m - 1], n);
-    _nmod_poly_mulmod_preinv(h, A->rows[m - 1], n, A->rows[1], n,
-                                           poly3, len3, poly3inv, len3inv,mod);
+    _nmod_poly_mulmod_precomp(h, A->rows[m - 1], n, A->rows[1], n, M);
 
     for (i = m - 2; i >= 0; i--)
     {
-        _nmod_poly_mulmod_preinv(t, res, n, h, n, poly3, len3,
-                                                       poly3inv, len3inv, mod);
+        _nmod_poly_mulmod_precomp(t, res, n, h, n, M);
         _nmod_poly_add(res, t, n, C->rows[i], n, mod);
     }
 
+    nmod_poly_mod_precomp_clear(M);
+
     _nmod_vec_clear(h);
     _nmod_vec_clear(t);
 
@@ -23,6 +23,7 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv(nmod_poly_struct * res,
                                    mp_srcptr polyinv, slong leninv, nmod_t mod)
 {
     nmod_mat_t A, B, C;
+    nmod_poly_mod_precomp_t M;
     mp_ptr t, h;
     slong i, j, k, n, m, len2 = l, len1;
 
@@ -39,6 +40,8 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv(nmod_poly_struct * res,
     nmod_mat_init(B, k*len2, m, mod.n);
     nmod_mat_init(C, k*len2, n, mod.n);
 
+    _nmod_poly_mod_precomp_init(M, poly, len, polyinv, leninv, mod);
+
     /* Set rows of B to the segments of polys */
     for (j = 0; j < len2; j++)
     {
@@ -63,8 +66,7 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv(nmod_poly_struct * res,
                                                A->rows[1][0], mod.n, mod.ninv);
     } else
     {
-        _nmod_poly_mulmod_preinv(h, A->rows[m - 1], n, A->rows[1], n, poly,
-                                                    len, polyinv, leninv, mod);
+        _nmod_poly_mulmod_precomp(h, A->rows[m - 1], n, A->rows[1], n, M);
     }
 
     for (j = 0; j < len2; j++)
@@ -84,14 +86,15 @@ _nmod_poly_compose_mod_brent_kung_vec_preinv(nmod_poly_struct * res,
         {
             for (i = 2; i <= k; i++)
             {
-                _nmod_poly_mulmod_preinv(t, res[j].coeffs,
-                                     n, h, n, poly, len, polyinv, leninv, mod);
+                _nmod_poly_mulmod_precomp(t, res[j].coeffs, n, h, n, M);
                 _nmod_poly_add(res[j].coeffs, t, n,
                                                C->rows[(j + 1)*k - i], n, mod);
             }
         }
     }
 
+    nmod_poly_mod_precomp_clear(M);
+
     _nmod_vec_clear(h);
     _nmod_vec_clear(t);
 
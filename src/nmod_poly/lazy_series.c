@@ -0,0 +1,112 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "gr_poly.h"
+
+static void
+_nmod_poly_lazy_series_init(nmod_poly_lazy_series_t S, const nmod_poly_t h, int op)
+{
+    nmod_poly_init_mod(S->input, h->mod);
+    nmod_poly_init_mod(S->res, h->mod);
+    nmod_poly_init_mod(S->aux, h->mod);
+    nmod_poly_set(S->input, h);
+    S->len = 0;
+    S->input_len = WORD_MAX;
+    S->op = op;
+}
+
+void
+nmod_poly_lazy_series_init_inv(nmod_poly_lazy_series_t S, const nmod_poly_t Q)
+{
+    _nmod_poly_lazy_series_init(S, Q, GR_POLY_LAZY_SERIES_INV);
+}
+
+void
+nmod_poly_lazy_series_init_exp(nmod_poly_lazy_series_t S, const nmod_poly_t h)
+{
+    if (h->length > 0 && h->coeffs[0] != UWORD(0))
+        flint_throw(FLINT_ERROR, "Exception (nmod_poly_lazy_series_init_exp). "
+            "Constant term != 0.\n");
+
+    _nmod_poly_lazy_series_init(S, h, GR_POLY_LAZY_SERIES_EXP);
+}
+
+void
+nmod_poly_lazy_series_clear(nmod_poly_lazy_series_t S)
+{
+    nmod_poly_clear(S->input);
+    nmod_poly_clear(S->res);
+    nmod_poly_clear(S->aux);
+}
+
+void
+nmod_poly_lazy_series_set_input(nmod_poly_lazy_series_t S, const nmod_poly_t h)
+{
+    nmod_poly_set(S->input, h);
+    S->input_len = h->length;
+}
+
+static int
+_nmod_poly_lazy_series_fit_length(nmod_poly_lazy_series_t S, slong len)
+{
+    gr_ctx_t ctx;
+
+    if (len <= S->len)
+        return GR_SUCCESS;
+
+    nmod_poly_fit_length(S->res, len);
+    if (S->op == GR_POLY_LAZY_SERIES_EXP)
+        nmod_poly_fit_length(S->aux, len);
+
+    _gr_ctx_init_nmod(ctx, &S->res->mod);
+
+    if (_gr_poly_lazy_series_extend(S->res->coeffs, S->aux->coeffs,
+            S->input->coeffs, S->input->length, S->op, S->len, len, ctx) != GR_SUCCESS)
+        return GR_DOMAIN;
+
+    S->len = len;
+    return GR_SUCCESS;
+}
+
+void
+nmod_poly_lazy_series_fit_length(nmod_poly_lazy_series_t S, slong len)
+{
+    if (_nmod_poly_lazy_series_fit_length(S, len) != GR_SUCCESS)
+        flint_throw(FLINT_ERROR, "Exception (nmod_poly_lazy_series_fit_length). "
+            "Constant term is not invertible or division by zero.\n");
+}
+
+mp_limb_t
+nmod_poly_lazy_series_get_coeff_ui(nmod_poly_lazy_series_t S, slong i)
+{
+    /* as for gr_poly_lazy_series_get_coeff, never extend past the input
+       supplied so far, and fall back to extending exactly */
+    if (i >= S->len)
+    {
+        slong len = FLINT_MAX(i + 1, FLINT_MIN(2 * S->len, S->input_len));
+
+        if (_nmod_poly_lazy_series_fit_length(S, len) != GR_SUCCESS)
+            nmod_poly_lazy_series_fit_length(S, i + 1);
+    }
+
+    return S->res->coeffs[i];
+}
+
+void
+nmod_poly_lazy_series_get_series(nmod_poly_t res, nmod_poly_lazy_series_t S, slong len)
+{
+    nmod_poly_lazy_series_fit_length(S, len);
+
+    nmod_poly_fit_length(res, len);
+    _nmod_vec_set(res->coeffs, S->res->coeffs, len);
+    res->length = len;
+    _nmod_poly_normalise(res);
+}
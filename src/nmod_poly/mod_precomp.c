@@ -0,0 +1,164 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+#ifdef FLINT_HAVE_FFT_SMALL
+#include "fft_small.h"
+#endif
+
+void
+_nmod_poly_mod_precomp_init(nmod_poly_mod_precomp_t M, mp_srcptr f,
+                     slong lenf, mp_srcptr finv, slong lenfinv, nmod_t mod)
+{
+    M->f = f;
+    M->lenf = lenf;
+    M->finv = finv;
+    M->lenfinv = lenfinv;
+    M->mod = mod;
+    M->fft = NULL;
+
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (lenf >= NMOD_POLY_MOD_PRECOMP_FFT_CUTOFF)
+    {
+        nmod_poly_divrem_precomp_struct * P;
+        mp_ptr t = NULL;
+
+        /* quotients have length at most lenf - 2 */
+        if (lenfinv < lenf - 1)
+        {
+            t = _nmod_vec_init(2 * lenf - 1);
+            _nmod_poly_reverse(t, f, lenf, lenf);
+            _nmod_poly_inv_series(t + lenf, t, lenf, lenf - 1, mod);
+            finv = t + lenf;
+        }
+
+        P = flint_malloc(sizeof(nmod_poly_divrem_precomp_struct));
+        _nmod_poly_divrem_precomp_init_preinv(P, f, lenf, finv, lenf - 1,
+                                                   mod, get_default_mpn_ctx());
+        M->fft = P;
+
+        if (t != NULL)
+            _nmod_vec_clear(t);
+    }
+#endif
+}
+
+void
+nmod_poly_mod_precomp_init(nmod_poly_mod_precomp_t M,
+                                const nmod_poly_t f, const nmod_poly_t finv)
+{
+    if (f->length == 0)
+    {
+        flint_printf("Exception (nmod_poly_mod_precomp_init). Divide by zero.\n");
+        flint_abort();
+    }
+
+    _nmod_poly_mod_precomp_init(M, f->coeffs, f->length,
+                                        finv->coeffs, finv->length, f->mod);
+}
+
+void
+nmod_poly_mod_precomp_clear(nmod_poly_mod_precomp_t M)
+{
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL)
+    {
+        _nmod_poly_divrem_precomp_clear(M->fft);
+        flint_free(M->fft);
+    }
+#endif
+}
+
+void
+_nmod_poly_divrem_mod_precomp(mp_ptr Q, mp_ptr R, mp_srcptr A, slong lenA,
+                                               const nmod_poly_mod_precomp_t M)
+{
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL && lenA > M->lenf &&
+        _nmod_poly_divrem_precomp(Q, R, A, lenA, M->fft, M->mod,
+                                                     get_default_mpn_ctx()))
+        return;
+#endif
+
+    _nmod_poly_divrem_newton_n_preinv(Q, R, A, lenA, M->f, M->lenf,
+                                              M->finv, M->lenfinv, M->mod);
+}
+
+void
+_nmod_poly_mulmod_precomp(mp_ptr res, mp_srcptr poly1, slong len1,
+            mp_srcptr poly2, slong len2, const nmod_poly_mod_precomp_t M)
+{
+    mp_ptr T, Q;
+    slong lenT, lenQ;
+
+    lenT = len1 + len2 - 1;
+    lenQ = lenT - M->lenf + 1;
+
+    T = _nmod_vec_init(lenT + lenQ);
+    Q = T + lenT;
+
+    if (len1 >= len2)
+        _nmod_poly_mul(T, poly1, len1, poly2, len2, M->mod);
+    else
+        _nmod_poly_mul(T, poly2, len2, poly1, len1, M->mod);
+
+    _nmod_poly_divrem_mod_precomp(Q, res, T, lenT, M);
+
+    _nmod_vec_clear(T);
+}
+
+void
+nmod_poly_mulmod_precomp(nmod_poly_t res, const nmod_poly_t poly1,
+                  const nmod_poly_t poly2, const nmod_poly_mod_precomp_t M)
+{
+    slong len1, len2, lenf;
+
+    lenf = M->lenf;
+    len1 = poly1->length;
+    len2 = poly2->length;
+
+    if (lenf <= len1 || lenf <= len2)
+    {
+        flint_printf("Exception (nmod_poly_mulmod_precomp). Input larger than modulus.\n");
+        flint_abort();
+    }
+
+    if (lenf == 1 || len1 == 0 || len2 == 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    if (len1 + len2 - 1 < lenf)
+    {
+        nmod_poly_mul(res, poly1, poly2);
+        return;
+    }
+
+    if (res->coeffs == M->f || res->coeffs == M->finv)
+    {
+        nmod_poly_t tmp;
+        nmod_poly_init2_preinv(tmp, M->mod.n, M->mod.ninv, lenf - 1);
+        _nmod_poly_mulmod_precomp(tmp->coeffs, poly1->coeffs, len1,
+                                                poly2->coeffs, len2, M);
+        nmod_poly_swap(res, tmp);
+        nmod_poly_clear(tmp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, lenf - 1);
+        _nmod_poly_mulmod_precomp(res->coeffs, poly1->coeffs, len1,
+                                                poly2->coeffs, len2, M);
+    }
+
+    res->length = lenf - 1;
+    _nmod_poly_normalise(res);
+}
@@ -0,0 +1,261 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void
+nmod_poly_point_set_init(nmod_poly_point_set_t P, mp_srcptr xs, slong len, nmod_t mod)
+{
+    P->len = len;
+    P->mod = mod;
+    P->weights = NULL;
+
+    if (len == 0)
+    {
+        P->tree = NULL;
+        P->root = NULL;
+        P->rootinv = NULL;
+        return;
+    }
+
+    P->tree = _nmod_poly_tree_alloc(len);
+    _nmod_poly_tree_build(P->tree, xs, len, mod);
+
+    P->root = _nmod_vec_init(len + 1);
+    P->rootinv = _nmod_vec_init(len);
+
+    if (len == 1)
+    {
+        _nmod_vec_set(P->root, P->tree[0], 2);
+    }
+    else
+    {
+        slong height = FLINT_CLOG2(len);
+        slong n = WORD(1) << (height - 1);
+
+        _nmod_poly_mul(P->root, P->tree[height - 1], n + 1,
+                           P->tree[height - 1] + (n + 1), len - n + 1, mod);
+    }
+
+    /* the reversal of root has constant term 1 */
+    {
+        mp_ptr t = _nmod_vec_init(len + 1);
+        _nmod_poly_reverse(t, P->root, len + 1, len + 1);
+        _nmod_poly_inv_series(P->rootinv, t, len + 1, len, mod);
+        _nmod_vec_clear(t);
+    }
+}
+
+void
+nmod_poly_point_set_clear(nmod_poly_point_set_t P)
+{
+    if (P->len != 0)
+    {
+        _nmod_poly_tree_free(P->tree, P->len);
+        _nmod_vec_clear(P->root);
+        _nmod_vec_clear(P->rootinv);
+    }
+
+    if (P->weights != NULL)
+        _nmod_vec_clear(P->weights);
+}
+
+/*
+    Coefficients dB, ..., d - 1 of (c, d) times the monic (B, dB + 1), i.e.
+    the transposed multiplication by B. Uses t of length d as scratch.
+*/
+static void
+_nmod_poly_mulmid_monic(mp_ptr res, mp_srcptr c, slong d,
+                            mp_srcptr B, slong dB, mp_ptr t, nmod_t mod)
+{
+    slong i;
+
+    if (dB == 1)
+    {
+        /* B = x + B[0] */
+        for (i = 0; i < d - 1; i++)
+            res[i] = nmod_add(c[i], nmod_mul(c[i + 1], B[0], mod), mod);
+    }
+    else if (d <= 16)
+    {
+        for (i = 0; i < d - dB; i++)
+            res[i] = nmod_add(c[i], _nmod_vec_dot_rev(c + i + 1, B,
+                             dB, mod, _nmod_vec_dot_bound_limbs(dB, mod)), mod);
+    }
+    else
+    {
+        _nmod_poly_mullow(t, c, d, B, dB + 1, d, mod);
+        _nmod_vec_set(res, t + dB, d - dB);
+    }
+}
+
+/*
+    Transposed remainder tree. The vector attached to a node P of degree d
+    holds the coefficients of x^-1, ..., x^-d of the expansion of
+    (f mod P)/P at infinity, in reverse order; for the children A and B of
+    P, those of A are obtained from those of P by transposed multiplication
+    by B and vice versa, and the leaves x - x_i carry f(x_i). This uses only
+    multiplications, against the two divisions per node of
+    _nmod_poly_evaluate_nmod_vec_fast_precomp.
+*/
+void
+_nmod_poly_evaluate_nmod_vec_point_set(mp_ptr ys, mp_srcptr poly,
+                                slong plen, const nmod_poly_point_set_t P)
+{
+    slong len = P->len;
+    nmod_t mod = P->mod;
+    mp_ptr t, u, w, swap, pa, pb, pc;
+    slong i, pow, left;
+
+    if (len == 0)
+        return;
+
+    if (plen == 0)
+    {
+        _nmod_vec_zero(ys, len);
+        return;
+    }
+
+    if (plen == 1)
+    {
+        for (i = 0; i < len; i++)
+            ys[i] = poly[0];
+        return;
+    }
+
+    t = _nmod_vec_init(FLINT_MAX(len, plen));
+    u = _nmod_vec_init(len);
+    w = _nmod_vec_init(len);
+
+    if (plen > len)
+    {
+        _nmod_poly_rem(u, poly, plen, P->root, len + 1, mod);
+        poly = u;
+        plen = len;
+        while (plen > 0 && poly[plen - 1] == 0)
+            plen--;
+        if (plen == 0)
+        {
+            _nmod_vec_zero(ys, len);
+            goto cleanup;
+        }
+    }
+
+    /* at the root: reverse of (rev(f) / rev(root) mod x^plen), padded */
+    _nmod_poly_reverse(w, poly, plen, plen);
+    _nmod_poly_mullow(t, w, plen, P->rootinv, plen, plen, mod);
+    _nmod_poly_reverse(t, t, plen, plen);
+    _nmod_vec_zero(t + plen, len - plen);
+
+    for (i = FLINT_CLOG2(len) - 1; i >= 0; i--)
+    {
+        pow = WORD(1) << i;
+        left = len;
+        pa = P->tree[i];
+        pb = t;
+        pc = u;
+
+        while (left >= 2 * pow)
+        {
+            _nmod_poly_mulmid_monic(pc, pb, 2 * pow, pa + pow + 1, pow, w, mod);
+            _nmod_poly_mulmid_monic(pc + pow, pb, 2 * pow, pa, pow, w, mod);
+
+            pa += 2 * pow + 2;
+            pb += 2 * pow;
+            pc += 2 * pow;
+            left -= 2 * pow;
+        }
+
+        if (left > pow)
+        {
+            _nmod_poly_mulmid_monic(pc, pb, left, pa + pow + 1, left - pow, w, mod);
+            _nmod_poly_mulmid_monic(pc + pow, pb, left, pa, pow, w, mod);
+        }
+        else if (left > 0)
+            _nmod_vec_set(pc, pb, left);
+
+        swap = t;
+        t = u;
+        u = swap;
+    }
+
+    _nmod_vec_set(ys, t, len);
+
+cleanup:
+    _nmod_vec_clear(t);
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(w);
+}
+
+void
+nmod_poly_evaluate_nmod_vec_point_set(mp_ptr ys,
+                    const nmod_poly_t poly, const nmod_poly_point_set_t P)
+{
+    _nmod_poly_evaluate_nmod_vec_point_set(ys, poly->coeffs, poly->length, P);
+}
+
+void
+_nmod_poly_interpolate_nmod_vec_point_set(mp_ptr poly,
+                                    mp_srcptr ys, nmod_poly_point_set_t P)
+{
+    slong i, len = P->len;
+
+    if (len == 0)
+        return;
+
+    if (P->weights == NULL)
+    {
+        mp_ptr w = _nmod_vec_init(len);
+
+        if (len == 1)
+        {
+            w[0] = 1;
+        }
+        else
+        {
+            _nmod_poly_derivative(w, P->root, len + 1, P->mod);
+            _nmod_poly_evaluate_nmod_vec_point_set(w, w, len, P);
+
+            for (i = 0; i < len; i++)
+            {
+                if (n_gcdinv(w + i, w[i], P->mod.n) != 1)
+                {
+                    _nmod_vec_clear(w);
+                    flint_throw(FLINT_ERROR, "Exception (nmod_poly_interpolate_nmod_vec_point_set). "
+                        "Differences of points are not invertible.\n");
+                }
+            }
+        }
+
+        P->weights = w;
+    }
+
+    _nmod_poly_interpolate_nmod_vec_fast_precomp(poly, ys, P->tree,
+                                                     P->weights, len, P->mod);
+}
+
+void
+nmod_poly_interpolate_nmod_vec_point_set(nmod_poly_t poly,
+                                    mp_srcptr ys, nmod_poly_point_set_t P)
+{
+    if (P->len == 0)
+    {
+        nmod_poly_zero(poly);
+    }
+    else
+    {
+        nmod_poly_fit_length(poly, P->len);
+        poly->length = P->len;
+        _nmod_poly_interpolate_nmod_vec_point_set(poly->coeffs, ys, P);
+        _nmod_poly_normalise(poly);
+    }
+}
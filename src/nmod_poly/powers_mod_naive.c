@@ -54,9 +54,15 @@ _nmod_poly_powers_mod_preinv_naive(mp_ptr * res, mp_srcptr f, slong flen, slong
                                                               mod.n, mod.ninv);
     } else
     {
+        nmod_poly_mod_precomp_t M;
+
+        _nmod_poly_mod_precomp_init(M, g, glen, ginv, ginvlen, mod);
+
         for (i = 2; i < n; i++)
-            _nmod_poly_mulmod_preinv(res[i], res[i - 1], glen - 1, res[1],
-                                        glen - 1, g, glen, ginv, ginvlen, mod);
+            _nmod_poly_mulmod_precomp(res[i], res[i - 1], glen - 1, res[1],
+                                                                glen - 1, M);
+
+        nmod_poly_mod_precomp_clear(M);
     }
 }
 
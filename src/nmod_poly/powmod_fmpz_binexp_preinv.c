@@ -22,6 +22,7 @@ _nmod_poly_powmod_fmpz_binexp_preinv (mp_ptr res, mp_srcptr poly, fmpz_t e,
             mp_srcptr f, slong lenf, mp_srcptr finv, slong lenfinv, nmod_t mod)
 {
     mp_ptr T, Q;
+    nmod_poly_mod_precomp_t M;
     slong lenT, lenQ;
     slong i, bits;
 
@@ -56,6 +57,8 @@ _nmod_poly_powmod_fmpz_binexp_preinv (mp_ptr res, mp_srcptr poly, fmpz_t e,
     T = _nmod_vec_init(lenT + lenQ);
     Q = T + lenT;
 
+    _nmod_poly_mod_precomp_init(M, f, lenf, finv, lenfinv, mod);
+
     _nmod_vec_set(res, poly, lenf - 1);
 
     bits = fmpz_sizeinbase(e, 2);
@@ -63,18 +66,17 @@ _nmod_poly_powmod_fmpz_binexp_preinv (mp_ptr res, mp_srcptr poly, fmpz_t e,
     {
         _nmod_poly_mul(T, res, lenf - 1, res, lenf - 1, mod);
 
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2*lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, 2*lenf - 3, M);
 
         if (fmpz_tstbit(e, i))
         {
             _nmod_poly_mul(T, res, lenf - 1, poly, lenf - 1, mod);
 
-            _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2 * lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+            _nmod_poly_divrem_mod_precomp(Q, res, T, 2 * lenf - 3, M);
         }
     }
 
+    nmod_poly_mod_precomp_clear(M);
     _nmod_vec_clear(T);
 }
 
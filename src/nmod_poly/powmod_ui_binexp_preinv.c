@@ -21,6 +21,7 @@ _nmod_poly_powmod_ui_binexp_preinv(mp_ptr res, mp_srcptr poly, ulong e,
                     mp_srcptr f, slong lenf, mp_srcptr finv, slong lenfinv, nmod_t mod)
 {
     mp_ptr T, Q;
+    nmod_poly_mod_precomp_t M;
     slong lenT, lenQ, i;
 
     if (lenf == 2)
@@ -35,22 +36,23 @@ _nmod_poly_powmod_ui_binexp_preinv(mp_ptr res, mp_srcptr poly, ulong e,
     T = _nmod_vec_init(lenT + lenQ);
     Q = T + lenT;
 
+    _nmod_poly_mod_precomp_init(M, f, lenf, finv, lenfinv, mod);
+
     _nmod_vec_set(res, poly, lenf - 1);
 
     for (i = FLINT_BIT_COUNT(e) - 2; i >= 0; i--)
     {
         _nmod_poly_mul(T, res, lenf - 1, res, lenf - 1, mod);
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2*lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, 2*lenf - 3, M);
 
         if (e & (UWORD(1) << i))
         {
             _nmod_poly_mul(T, res, lenf - 1, poly, lenf - 1, mod);
-            _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2*lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+            _nmod_poly_divrem_mod_precomp(Q, res, T, 2*lenf - 3, M);
         }
     }
 
+    nmod_poly_mod_precomp_clear(M);
     _nmod_vec_clear(T);
 }
 
@@ -23,6 +23,7 @@ _nmod_poly_powmod_x_fmpz_preinv (mp_ptr res, fmpz_t e, mp_srcptr f, slong lenf,
                                       mp_srcptr finv, slong lenfinv, nmod_t mod)
 {
     mp_ptr T, Q;
+    nmod_poly_mod_precomp_t M;
     slong lenT, lenQ, window;
     slong i, l, c;
 
@@ -32,6 +33,8 @@ _nmod_poly_powmod_x_fmpz_preinv (mp_ptr res, fmpz_t e, mp_srcptr f, slong lenf,
     T = _nmod_vec_init(lenT + lenQ);
     Q = T + lenT;
 
+    _nmod_poly_mod_precomp_init(M, f, lenf, finv, lenfinv, mod);
+
     flint_mpn_zero (res, lenf - 1);
     res[0] = 1;
 
@@ -51,8 +54,7 @@ _nmod_poly_powmod_x_fmpz_preinv (mp_ptr res, fmpz_t e, mp_srcptr f, slong lenf,
     {
         _nmod_poly_shift_left(T, res, lenf - 1, window);
 
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, lenf - 1 + window, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, lenf - 1 + window, M);
 
         c = l + 1;
         window = 0;
@@ -62,8 +64,7 @@ _nmod_poly_powmod_x_fmpz_preinv (mp_ptr res, fmpz_t e, mp_srcptr f, slong lenf,
     {
         _nmod_poly_mul(T, res, lenf - 1, res, lenf - 1, mod);
 
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2*lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, 2*lenf - 3, M);
 
         c--;
 
@@ -81,14 +82,14 @@ _nmod_poly_powmod_x_fmpz_preinv (mp_ptr res, fmpz_t e, mp_srcptr f, slong lenf,
         {
             _nmod_poly_shift_left(T, res, lenf - 1, window);
 
-            _nmod_poly_divrem_newton_n_preinv(Q, res, T, lenf - 1 + window, f,
-                                                     lenf, finv, lenfinv, mod);
+            _nmod_poly_divrem_mod_precomp(Q, res, T, lenf - 1 + window, M);
 
             c = l + 1;
             window = 0;
         }
     }
 
+    nmod_poly_mod_precomp_clear(M);
     _nmod_vec_clear(T);
 }
 
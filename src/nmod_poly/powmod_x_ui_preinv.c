@@ -21,6 +21,7 @@ _nmod_poly_powmod_x_ui_preinv(mp_ptr res, ulong e, mp_srcptr f, slong lenf,
                                      mp_srcptr finv, slong lenfinv, nmod_t mod)
 {
     mp_ptr T, Q;
+    nmod_poly_mod_precomp_t M;
     slong lenT, lenQ, window;
     int i, l, c;
 
@@ -30,6 +31,8 @@ _nmod_poly_powmod_x_ui_preinv(mp_ptr res, ulong e, mp_srcptr f, slong lenf,
     T = _nmod_vec_init(lenT + lenQ);
     Q = T + lenT;
 
+    _nmod_poly_mod_precomp_init(M, f, lenf, finv, lenfinv, mod);
+
     flint_mpn_zero(res, lenf - 1);
     res[0] = 1;
 
@@ -48,8 +51,7 @@ _nmod_poly_powmod_x_ui_preinv(mp_ptr res, ulong e, mp_srcptr f, slong lenf,
     if (c == 0)
     {
         _nmod_poly_shift_left(T, res, lenf - 1, window);
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, lenf - 1 + window, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, lenf - 1 + window, M);
         c = l + 1;
         window = 0;
     }
@@ -57,8 +59,7 @@ _nmod_poly_powmod_x_ui_preinv(mp_ptr res, ulong e, mp_srcptr f, slong lenf,
     for ( ; i >= 0; i--)
     {
         _nmod_poly_mul(T, res, lenf - 1, res, lenf - 1, mod);
-        _nmod_poly_divrem_newton_n_preinv(Q, res, T, 2*lenf - 3, f,
-                                                     lenf, finv, lenfinv, mod);
+        _nmod_poly_divrem_mod_precomp(Q, res, T, 2*lenf - 3, M);
 
         c--;
 
@@ -75,14 +76,14 @@ _nmod_poly_powmod_x_ui_preinv(mp_ptr res, ulong e, mp_srcptr f, slong lenf,
         if (c == 0)
         {
             _nmod_poly_shift_left(T, res, lenf - 1, window);
-            _nmod_poly_divrem_newton_n_preinv(Q, res, T, lenf - 1 + window,
-                                                  f, lenf, finv, lenfinv, mod);
+            _nmod_poly_divrem_mod_precomp(Q, res, T, lenf - 1 + window, M);
 
             c = l + 1;
             window = 0;
         }
     }
 
+    nmod_poly_mod_precomp_clear(M);
     _nmod_vec_clear(T);
 }
 
@@ -0,0 +1,201 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "arith.h"
+
+int
+main(void)
+{
+    int i, result = 1;
+    FLINT_TEST_INIT(state);
+
+
+    flint_printf("lazy_series....");
+    fflush(stdout);
+
+    /* compare with inv_series and exp_series, input revealed incrementally */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_lazy_series_t S;
+        nmod_poly_t A, B, C, T;
+        mp_limb_t mod;
+        slong j, k, n, N = 100;
+        int exp;
+
+        if (n_randint(state, 50) == 0)
+            N = 2000;
+
+        mod = n_randtest_prime(state, 0);
+        exp = n_randint(state, 2);
+        n = 1 + n_randint(state, N);
+        if (exp)
+            n = FLINT_MIN(n, mod);
+
+        nmod_poly_init(A, mod);
+        nmod_poly_init(B, mod);
+        nmod_poly_init(C, mod);
+        nmod_poly_init(T, mod);
+
+        nmod_poly_randtest(A, state, n_randint(state, N));
+        nmod_poly_set_coeff_ui(A, 0, exp ? 0 : n_randint(state, mod - 1) + 1);
+
+        k = n_randint(state, n + 1);
+        nmod_poly_set_trunc(T, A, k);
+
+        if (exp)
+        {
+            nmod_poly_lazy_series_init_exp(S, T);
+            nmod_poly_exp_series(C, A, n);
+        }
+        else
+        {
+            nmod_poly_lazy_series_init_inv(S, T);
+            nmod_poly_inv_series(C, A, n);
+        }
+
+        nmod_poly_lazy_series_fit_length(S, k);
+        nmod_poly_lazy_series_set_input(S, A);
+
+        if (n_randint(state, 2))
+        {
+            nmod_poly_lazy_series_get_series(B, S, n);
+        }
+        else
+        {
+            nmod_poly_fit_length(B, n);
+            for (j = 0; j < n; j++)
+                B->coeffs[j] = nmod_poly_lazy_series_get_coeff_ui(S, j);
+            B->length = n;
+            _nmod_poly_normalise(B);
+        }
+
+        result = nmod_poly_equal(B, C);
+
+        if (!result)
+        {
+            flint_printf("FAIL (%s):\n", exp ? "exp" : "inv");
+            flint_printf("mod = %wu, n = %wd, k = %wd\n\n", mod, n, k);
+            flint_printf("A: "); nmod_poly_print(A); flint_printf("\n\n");
+            flint_printf("B: "); nmod_poly_print(B); flint_printf("\n\n");
+            flint_printf("C: "); nmod_poly_print(C); flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_poly_lazy_series_clear(S);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(C);
+        nmod_poly_clear(T);
+    }
+
+    /* partition numbers from the pentagonal number series, one at a time */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_lazy_series_t S;
+        nmod_poly_t P;
+        nmod_t mod;
+        mp_ptr p;
+        slong j, k, n;
+
+        nmod_init(&mod, n_randtest_prime(state, 0));
+        n = n_randint(state, 3000);
+
+        nmod_poly_init_mod(P, mod);
+        p = _nmod_vec_init(n);
+
+        for (k = 0; k * (3 * k - 1) / 2 < n; k++)
+        {
+            mp_limb_t c = (k % 2) ? mod.n - 1 : 1;
+            if (mod.n == 2)
+                c = 1;
+            nmod_poly_set_coeff_ui(P, k * (3 * k - 1) / 2, c);
+            if (k != 0 && k * (3 * k + 1) / 2 < n)
+                nmod_poly_set_coeff_ui(P, k * (3 * k + 1) / 2, c);
+        }
+
+        arith_number_of_partitions_nmod_vec(p, n, mod);
+        nmod_poly_lazy_series_init_inv(S, P);
+
+        for (j = 0; j < n; j++)
+        {
+            if (nmod_poly_lazy_series_get_coeff_ui(S, j) != p[j])
+            {
+                flint_printf("FAIL (partitions):\n");
+                flint_printf("mod = %wu, n = %wd, j = %wd\n\n", mod.n, n, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_lazy_series_clear(S);
+        nmod_poly_clear(P);
+        _nmod_vec_clear(p);
+    }
+
+    /* Catalan numbers from f = 1/(1 - x f), supplying the input one term
+       at a time as the output becomes known */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_lazy_series_t S;
+        nmod_poly_t Q;
+        nmod_t mod;
+        mp_ptr c;
+        mp_limb_t f = 0;
+        slong j, k, n;
+
+        nmod_init(&mod, n_randtest_prime(state, 0));
+        n = n_randint(state, 300);
+
+        nmod_poly_init_mod(Q, mod);
+        c = _nmod_vec_init(n);
+
+        for (j = 0; j < n; j++)
+        {
+            c[j] = (j == 0);
+            for (k = 0; k < j; k++)
+                c[j] = nmod_add(c[j], nmod_mul(c[k], c[j - 1 - k], mod), mod);
+        }
+
+        nmod_poly_set_coeff_ui(Q, 0, 1);
+        nmod_poly_lazy_series_init_inv(S, Q);
+
+        for (j = 0; j < n; j++)
+        {
+            if (j > 0)
+            {
+                nmod_poly_set_coeff_ui(Q, j, nmod_neg(f, mod));
+                nmod_poly_lazy_series_set_input(S, Q);
+            }
+
+            f = nmod_poly_lazy_series_get_coeff_ui(S, j);
+
+            if (f != c[j])
+            {
+                flint_printf("FAIL (Catalan):\n");
+                flint_printf("mod = %wu, n = %wd, j = %wd\n\n", mod.n, n, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_lazy_series_clear(S);
+        nmod_poly_clear(Q);
+        _nmod_vec_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod_poly.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mulmod_precomp....");
+    fflush(stdout);
+
+    /* Compare with mulmod_preinv, reusing the precomputation */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, res1, res2, f, finv;
+        nmod_poly_mod_precomp_t M;
+        slong lenf;
+
+        mp_limb_t n = n_randtest_prime(state, 0);
+
+        if (n_randint(state, 4) == 0)
+            lenf = 1 + n_randint(state, 3 * NMOD_POLY_MOD_PRECOMP_FFT_CUTOFF);
+        else
+            lenf = 1 + n_randint(state, 50);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(f, n);
+        nmod_poly_init(finv, n);
+        nmod_poly_init(res1, n);
+        nmod_poly_init(res2, n);
+
+        nmod_poly_randtest_monic(f, state, lenf);
+
+        nmod_poly_reverse(finv, f, f->length);
+        nmod_poly_inv_series(finv, finv, f->length);
+
+        nmod_poly_mod_precomp_init(M, f, finv);
+
+        for (j = 0; j < 3; j++)
+        {
+            nmod_poly_randtest(a, state, n_randint(state, lenf));
+            nmod_poly_randtest(b, state, n_randint(state, lenf));
+
+            nmod_poly_mulmod_preinv(res1, a, b, f, finv);
+
+            switch (n_randint(state, 3))
+            {
+                case 0:
+                    nmod_poly_mulmod_precomp(res2, a, b, M);
+                    break;
+                case 1:
+                    nmod_poly_set(res2, a);
+                    nmod_poly_mulmod_precomp(res2, res2, b, M);
+                    break;
+                default:
+                    nmod_poly_set(res2, b);
+                    nmod_poly_mulmod_precomp(res2, a, res2, M);
+                    break;
+            }
+
+            result = (nmod_poly_equal(res1, res2));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("a:\n"); nmod_poly_print(a), flint_printf("\n\n");
+                flint_printf("b:\n"); nmod_poly_print(b), flint_printf("\n\n");
+                flint_printf("f:\n"); nmod_poly_print(f), flint_printf("\n\n");
+                flint_printf("res1:\n"); nmod_poly_print(res1), flint_printf("\n\n");
+                flint_printf("res2:\n"); nmod_poly_print(res2), flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_mod_precomp_clear(M);
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(f);
+        nmod_poly_clear(finv);
+        nmod_poly_clear(res1);
+        nmod_poly_clear(res2);
+    }
+
+    /* Powering with a large modulus goes through the precomputed path */
+    for (i = 0; i < 5 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, res1, res2, f, finv;
+        mp_limb_t n = n_randtest_prime(state, 0);
+        ulong e = n_randint(state, 50);
+        slong lenf = NMOD_POLY_MOD_PRECOMP_FFT_CUTOFF + n_randint(state, 100);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(f, n);
+        nmod_poly_init(finv, n);
+        nmod_poly_init(res1, n);
+        nmod_poly_init(res2, n);
+
+        nmod_poly_randtest_not_zero(f, state, lenf);
+        nmod_poly_randtest(a, state, n_randint(state, f->length));
+
+        nmod_poly_reverse(finv, f, f->length);
+        nmod_poly_inv_series(finv, finv, f->length);
+
+        nmod_poly_powmod_ui_binexp_preinv(res1, a, e, f, finv);
+
+        nmod_poly_one(res2);
+        for (j = 0; j < e; j++)
+            nmod_poly_mulmod(res2, res2, a, f);
+
+        result = (nmod_poly_equal(res1, res2));
+        if (!result)
+        {
+            flint_printf("FAIL (powmod):\n");
+            flint_printf("e = %wu\n", e);
+            flint_printf("a:\n"); nmod_poly_print(a), flint_printf("\n\n");
+            flint_printf("f:\n"); nmod_poly_print(f), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(f);
+        nmod_poly_clear(finv);
+        nmod_poly_clear(res1);
+        nmod_poly_clear(res2);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+int
+main(void)
+{
+    int i, result = 1;
+    FLINT_TEST_INIT(state);
+
+
+    flint_printf("point_set....");
+    fflush(stdout);
+
+    /* evaluation, also at repeated points and for non-prime moduli */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t P;
+        nmod_poly_point_set_t S;
+        nmod_t mod;
+        mp_ptr x, y, z;
+        slong j, k, n, npoints;
+
+        nmod_init(&mod, n_randtest_not_zero(state));
+        npoints = n_randint(state, 300);
+
+        nmod_poly_init_mod(P, mod);
+        x = _nmod_vec_init(npoints);
+        y = _nmod_vec_init(npoints);
+        z = _nmod_vec_init(npoints);
+
+        for (j = 0; j < npoints; j++)
+            x[j] = n_randint(state, mod.n);
+
+        nmod_poly_point_set_init(S, x, npoints, mod);
+
+        for (k = 0; k < 3; k++)
+        {
+            n = n_randint(state, 2 * npoints + 10);
+            nmod_poly_randtest(P, state, n);
+
+            nmod_poly_evaluate_nmod_vec_iter(y, P, x, npoints);
+            nmod_poly_evaluate_nmod_vec_point_set(z, P, S);
+
+            result = _nmod_vec_equal(y, z, npoints);
+
+            if (!result)
+            {
+                flint_printf("FAIL (evaluation):\n");
+                flint_printf("mod=%wu, n=%wd, npoints=%wd\n\n", mod.n, n, npoints);
+                flint_printf("P: "); nmod_poly_print(P); flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_point_set_clear(S);
+        nmod_poly_clear(P);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(z);
+    }
+
+    /* interpolation at distinct points */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t P, Q;
+        nmod_poly_point_set_t S;
+        nmod_t mod;
+        mp_ptr x, y;
+        slong j, k, n, npoints;
+
+        nmod_init(&mod, n_randtest_prime(state, 0));
+        npoints = n_randint(state, FLINT_MIN(300, mod.n));
+
+        nmod_poly_init_mod(P, mod);
+        nmod_poly_init_mod(Q, mod);
+        x = _nmod_vec_init(npoints);
+        y = _nmod_vec_init(npoints);
+
+        for (j = 0; j < npoints; j++)
+            x[j] = j;
+        for (j = 0; j < npoints; j++)
+        {
+            k = n_randint(state, npoints);
+            MP_LIMB_SWAP(x[j], x[k]);
+        }
+
+        nmod_poly_point_set_init(S, x, npoints, mod);
+
+        for (k = 0; k < 3; k++)
+        {
+            n = n_randint(state, npoints + 1);
+            nmod_poly_randtest(P, state, n);
+
+            nmod_poly_evaluate_nmod_vec_point_set(y, P, S);
+            nmod_poly_interpolate_nmod_vec_point_set(Q, y, S);
+
+            result = nmod_poly_equal(P, Q);
+
+            if (!result)
+            {
+                flint_printf("FAIL (interpolation):\n");
+                flint_printf("mod=%wu, n=%wd, npoints=%wd\n\n", mod.n, n, npoints);
+                flint_printf("P: "); nmod_poly_print(P); flint_printf("\n\n");
+                flint_printf("Q: "); nmod_poly_print(Q); flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_point_set_clear(S);
+        nmod_poly_clear(P);
+        nmod_poly_clear(Q);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -12,11 +12,41 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/* n < 2^63 */
+static void
+_nmod_vec_add_avx2(mp_ptr res, mp_srcptr vec1,
+                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4n n = vec4n_set_n(mod.n);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+        vec4n_store_unaligned(res + i, vec4n_addmod_limited(
+            vec4n_load_unaligned(vec1 + i), vec4n_load_unaligned(vec2 + i), n));
+
+    for ( ; i < len; i++)
+        res[i] = _nmod_add(vec1[i], vec2[i], mod);
+}
+
+#endif
+
 void _nmod_vec_add(mp_ptr res, mp_srcptr vec1,
                    mp_srcptr vec2, slong len, nmod_t mod)
 {
     slong i;
 
+#if defined(__AVX2__) && defined(__FMA__)
+    if (mod.norm && len >= 8)
+    {
+        _nmod_vec_add_avx2(res, vec1, vec2, len, mod);
+        return;
+    }
+#endif
+
     if (mod.norm)
     {
         for (i = 0 ; i < len; i++)
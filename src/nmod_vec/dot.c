@@ -12,11 +12,128 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/*
+    For n <= 2^32 the products fit in a limb and are computed four at a time
+    with vpmuludq; their high and low halves are summed separately, which
+    cannot overflow for len < 2^30.
+*/
+static mp_limb_t
+_nmod_vec_dot_avx2_32(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4n lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+    vec4n mask = vec4n_set_n(UWORD(0xffffffff));
+    mp_limb_t s0, s1, t0, t1, res, u[4];
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        vec4n p = _mm256_mul_epu32(vec4n_load_unaligned(vec1 + i),
+                                   vec4n_load_unaligned(vec2 + i));
+        lo = vec4n_add(lo, vec4n_bit_and(p, mask));
+        hi = vec4n_add(hi, vec4n_bit_shift_right_32(p));
+    }
+
+    vec4n_store_unaligned(u, lo);
+    t0 = u[0] + u[1] + u[2] + u[3];
+    vec4n_store_unaligned(u, hi);
+    t1 = u[0] + u[1] + u[2] + u[3];
+
+    for ( ; i < len; i++)
+    {
+        mp_limb_t p = vec1[i] * vec2[i];
+        t0 += p & UWORD(0xffffffff);
+        t1 += p >> 32;
+    }
+
+    s1 = t1 >> 32;
+    s0 = t1 << 32;
+    add_ssaaaa(s1, s0, s1, s0, 0, t0);
+    NMOD2_RED2(res, s1, s0, mod);
+    return res;
+}
+
+/*
+    For n < 2^50 the entries are converted to doubles and multiplied with
+    vec4d_mulmod, which leaves each term in [-n, n]. Every four steps the
+    accumulators are reduced to (-n, n) with vec4d_reduce_to_pm1no, so in
+    between they are bounded by 5n in absolute value, and by 8n in the
+    tail loop which adds at most seven more terms. Since 8n < 2^53, all
+    partial sums are integers that are represented exactly.
+*/
+static mp_limb_t
+_nmod_vec_dot_avx2_50(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4d n = vec4d_set_d(mod.n);
+    vec4d ninv = vec4d_set_d(1.0 / mod.n);
+    vec4d s = vec4d_zero(), t = vec4d_zero();
+    mp_limb_t res, r;
+    slong i, j;
+
+    for (i = 0; i + 32 <= len; )
+    {
+        for (j = 0; j < 4; j++, i += 8)
+        {
+            s = vec4d_add(s, vec4d_mulmod(
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i)),
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec2 + i)),
+                    n, ninv));
+            t = vec4d_add(t, vec4d_mulmod(
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i + 4)),
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec2 + i + 4)),
+                    n, ninv));
+        }
+
+        s = vec4d_reduce_to_pm1no(s, n, ninv);
+        t = vec4d_reduce_to_pm1no(t, n, ninv);
+    }
+
+    for ( ; i + 4 <= len; i += 4)
+    {
+        s = vec4d_add(s, vec4d_mulmod(
+                vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i)),
+                vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec2 + i)),
+                n, ninv));
+    }
+
+    s = vec4d_add(vec4d_reduce_to_pm1no(s, n, ninv),
+                  vec4d_reduce_to_pm1no(t, n, ninv));
+    s = vec4d_reduce_to_0n(s, n, ninv);
+
+    res = (mp_limb_t) vec4d_get_index(s, 0);
+    for (j = 1; j < 4; j++)
+        res = nmod_add(res, (mp_limb_t) vec4d_get_index(s, j), mod);
+
+    for ( ; i < len; i++)
+    {
+        r = nmod_mul(vec1[i], vec2[i], mod);
+        res = nmod_add(res, r, mod);
+    }
+
+    return res;
+}
+
+#endif
+
 mp_limb_t
 _nmod_vec_dot(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod, int nlimbs)
 {
     mp_limb_t res;
     slong i;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    if (len >= 16 && len < (WORD(1) << 30))
+    {
+        if (mod.n <= (UWORD(1) << 32))
+            return _nmod_vec_dot_avx2_32(vec1, vec2, len, mod);
+        if (mod.n < (UWORD(1) << 50))
+            return _nmod_vec_dot_avx2_50(vec1, vec2, len, mod);
+    }
+#endif
+
     NMOD_VEC_DOT(res, i, len, vec1[i], vec2[i], mod, nlimbs);
     return res;
 }
@@ -12,6 +12,106 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/* vec[3], vec[2], vec[1], vec[0] */
+FLINT_FORCE_INLINE vec4n vec4n_load_rev(const ulong * vec)
+{
+    return _mm256_permute4x64_epi64(vec4n_load_unaligned(vec), 0x1b);
+}
+
+/* as in dot.c, with vec2 read backwards */
+static mp_limb_t
+_nmod_vec_dot_rev_avx2_32(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4n lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+    vec4n mask = vec4n_set_n(UWORD(0xffffffff));
+    mp_limb_t s0, s1, t0, t1, res, u[4];
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        vec4n p = _mm256_mul_epu32(vec4n_load_unaligned(vec1 + i),
+                                   vec4n_load_rev(vec2 + len - 4 - i));
+        lo = vec4n_add(lo, vec4n_bit_and(p, mask));
+        hi = vec4n_add(hi, vec4n_bit_shift_right_32(p));
+    }
+
+    vec4n_store_unaligned(u, lo);
+    t0 = u[0] + u[1] + u[2] + u[3];
+    vec4n_store_unaligned(u, hi);
+    t1 = u[0] + u[1] + u[2] + u[3];
+
+    for ( ; i < len; i++)
+    {
+        mp_limb_t p = vec1[i] * vec2[len - 1 - i];
+        t0 += p & UWORD(0xffffffff);
+        t1 += p >> 32;
+    }
+
+    s1 = t1 >> 32;
+    s0 = t1 << 32;
+    add_ssaaaa(s1, s0, s1, s0, 0, t0);
+    NMOD2_RED2(res, s1, s0, mod);
+    return res;
+}
+
+static mp_limb_t
+_nmod_vec_dot_rev_avx2_50(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4d n = vec4d_set_d(mod.n);
+    vec4d ninv = vec4d_set_d(1.0 / mod.n);
+    vec4d s = vec4d_zero(), t = vec4d_zero();
+    mp_limb_t res, r;
+    slong i, j;
+
+    for (i = 0; i + 32 <= len; )
+    {
+        for (j = 0; j < 4; j++, i += 8)
+        {
+            s = vec4d_add(s, vec4d_mulmod(
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i)),
+                    vec4n_convert_limited_vec4d(vec4n_load_rev(vec2 + len - 4 - i)),
+                    n, ninv));
+            t = vec4d_add(t, vec4d_mulmod(
+                    vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i + 4)),
+                    vec4n_convert_limited_vec4d(vec4n_load_rev(vec2 + len - 8 - i)),
+                    n, ninv));
+        }
+
+        s = vec4d_reduce_to_pm1no(s, n, ninv);
+        t = vec4d_reduce_to_pm1no(t, n, ninv);
+    }
+
+    for ( ; i + 4 <= len; i += 4)
+    {
+        s = vec4d_add(s, vec4d_mulmod(
+                vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec1 + i)),
+                vec4n_convert_limited_vec4d(vec4n_load_rev(vec2 + len - 4 - i)),
+                n, ninv));
+    }
+
+    s = vec4d_add(vec4d_reduce_to_pm1no(s, n, ninv),
+                  vec4d_reduce_to_pm1no(t, n, ninv));
+    s = vec4d_reduce_to_0n(s, n, ninv);
+
+    res = (mp_limb_t) vec4d_get_index(s, 0);
+    for (j = 1; j < 4; j++)
+        res = nmod_add(res, (mp_limb_t) vec4d_get_index(s, j), mod);
+
+    for ( ; i < len; i++)
+    {
+        r = nmod_mul(vec1[i], vec2[len - 1 - i], mod);
+        res = nmod_add(res, r, mod);
+    }
+
+    return res;
+}
+
+#endif
+
 static mp_limb_t
 nmod_fmma(mp_limb_t a, mp_limb_t b, mp_limb_t c, mp_limb_t d, nmod_t mod)
 {
@@ -35,6 +135,16 @@ _nmod_vec_dot_rev(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod, int nli
         return 0;
     }
 
+#if defined(__AVX2__) && defined(__FMA__)
+    if (len >= 16 && len < (WORD(1) << 30))
+    {
+        if (mod.n <= (UWORD(1) << 32))
+            return _nmod_vec_dot_rev_avx2_32(vec1, vec2, len, mod);
+        if (mod.n < (UWORD(1) << 50))
+            return _nmod_vec_dot_rev_avx2_50(vec1, vec2, len, mod);
+    }
+#endif
+
     NMOD_VEC_DOT(res, i, len, vec1[i], vec2[len - 1 - i], mod, nlimbs);
     return res;
 }
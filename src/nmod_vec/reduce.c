@@ -12,9 +12,52 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/*
+    n < 2^50: write x = hi 2^32 + lo and compute hi (2^32 mod n) + lo
+    in double precision, as in fft_small.
+*/
+static void
+_nmod_vec_reduce_avx2(mp_ptr res, mp_srcptr vec, slong len, nmod_t mod)
+{
+    vec4d n = vec4d_set_d(mod.n);
+    vec4d ninv = vec4d_set_d(1.0 / mod.n);
+    vec4d b = vec4d_set_d(nmod_set_ui(UWORD(1) << 32, mod));
+    vec4n mask = vec4n_set_n(UWORD(0xffffffff));
+    vec4n x;
+    vec4d t;
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        x = vec4n_load_unaligned(vec + i);
+        t = vec4n_convert_limited_vec4d(vec4n_bit_shift_right_32(x));
+        t = vec4d_mulmod(t, b, n, ninv);
+        t = vec4d_add(t, vec4n_convert_limited_vec4d(vec4n_bit_and(x, mask)));
+        t = vec4d_reduce_to_0n(t, n, ninv);
+        vec4n_store_unaligned(res + i, vec4d_convert_limited_vec4n(t));
+    }
+
+    for ( ; i < len; i++)
+        NMOD_RED(res[i], vec[i], mod);
+}
+
+#endif
+
 void _nmod_vec_reduce(mp_ptr res, mp_srcptr vec, slong len, nmod_t mod)
 {
     slong i;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    if (len >= 8 && NMOD_BITS(mod) <= 50)
+    {
+        _nmod_vec_reduce_avx2(res, vec, len, mod);
+        return;
+    }
+#endif
     for (i = 0 ; i < len; i++)
         NMOD_RED(res[i], vec[i], mod);
 }
@@ -13,6 +13,35 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/* n < 2^50: double precision, as in fft_small */
+static void
+_nmod_vec_scalar_mul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                               slong len, mp_limb_t c, nmod_t mod)
+{
+    vec4d n = vec4d_set_d(mod.n);
+    vec4d ninv = vec4d_set_d(1.0 / mod.n);
+    vec4d b = vec4d_set_d(c);
+    vec4d t;
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        t = vec4n_convert_limited_vec4d(vec4n_load_unaligned(vec + i));
+        t = vec4d_mulmod(t, b, n, ninv);
+        t = vec4d_reduce_2n_to_n(vec4d_reduce_pm1no_to_0n(t, n), n);
+        vec4n_store_unaligned(res + i, vec4d_convert_limited_vec4n(t));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = nmod_mul(vec[i], c, mod);
+}
+
+#endif
+
 void _nmod_vec_scalar_mul_nmod_fullword(mp_ptr res, mp_srcptr vec,
                                slong len, mp_limb_t c, nmod_t mod)
 {
@@ -36,6 +65,10 @@ void _nmod_vec_scalar_mul_nmod(mp_ptr res, mp_srcptr vec,
 {
     if (NMOD_BITS(mod) == FLINT_BITS)
         _nmod_vec_scalar_mul_nmod_fullword(res, vec, len, c, mod);
+#if defined(__AVX2__) && defined(__FMA__)
+    else if (len > 10 && NMOD_BITS(mod) <= 50)
+        _nmod_vec_scalar_mul_nmod_avx2(res, vec, len, c, mod);
+#endif
     else if (len > 10)
         _nmod_vec_scalar_mul_nmod_shoup(res, vec, len, c, mod);
     else
@@ -12,10 +12,46 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "machine_vectors.h"
+
+/* n < 2^63 */
+static void
+_nmod_vec_sub_avx2(mp_ptr res, mp_srcptr vec1,
+                   mp_srcptr vec2, slong len, nmod_t mod)
+{
+    vec4n n = vec4n_set_n(mod.n);
+    vec4n d, m;
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        d = vec4n_sub(vec4n_load_unaligned(vec1 + i),
+                      vec4n_load_unaligned(vec2 + i));
+        m = _mm256_cmpgt_epi64(_mm256_setzero_si256(), d);
+        vec4n_store_unaligned(res + i, vec4n_add(d, vec4n_bit_and(m, n)));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = _nmod_sub(vec1[i], vec2[i], mod);
+}
+
+#endif
+
 void _nmod_vec_sub(mp_ptr res, mp_srcptr vec1,
                    mp_srcptr vec2, slong len, nmod_t mod)
 {
     slong i;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    if (mod.norm && len >= 8)
+    {
+        _nmod_vec_sub_avx2(res, vec1, vec2, len, mod);
+        return;
+    }
+#endif
+
     if (mod.norm)
     {
         for (i = 0 ; i < len; i++)
@@ -89,6 +89,44 @@ main(void)
         _nmod_vec_clear(vec3);
     }
 
+    /* Check against nmod_add and nmod_sub */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        slong j, len = n_randint(state, 100) + 1;
+        mp_limb_t n = n_randtest_not_zero(state);
+        nmod_t mod;
+
+        mp_ptr vec = _nmod_vec_init(len);
+        mp_ptr vec2 = _nmod_vec_init(len);
+        mp_ptr vec3 = _nmod_vec_init(len);
+        mp_ptr vec4 = _nmod_vec_init(len);
+
+        nmod_init(&mod, n);
+
+        _nmod_vec_randtest(vec, state, len, mod);
+        _nmod_vec_randtest(vec2, state, len, mod);
+
+        _nmod_vec_add(vec3, vec, vec2, len, mod);
+        _nmod_vec_sub(vec4, vec, vec2, len, mod);
+
+        for (j = 0; j < len; j++)
+        {
+            if (vec3[j] != nmod_add(vec[j], vec2[j], mod) ||
+                vec4[j] != nmod_sub(vec[j], vec2[j], mod))
+            {
+                flint_printf("FAIL (nmod_add, nmod_sub):\n");
+                flint_printf("len = %wd, n = %wu, j = %wd\n", len, n, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        _nmod_vec_clear(vec);
+        _nmod_vec_clear(vec2);
+        _nmod_vec_clear(vec3);
+        _nmod_vec_clear(vec4);
+    }
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
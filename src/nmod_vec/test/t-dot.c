@@ -69,6 +69,20 @@ main(void)
             flint_abort();
         }
 
+        /* dot_rev against a reversed copy */
+        for (j = 0; j < len / 2; j++)
+            MP_LIMB_SWAP(y[j], y[len - 1 - j]);
+
+        if (_nmod_vec_dot_rev(x, y, len, mod, limbs1) != res)
+        {
+            flint_printf("FAIL (dot_rev):\n");
+            flint_printf("m = %wu\n", m);
+            flint_printf("len = %wd\n", len);
+            flint_printf("limbs1 = %d\n", limbs1);
+            fflush(stdout);
+            flint_abort();
+        }
+
         mpz_clear(s);
         mpz_clear(t);
 
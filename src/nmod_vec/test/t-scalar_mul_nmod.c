@@ -66,6 +66,37 @@ main(void)
         _nmod_vec_clear(vec3);
     }
 
+    /* Check against nmod_mul */
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        slong j, len = n_randint(state, 100) + 1;
+        mp_limb_t n = n_randtest_not_zero(state);
+        mp_limb_t c = n_randint(state, n);
+        nmod_t mod;
+
+        mp_ptr vec = _nmod_vec_init(len);
+        mp_ptr vec2 = _nmod_vec_init(len);
+
+        nmod_init(&mod, n);
+
+        _nmod_vec_randtest(vec, state, len, mod);
+        _nmod_vec_scalar_mul_nmod(vec2, vec, len, c, mod);
+
+        for (j = 0; j < len; j++)
+        {
+            if (vec2[j] != nmod_mul(vec[j], c, mod))
+            {
+                flint_printf("FAIL (nmod_mul):\n");
+                flint_printf("len = %wd, n = %wu, j = %wd\n", len, n, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        _nmod_vec_clear(vec);
+        _nmod_vec_clear(vec2);
+    }
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
@@ -107,6 +107,39 @@ void qfb_array_clear(qfb ** forms, slong num)
    flint_free(*forms);
 }
 
+/*
+   Slot at which probing starts for the form q (or its inverse) in a hash
+   table of size 2^depth. The low limbs of a and |b| are mixed so that
+   forms whose a coefficients agree modulo a power of two do not cluster.
+*/
+QFB_INLINE
+slong _qfb_hash_index(qfb_t q, slong depth)
+{
+   ulong a, b, h;
+
+   if (depth == 0)
+      return 0;
+
+   a = COEFF_IS_MPZ(*q->a) ? COEFF_TO_PTR(*q->a)->_mp_d[0] : (ulong) *q->a;
+
+   if (COEFF_IS_MPZ(*q->b))
+      b = COEFF_TO_PTR(*q->b)->_mp_d[0];
+   else
+      b = FLINT_ABS(*q->b);
+
+#if FLINT_BITS == 64
+   h = a * UWORD(0x9e3779b97f4a7c15) + b;
+   h ^= (h >> 29);
+   h *= UWORD(0xbf58476d1ce4e5b9);
+#else
+   h = a * UWORD(0x9e3779b9) + b;
+   h ^= (h >> 15);
+   h *= UWORD(0x85ebca6b);
+#endif
+
+   return h >> (FLINT_BITS - depth);
+}
+
 qfb_hash_t * qfb_hash_init(slong depth);
 
 void qfb_hash_clear(qfb_hash_t * qhash, slong depth);
@@ -186,7 +219,7 @@ int qfb_is_primitive(qfb_t f)
    return res;
 }
 
-void qfb_prime_form(qfb_t r, fmpz_t D, fmpz_t p);
+void qfb_prime_form(qfb_t r, const fmpz_t D, const fmpz_t p);
 
 int qfb_exponent_element(fmpz_t exponent, qfb_t f,
                                           fmpz_t n, ulong B1, ulong B2_sqrt);
@@ -195,6 +228,10 @@ int qfb_exponent(fmpz_t exponent, fmpz_t n, ulong B1, ulong B2_sqrt, slong c);
 
 int qfb_exponent_grh(fmpz_t exponent, fmpz_t n, ulong B1, ulong B2_sqrt);
 
+slong qfb_class_group(fmpz ** invariants, fmpz_t h, const fmpz_t D);
+
+void qfb_class_number(fmpz_t h, const fmpz_t D);
+
 #ifdef __cplusplus
 }
 #endif
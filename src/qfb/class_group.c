@@ -0,0 +1,693 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "thread_support.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "qfb.h"
+
+/*
+   The relations found in a round are split into a fixed number of batches,
+   each with its own random state, so that the result does not depend on
+   the number of threads.
+*/
+#define QFB_CLASS_GROUP_BATCHES 16
+
+/* maximum number of factor base primes in the leading coefficient A */
+#define QFB_CLASS_GROUP_MAX_A 32
+
+/* Euler product bound for the analytic class number estimate */
+#define QFB_CLASS_GROUP_EULER_BOUND (UWORD(1) << 18)
+
+typedef struct
+{
+    const fmpz * D;
+    slong num;
+    ulong * p;
+    ulong * bmod;         /* b coefficient of the prime form, mod 2p */
+    ulong * sqrtD;        /* square root of D mod p, 0 if p | D */
+    int * ramified;
+    unsigned short * logp;
+    slong * pool;         /* odd split primes usable in A */
+    slong pool_len;
+    slong M;              /* we sieve over x in [-M, M) */
+    double target;        /* log2 of the ideal size of A */
+    double slack;
+}
+_qfb_fb_struct;
+
+typedef _qfb_fb_struct _qfb_fb_t[1];
+
+static int
+_qfb_kronecker(const fmpz_t D, ulong p)
+{
+    if (p == 2)
+    {
+        ulong r = fmpz_fdiv_ui(D, 8);
+
+        if (r % 2 == 0)
+            return 0;
+
+        return (r == 1 || r == 7) ? 1 : -1;
+    }
+
+    return n_jacobi_unsigned(fmpz_fdiv_ui(D, p), p);
+}
+
+/*
+   Analytic estimate of the class number from the truncated Euler product
+   for L(1, chi_D), using h(D) = w(D) sqrt(|D|) L(1, chi_D) / (2 pi).
+*/
+static double
+_qfb_class_number_estimate(const fmpz_t D)
+{
+    n_primes_t iter;
+    ulong p;
+    double L = 1.0, w = 2.0;
+    int chi;
+
+    n_primes_init(iter);
+
+    while ((p = n_primes_next(iter)) < QFB_CLASS_GROUP_EULER_BOUND)
+    {
+        chi = _qfb_kronecker(D, p);
+        if (chi != 0)
+            L *= (double) p / (double) (p - chi);
+    }
+
+    n_primes_clear(iter);
+
+    if (fmpz_cmp_si(D, -3) == 0)
+        w = 6.0;
+    else if (fmpz_cmp_si(D, -4) == 0)
+        w = 4.0;
+
+    return w * sqrt(-fmpz_get_d(D)) * L / (2 * 3.14159265358979323846);
+}
+
+static void
+_qfb_fb_init(_qfb_fb_t fb, const fmpz_t D, ulong B, slong M, double lnD)
+{
+    n_primes_t iter;
+    ulong p;
+    slong alloc = 64, i;
+    qfb_t f;
+    fmpz_t t;
+    int chi;
+
+    fb->D = D;
+    fb->num = 0;
+    fb->p = flint_malloc(alloc * sizeof(ulong));
+    fb->bmod = flint_malloc(alloc * sizeof(ulong));
+    fb->sqrtD = flint_malloc(alloc * sizeof(ulong));
+    fb->ramified = flint_malloc(alloc * sizeof(int));
+
+    qfb_init(f);
+    fmpz_init(t);
+    n_primes_init(iter);
+
+    while ((p = n_primes_next(iter)) <= B)
+    {
+        chi = _qfb_kronecker(D, p);
+
+        if (chi == -1)
+            continue;
+
+        fmpz_set_ui(t, p);
+        qfb_prime_form(f, D, t);
+
+        if (chi == 0 && !qfb_is_primitive(f))
+            continue;
+
+        if (fb->num == alloc)
+        {
+            alloc *= 2;
+            fb->p = flint_realloc(fb->p, alloc * sizeof(ulong));
+            fb->bmod = flint_realloc(fb->bmod, alloc * sizeof(ulong));
+            fb->sqrtD = flint_realloc(fb->sqrtD, alloc * sizeof(ulong));
+            fb->ramified = flint_realloc(fb->ramified, alloc * sizeof(int));
+        }
+
+        fb->p[fb->num] = p;
+        fb->bmod[fb->num] = fmpz_fdiv_ui(f->b, 2 * p);
+        fb->sqrtD[fb->num] = (chi == 0) ? 0 : n_sqrtmod(fmpz_fdiv_ui(D, p), p);
+        fb->ramified[fb->num] = (chi == 0);
+        fb->num++;
+    }
+
+    n_primes_clear(iter);
+    fmpz_clear(t);
+    qfb_clear(f);
+
+    fb->logp = flint_malloc((fb->num + 1) * sizeof(unsigned short));
+    fb->pool = flint_malloc((fb->num + 1) * sizeof(slong));
+    fb->pool_len = 0;
+
+    for (i = 0; i < fb->num; i++)
+    {
+        fb->logp[i] = (unsigned short) (log2((double) fb->p[i]) + 0.5);
+
+        /* the smallest primes contribute most to smoothness, keep them out of A */
+        if (fb->p[i] > 2 && !fb->ramified[i] && i >= fb->num / 4)
+            fb->pool[fb->pool_len++] = i;
+    }
+
+    fb->M = M;
+    fb->target = 0.5 * (lnD / log(2.0) - 1.0) - log2((double) M);
+    fb->slack = (fb->num == 0) ? 0.0 : 1.5 * log2((double) fb->p[fb->num - 1]) + 2.0;
+}
+
+static void
+_qfb_fb_clear(_qfb_fb_t fb)
+{
+    flint_free(fb->p);
+    flint_free(fb->bmod);
+    flint_free(fb->sqrtD);
+    flint_free(fb->ramified);
+    flint_free(fb->logp);
+    flint_free(fb->pool);
+}
+
+/*
+   Sets (A, B) to the composition of the prime forms (p, b) and (A, B),
+   where p does not divide A and b is only given modulo 2p.
+*/
+static void
+_qfb_compose_prime(fmpz_t A, fmpz_t B, ulong p, ulong b)
+{
+    ulong half, t;
+
+    half = n_submod(b, fmpz_fdiv_ui(B, 2 * p), 2 * p) / 2;
+    t = n_mulmod2(half % p, n_invmod(fmpz_fdiv_ui(A, p), p), p);
+
+    fmpz_addmul_ui(B, A, 2 * t);
+    fmpz_mul_ui(A, A, p);
+}
+
+/*
+   Builds a random form f = (A, B, C) of discriminant D whose leading
+   coefficient A is a product of factor base primes (and q, if q != 0),
+   records the class of f in terms of the factor base in base, sieves
+   f(x, 1) for x in [-M, M) and writes up to max_rels relations to rels.
+   If f(x, 1) = N then f is equivalent to (N, -(2Ax + B), A), so the
+   factorisation of N gives a second expression for the class of f.
+   Returns the number of relations found.
+*/
+static slong
+_qfb_sieve_poly(slong * rels, slong max_rels, const _qfb_fb_t fb,
+                flint_rand_t state, ulong q, ulong qb)
+{
+    slong n = fb->num, M = fb->M, i, k, idx, found = 0, tries;
+    slong chosen[QFB_CLASS_GROUP_MAX_A];
+    slong * base, * rel;
+    unsigned short * sieve;
+    fmpz_t A, B, C, N, Bp;
+    double logA = 0.0, Ad, Bd, Cd, x, Nd;
+    ulong p, r1, r2, s, Am, Bm, inv, start;
+
+    fmpz_init_set_ui(A, 1);
+    fmpz_init_set_ui(B, fmpz_is_odd(fb->D));
+    fmpz_init(C);
+    fmpz_init(N);
+    fmpz_init(Bp);
+
+    base = flint_calloc(n + 1, sizeof(slong));
+
+    if (q != 0)
+    {
+        _qfb_compose_prime(A, B, q, qb);
+        logA = log2((double) q);
+    }
+
+    /* choose the factor base primes of A */
+    k = 0;
+    for (tries = 0; tries < 64 && k < QFB_CLASS_GROUP_MAX_A && fb->pool_len != 0; tries++)
+    {
+        slong j;
+        double lp;
+
+        i = fb->pool[n_randint(state, fb->pool_len)];
+        lp = log2((double) fb->p[i]);
+
+        for (j = 0; j < k && chosen[j] != i; j++) ;
+        if (j < k)
+            continue;
+
+        if ((k > 0 || q != 0) && logA + 0.5 * lp > fb->target)
+            continue;
+
+        p = fb->p[i];
+        if (n_randint(state, 2))
+        {
+            _qfb_compose_prime(A, B, p, fb->bmod[i]);
+            base[i] = 1;
+        }
+        else
+        {
+            _qfb_compose_prime(A, B, p, 2 * p - fb->bmod[i]);
+            base[i] = -1;
+        }
+
+        chosen[k++] = i;
+        logA += lp;
+    }
+
+    /* normalise B to (-A, A] and set C = (B^2 - D) / 4A */
+    fmpz_mul_2exp(C, A, 1);
+    fmpz_fdiv_r(B, B, C);
+    if (fmpz_cmp(B, A) > 0)
+        fmpz_sub(B, B, C);
+
+    fmpz_mul(C, B, B);
+    fmpz_sub(C, C, fb->D);
+    fmpz_mul_2exp(N, A, 2);
+    fmpz_divexact(C, C, N);
+
+    sieve = flint_calloc(2 * M, sizeof(unsigned short));
+
+    for (i = 0; i < n; i++)
+    {
+        p = fb->p[i];
+
+        if (p == 2)
+            continue;
+
+        Am = fmpz_fdiv_ui(A, p);
+        Bm = fmpz_fdiv_ui(B, p);
+
+        if (Am == 0)
+        {
+            if (Bm == 0)
+                continue;
+
+            r1 = n_mulmod2(n_negmod(fmpz_fdiv_ui(C, p), p), n_invmod(Bm, p), p);
+            r2 = r1;
+        }
+        else
+        {
+            inv = n_invmod(n_addmod(Am, Am, p), p);
+            s = fb->sqrtD[i];
+            r1 = n_mulmod2(n_submod(s, Bm, p), inv, p);
+            r2 = n_mulmod2(n_submod(n_negmod(s, p), Bm, p), inv, p);
+        }
+
+        start = n_addmod(r1, M % p, p);
+        for (idx = start; idx < 2 * M; idx += p)
+            sieve[idx] += fb->logp[i];
+
+        if (r2 != r1)
+        {
+            start = n_addmod(r2, M % p, p);
+            for (idx = start; idx < 2 * M; idx += p)
+                sieve[idx] += fb->logp[i];
+        }
+    }
+
+    Ad = fmpz_get_d(A);
+    Bd = fmpz_get_d(B);
+    Cd = fmpz_get_d(C);
+
+    for (idx = 0; idx < 2 * M && found < max_rels; idx++)
+    {
+        x = (double) (idx - M);
+        Nd = (Ad * x + Bd) * x + Cd;
+
+        if (Nd > 2.0 && (double) sieve[idx] < log2(Nd) - fb->slack)
+            continue;
+
+        /* N = f(x, 1) */
+        fmpz_mul_si(N, A, idx - M);
+        fmpz_add(N, N, B);
+        fmpz_mul_si(N, N, idx - M);
+        fmpz_add(N, N, C);
+
+        rel = rels + found * n;
+
+        for (i = 0; i < n; i++)
+            rel[i] = 0;
+
+        for (i = 0; i < n && !fmpz_is_one(N); i++)
+        {
+            while (fmpz_divisible_si(N, fb->p[i]))
+            {
+                fmpz_divexact_ui(N, N, fb->p[i]);
+                rel[i]++;
+            }
+        }
+
+        if (!fmpz_is_one(N))
+            continue;
+
+        /* B' = -(2Ax + B) */
+        fmpz_mul_si(Bp, A, 2 * (idx - M));
+        fmpz_add(Bp, Bp, B);
+        fmpz_neg(Bp, Bp);
+
+        s = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (rel[i] != 0 && !fb->ramified[i] &&
+                    fmpz_fdiv_ui(Bp, 2 * fb->p[i]) != fb->bmod[i])
+                rel[i] = -rel[i];
+
+            rel[i] = base[i] - rel[i];
+            s |= (rel[i] != 0);
+        }
+
+        if (s != 0)
+            found++;
+    }
+
+    flint_free(sieve);
+    flint_free(base);
+    fmpz_clear(A);
+    fmpz_clear(B);
+    fmpz_clear(C);
+    fmpz_clear(N);
+    fmpz_clear(Bp);
+
+    return found;
+}
+
+typedef struct
+{
+    const _qfb_fb_struct * fb;
+    ulong seed;
+    slong want;
+    slong * rels;
+    slong found;
+}
+_qfb_relations_arg_t;
+
+static void
+_qfb_relations_worker(slong i, void * _args)
+{
+    _qfb_relations_arg_t * arg = ((_qfb_relations_arg_t *) _args) + i;
+    slong polys;
+    flint_rand_t state;
+
+    flint_randinit(state);
+    flint_randseed(state, arg->seed, arg->seed ^ UWORD(0x5851f42d));
+
+    arg->found = 0;
+    for (polys = 0; polys < 8 * arg->want + 16 && arg->found < arg->want; polys++)
+        arg->found += _qfb_sieve_poly(arg->rels + arg->found * arg->fb->num,
+                        arg->want - arg->found, arg->fb, state, 0, 0);
+
+    flint_randclear(state);
+}
+
+typedef struct
+{
+    const _qfb_fb_struct * fb;
+    const ulong * q;
+    const ulong * qb;
+    int * done;
+}
+_qfb_generators_arg_t;
+
+/*
+   Checks that the class of the prime form of norm q[i] lies in the
+   subgroup generated by the factor base, by finding a relation involving
+   it exactly once.
+*/
+static void
+_qfb_generators_worker(slong i, void * _args)
+{
+    _qfb_generators_arg_t * arg = (_qfb_generators_arg_t *) _args;
+    slong polys, * rel;
+    flint_rand_t state;
+
+    rel = flint_malloc((arg->fb->num + 1) * sizeof(slong));
+
+    flint_randinit(state);
+    flint_randseed(state, arg->q[i], arg->q[i] ^ UWORD(0x2545f491));
+
+    arg->done[i] = 0;
+    for (polys = 0; polys < 64 && !arg->done[i]; polys++)
+        arg->done[i] = _qfb_sieve_poly(rel, 1, arg->fb, state, arg->q[i], arg->qb[i]);
+
+    flint_randclear(state);
+    flint_free(rel);
+}
+
+static int
+_qfb_check_generators(const _qfb_fb_t fb, const fmpz_t D, ulong B, ulong bach)
+{
+    n_primes_t iter;
+    ulong p, * q, * qb;
+    slong num = 0, alloc = 64, i;
+    int * done, res = 1, chi;
+    _qfb_generators_arg_t arg;
+    qfb_t f;
+    fmpz_t t;
+
+    if (bach <= B)
+        return 1;
+
+    q = flint_malloc(alloc * sizeof(ulong));
+    qb = flint_malloc(alloc * sizeof(ulong));
+
+    qfb_init(f);
+    fmpz_init(t);
+    n_primes_init(iter);
+    n_primes_jump_after(iter, B);
+
+    while ((p = n_primes_next(iter)) <= bach)
+    {
+        chi = _qfb_kronecker(D, p);
+
+        if (chi == -1)
+            continue;
+
+        fmpz_set_ui(t, p);
+        qfb_prime_form(f, D, t);
+
+        if (chi == 0 && !qfb_is_primitive(f))
+            continue;
+
+        if (num == alloc)
+        {
+            alloc *= 2;
+            q = flint_realloc(q, alloc * sizeof(ulong));
+            qb = flint_realloc(qb, alloc * sizeof(ulong));
+        }
+
+        q[num] = p;
+        qb[num] = fmpz_fdiv_ui(f->b, 2 * p);
+        num++;
+    }
+
+    n_primes_clear(iter);
+    fmpz_clear(t);
+    qfb_clear(f);
+
+    done = flint_malloc((num + 1) * sizeof(int));
+
+    arg.fb = fb;
+    arg.q = q;
+    arg.qb = qb;
+    arg.done = done;
+
+    flint_parallel_do(_qfb_generators_worker, &arg, num, -1, FLINT_PARALLEL_STRIDED);
+
+    for (i = 0; i < num && res; i++)
+        res = done[i];
+
+    flint_free(done);
+    flint_free(q);
+    flint_free(qb);
+
+    return res;
+}
+
+/*
+   Collects relations until the lattice they span has full rank and
+   index below sqrt(2) times the analytic estimate. On success H is set
+   to the square Hermite normal form of the relation lattice.
+*/
+static int
+_qfb_relation_lattice(fmpz_mat_t H, const _qfb_fb_t fb, double h_est, ulong B)
+{
+    slong n = fb->num, rank = 0, round, want, m, i, j, k;
+    _qfb_relations_arg_t args[QFB_CLASS_GROUP_BATCHES];
+    fmpz_mat_t R, T;
+    fmpz_t h;
+    int res = 0;
+
+    if (n == 0)
+        return (1.0 < 1.4142135623730951 * h_est);
+
+    fmpz_init(h);
+
+    /* ramified primes have order dividing 2 */
+    for (i = 0; i < n; i++)
+        rank += fb->ramified[i];
+
+    fmpz_mat_init(T, rank, n);
+    for (i = 0, k = 0; i < n; i++)
+        if (fb->ramified[i])
+            fmpz_set_ui(fmpz_mat_entry(T, k++, i), 2);
+
+    for (round = 0; round < 40 && !res; round++)
+    {
+        want = (round == 0) ? n + 16 : n / 4 + 16;
+        want = (want + QFB_CLASS_GROUP_BATCHES - 1) / QFB_CLASS_GROUP_BATCHES;
+
+        for (i = 0; i < QFB_CLASS_GROUP_BATCHES; i++)
+        {
+            args[i].fb = fb;
+            args[i].seed = B * UWORD(1000003) + round * QFB_CLASS_GROUP_BATCHES + i;
+            args[i].want = want;
+            args[i].rels = flint_malloc((want * n + 1) * sizeof(slong));
+        }
+
+        flint_parallel_do(_qfb_relations_worker, args,
+                    QFB_CLASS_GROUP_BATCHES, -1, FLINT_PARALLEL_STRIDED);
+
+        m = fmpz_mat_nrows(T);
+        for (i = 0; i < QFB_CLASS_GROUP_BATCHES; i++)
+            m += args[i].found;
+
+        fmpz_mat_init(R, m, n);
+
+        for (i = 0; i < fmpz_mat_nrows(T); i++)
+            for (j = 0; j < n; j++)
+                fmpz_set(fmpz_mat_entry(R, i, j), fmpz_mat_entry(T, i, j));
+
+        for (k = 0; k < QFB_CLASS_GROUP_BATCHES; k++)
+        {
+            for (j = 0; j < args[k].found; j++, i++)
+                for (m = 0; m < n; m++)
+                    fmpz_set_si(fmpz_mat_entry(R, i, m), args[k].rels[j * n + m]);
+
+            flint_free(args[k].rels);
+        }
+
+        fmpz_mat_hnf(R, R);
+
+        for (rank = 0; rank < fmpz_mat_nrows(R) &&
+                   !_fmpz_vec_is_zero(R->rows[rank], n); rank++) ;
+
+        fmpz_mat_clear(T);
+        fmpz_mat_init(T, rank, n);
+        for (i = 0; i < rank; i++)
+            _fmpz_vec_set(T->rows[i], R->rows[i], n);
+        fmpz_mat_clear(R);
+
+        if (rank == n)
+        {
+            fmpz_one(h);
+            for (i = 0; i < n; i++)
+                fmpz_mul(h, h, fmpz_mat_entry(T, i, i));
+
+            res = (fmpz_get_d(h) < 1.4142135623730951 * h_est);
+        }
+    }
+
+    if (res)
+        fmpz_mat_swap(H, T);
+
+    fmpz_mat_clear(T);
+    fmpz_clear(h);
+
+    return res;
+}
+
+slong qfb_class_group(fmpz ** invariants, fmpz_t h, const fmpz_t D)
+{
+    double lnD, h_est, t;
+    ulong B, Bmax, bach;
+    slong M, n, i, num;
+    _qfb_fb_t fb;
+    fmpz_mat_t H, S;
+
+    if (fmpz_sgn(D) >= 0)
+        flint_throw(FLINT_ERROR, "%s not implemented for positive discriminant\n", __FUNCTION__);
+
+    if (fmpz_fdiv_ui(D, 4) > 1)
+        flint_throw(FLINT_ERROR, "%s: discriminant must be 0 or 1 mod 4\n", __FUNCTION__);
+
+    {
+        fmpz_t absD;
+        fmpz_init(absD);
+        fmpz_neg(absD, D);
+        lnD = fmpz_dlog(absD);
+        fmpz_clear(absD);
+    }
+
+    /* under GRH the class group is generated by primes below 6 log^2 |D| */
+    bach = (ulong) (6 * lnD * lnD) + 1;
+
+    /* B = L(|D|)^{1/2} / 2 */
+    t = FLINT_MAX(lnD, 3.0);
+    t = 0.5 * exp(0.5 * sqrt(t * log(t)));
+    B = (ulong) FLINT_MIN(t, 1e9);
+    B = FLINT_MAX(B, FLINT_MIN(bach, 2000));
+    B = FLINT_MAX(B, 30);
+
+    M = WORD(1) << FLINT_MAX(6, FLINT_MIN(14, fmpz_bits(D) / 8));
+
+    /* B >= bach suffices under GRH; allow a few more doublings for the
+       random relation search, but stop before the factor base becomes
+       unreasonably large */
+    Bmax = FLINT_MIN(FLINT_MAX(B, bach), UWORD(1) << (FLINT_BITS / 2 - 8)) << 8;
+
+    h_est = _qfb_class_number_estimate(D);
+
+    fmpz_mat_init(H, 0, 0);
+
+    for (;;)
+    {
+        _qfb_fb_init(fb, D, B, M, lnD);
+
+        if (_qfb_check_generators(fb, D, B, bach))
+        {
+            fmpz_mat_clear(H);
+            fmpz_mat_init(H, fb->num, fb->num);
+
+            if (_qfb_relation_lattice(H, fb, h_est, B))
+                break;
+        }
+
+        _qfb_fb_clear(fb);
+
+        if (B >= Bmax)
+            flint_throw(FLINT_ERROR, "%s: no relation lattice found with "
+                "factor base bound %wu\n", __FUNCTION__, B);
+
+        B = 2 * B;
+    }
+
+    n = fb->num;
+    _qfb_fb_clear(fb);
+
+    fmpz_mat_init(S, n, n);
+    fmpz_mat_snf(S, H);
+
+    fmpz_one(h);
+    for (i = 0, num = 0; i < n; i++)
+    {
+        fmpz_mul(h, h, fmpz_mat_entry(S, i, i));
+        num += !fmpz_is_one(fmpz_mat_entry(S, i, i));
+    }
+
+    *invariants = _fmpz_vec_init(num);
+    for (i = n - num; i < n; i++)
+        fmpz_set(*invariants + i - (n - num), fmpz_mat_entry(S, i, i));
+
+    fmpz_mat_clear(S);
+    fmpz_mat_clear(H);
+
+    return num;
+}
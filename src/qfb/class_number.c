@@ -0,0 +1,22 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "qfb.h"
+
+void qfb_class_number(fmpz_t h, const fmpz_t D)
+{
+    fmpz * invariants;
+    slong num;
+
+    num = qfb_class_group(&invariants, h, D);
+
+    _fmpz_vec_clear(invariants, num);
+}
@@ -18,7 +18,7 @@
 
 void qfb_hash_clear(qfb_hash_t * qhash, slong depth)
 {
-   slong i, size = (1L<<depth);
+   slong i, size = (WORD(1)<<depth);
 
    for (i = 0; i < size; i++)
    {
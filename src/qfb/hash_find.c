@@ -19,23 +19,16 @@
 
 slong qfb_hash_find(qfb_hash_t * qhash, qfb_t q, slong depth)
 {
-   slong size = (1L<<depth), i;
-   fmpz_t r;
+   slong size = (WORD(1)<<depth), i;
 
-   fmpz_init(r);
-
-   fmpz_fdiv_r_2exp(r, q->a, depth);
-   i = fmpz_get_ui(r);
+   i = _qfb_hash_index(q, depth);
 
    while (!fmpz_is_zero(qhash[i].q->a))
    {
       if (fmpz_cmp(qhash[i].q->a, q->a) == 0)
       {
          if (fmpz_cmpabs(qhash[i].q->b, q->b) == 0)
-         {
-            fmpz_clear(r);
             return i;
-         }
       }
 
       i++;
@@ -43,6 +36,5 @@ slong qfb_hash_find(qfb_hash_t * qhash, qfb_t q, slong depth)
          i = 0;
    }
 
-   fmpz_clear(r);
    return -1;
 }
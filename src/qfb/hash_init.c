@@ -18,7 +18,7 @@
 
 qfb_hash_t * qfb_hash_init(slong depth)
 {
-   slong i, size = (1L<<depth);
+   slong i, size = (WORD(1)<<depth);
    qfb_hash_t * qhash = flint_malloc(size*sizeof(qfb_hash_t));
 
    for (i = 0; i < size; i++)
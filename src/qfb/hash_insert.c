@@ -19,13 +19,9 @@
 
 void qfb_hash_insert(qfb_hash_t * qhash, qfb_t q, qfb_t q2, slong iter, slong depth)
 {
-   slong size = (1L<<depth), i;
-   fmpz_t r;
+   slong size = (WORD(1)<<depth), i;
 
-   fmpz_init(r);
-
-   fmpz_fdiv_r_2exp(r, q->a, depth);
-   i = fmpz_get_ui(r);
+   i = _qfb_hash_index(q, depth);
 
    while (!fmpz_is_zero(qhash[i].q->a))
    {
@@ -38,6 +34,4 @@ void qfb_hash_insert(qfb_hash_t * qhash, qfb_t q, qfb_t q2, slong iter, slong de
    qhash[i].iter = iter;
    if (q2 != NULL)
       qfb_set(qhash[i].q2, q2);
-
-   fmpz_clear(r);
 }
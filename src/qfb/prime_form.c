@@ -19,7 +19,7 @@
 #include "fmpz.h"
 #include "qfb.h"
 
-void qfb_prime_form(qfb_t r, fmpz_t D, fmpz_t p)
+void qfb_prime_form(qfb_t r, const fmpz_t D, const fmpz_t p)
 {
    fmpz_t q, rem, s, t;
 
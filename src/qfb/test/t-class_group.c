@@ -0,0 +1,178 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "qfb.h"
+
+int main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("class_group....");
+    fflush(stdout);
+
+    /* compare with the reduced forms for small discriminants */
+    for (iter = 0; iter < 50 * flint_test_multiplier(); iter++)
+    {
+        fmpz_t D, h, L, e, o;
+        fmpz * inv;
+        qfb * forms;
+        qfb_t pow;
+        slong d, num, r, i, order, two_rank, ambiguous;
+        int result;
+
+        do {
+            d = n_randint(state, 20000) + 3;
+        } while (d % 4 != 0 && d % 4 != 3);
+
+        num = qfb_reduced_forms(&forms, -d);
+
+        if (num == 0)
+            continue;
+
+        fmpz_init(D);
+        fmpz_init(h);
+        fmpz_init(L);
+        fmpz_init(e);
+        fmpz_init(o);
+        qfb_init(pow);
+
+        fmpz_set_si(D, -d);
+        fmpz_abs(L, D);
+        fmpz_root(L, L, 4);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        r = qfb_class_group(&inv, h, D);
+
+        result = (fmpz_cmp_si(h, num) == 0);
+        fmpz_one(e);
+        two_rank = 0;
+        for (i = 0; i < r && result; i++)
+        {
+            fmpz_mul(e, e, inv + i);
+            result = (fmpz_cmp_ui(inv + i, 1) > 0) &&
+                (i == 0 || fmpz_divisible(inv + i, inv + i - 1));
+            two_rank += fmpz_is_even(inv + i);
+        }
+        result = result && fmpz_equal(e, h);
+
+        if (!result)
+        {
+            flint_printf("FAIL (class number):\n");
+            flint_printf("D = "); fmpz_print(D);
+            flint_printf(", h = %wd, computed h = ", num); fmpz_print(h);
+            flint_printf("\ninvariants: "); _fmpz_vec_print(inv, r);
+            flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* the largest invariant is the exponent and the 2-rank is right */
+        fmpz_one(e);
+        ambiguous = 0;
+        for (i = 0; i < num; i++)
+        {
+            qfb_set(pow, forms + i);
+            for (order = 1; !qfb_is_principal_form(pow, D); order++)
+            {
+                qfb_nucomp(pow, pow, forms + i, D, L);
+                qfb_reduce(pow, pow, D);
+            }
+
+            fmpz_set_ui(o, order);
+            fmpz_lcm(e, e, o);
+            ambiguous += (order <= 2);
+        }
+
+        result = (r == 0) ? fmpz_is_one(e) : fmpz_equal(e, inv + r - 1);
+        result = result && (ambiguous == (WORD(1) << two_rank));
+
+        if (!result)
+        {
+            flint_printf("FAIL (structure):\n");
+            flint_printf("D = "); fmpz_print(D);
+            flint_printf(", exponent = "); fmpz_print(e);
+            flint_printf(", ambiguous forms = %wd\ninvariants: ", ambiguous);
+            _fmpz_vec_print(inv, r);
+            flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(inv, r);
+        qfb_array_clear(&forms, num);
+        qfb_clear(pow);
+        fmpz_clear(D);
+        fmpz_clear(h);
+        fmpz_clear(L);
+        fmpz_clear(e);
+        fmpz_clear(o);
+    }
+
+    /* larger discriminants: the exponent agrees with qfb_exponent_grh and
+       the result does not depend on the number of threads */
+    for (iter = 0; iter < 3 * flint_test_multiplier(); iter++)
+    {
+        fmpz_t D, h, h2, e;
+        fmpz * inv, * inv2;
+        slong r, r2;
+
+        fmpz_init(D);
+        fmpz_init(h);
+        fmpz_init(h2);
+        fmpz_init(e);
+
+        do {
+            fmpz_randbits(D, state, 30 + n_randint(state, 30));
+            fmpz_abs(D, D);
+            fmpz_neg(D, D);
+        } while (fmpz_fdiv_ui(D, 4) > 1 || fmpz_is_zero(D));
+
+        flint_set_num_threads(1);
+        r = qfb_class_group(&inv, h, D);
+
+        flint_set_num_threads(2 + n_randint(state, 3));
+        r2 = qfb_class_group(&inv2, h2, D);
+
+        if (r != r2 || !fmpz_equal(h, h2) || !_fmpz_vec_equal(inv, inv2, r))
+        {
+            flint_printf("FAIL (threads):\n");
+            flint_printf("D = "); fmpz_print(D); flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (qfb_exponent_grh(e, D, 1000000, 100000) &&
+            !fmpz_equal(e, (r == 0) ? h : inv + r - 1))
+        {
+            flint_printf("FAIL (exponent):\n");
+            flint_printf("D = "); fmpz_print(D);
+            flint_printf(", exponent = "); fmpz_print(e);
+            flint_printf("\ninvariants: "); _fmpz_vec_print(inv, r);
+            flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(inv, r);
+        _fmpz_vec_clear(inv2, r2);
+        fmpz_clear(D);
+        fmpz_clear(h);
+        fmpz_clear(h2);
+        fmpz_clear(e);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -291,7 +291,9 @@ ulong n_euler_phi(ulong n);
 #define FLINT_PSEUDOSQUARES_CUTOFF 1000
 #define FLINT_PRIMES_TAB_DEFAULT_CUTOFF 1000000
 #define FLINT_PRIME_PI_ODD_LOOKUP_CUTOFF 311
+#define FLINT_PRIME_PI_LMO_CUTOFF (UWORD(1) << 21)
 #define FLINT_SIEVE_SIZE 65536
+#define FLINT_SIEVE_MAX_BYTES 32768
 
 #if FLINT64
 # define UWORD_MAX_PRIME UWORD(18446744073709551557)
@@ -300,6 +302,7 @@ ulong n_euler_phi(ulong n);
 #endif
 
 FLINT_DLL extern const unsigned int flint_primes_small[];
+FLINT_DLL extern const unsigned char flint_wheel30_residues[8];
 
 extern FLINT_TLS_PREFIX ulong * _flint_primes[FLINT_BITS];
 extern FLINT_TLS_PREFIX double * _flint_prime_inverses[FLINT_BITS];
@@ -311,6 +314,9 @@ void n_primes_clear(n_primes_t iter);
 void n_primes_extend_small(n_primes_t iter, ulong bound);
 void n_primes_sieve_range(n_primes_t iter, ulong a, ulong b);
 void n_primes_jump_after(n_primes_t iter, ulong n);
+void _n_sieve_wheel30(unsigned char * sieve, ulong low, slong len,
+    const unsigned int * primes, slong num_primes);
+ulong * n_primes_range(slong * num, ulong a, ulong b);
 
 ulong n_primes_next(n_primes_t iter);
 
@@ -341,6 +347,7 @@ void n_nth_prime_bounds(ulong *lo, ulong *hi, ulong n);
 
 ulong n_prime_pi(ulong n);
 void n_prime_pi_bounds(ulong *lo, ulong *hi, ulong n);
+ulong _n_prime_pi_lmo(ulong n);
 
 ulong n_nextprime(ulong n, int proved);
 
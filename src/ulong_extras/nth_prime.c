@@ -9,17 +9,111 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include <math.h>
 #include "ulong_extras.h"
 
+/* Once the exact count is within this many primes we sieve forward. */
+#define NTH_PRIME_SCAN (UWORD(1) << 20)
+
+/* The correction of the initial estimate normally takes a few steps. */
+#define NTH_PRIME_MAX_CORRECTIONS 100
+
+/* pi(UWORD_MAX_PRIME) = pi(2^FLINT_BITS) */
+#if FLINT64
+# define UWORD_MAX_PRIME_PI UWORD(425656284035217743)
+#else
+# define UWORD_MAX_PRIME_PI UWORD(203280221)
+#endif
+
+/* Logarithmic integral by Ramanujan's series, for x >= 2. */
+static double
+_n_li(double x)
+{
+    double L, t, inner, sum, u;
+    slong n;
+
+    L = log(x);
+    t = 1.0;
+    inner = 0.0;
+    sum = 0.0;
+
+    for (n = 1; n < 1000; n++)
+    {
+        /* t = (-1)^(n-1) L^n / (n! 2^(n-1)) */
+        t *= (n == 1) ? L : -L / (2 * n);
+        if (n % 2 == 1)
+            inner += 1.0 / n;
+
+        u = t * inner;
+        sum += u;
+
+        if (n > L && fabs(u) < 1e-17 * fabs(sum))
+            break;
+    }
+
+    return 0.57721566490153286 + log(L) + sqrt(x) * sum;
+}
+
 mp_limb_t n_nth_prime(ulong n)
 {
+    double x, d;
+    ulong c, p;
+    slong i;
+    n_primes_t iter;
+
     if (n == 0)
     {
         flint_printf("Exception (n_nth_prime). n_nth_prime(0) is undefined.\n");
         flint_abort();
     }
 
-    return n_primes_arr_readonly(n)[n-1];
+    if (n > UWORD_MAX_PRIME_PI)
+        flint_throw(FLINT_ERROR, "n_nth_prime: the %wu-th prime does not fit in a limb\n", n);
+
+    if (n < FLINT_PRIME_PI_LMO_CUTOFF / 16)
+        return n_primes_arr_readonly(n)[n-1];
+
+    /* x = li^(-1)(n) by Newton iteration */
+    x = n * log((double) n);
+    for (c = 0; c < 8; c++)
+        x -= (_n_li(x) - n) * log(x);
+
+    /* move x below p_n, and close enough to sieve forward */
+    for (i = 0; ; i++)
+    {
+        if (i >= NTH_PRIME_MAX_CORRECTIONS)
+            flint_throw(FLINT_ERROR, "n_nth_prime: no convergence for n = %wu\n", n);
+
+        /* (double) UWORD_MAX_PRIME may round up to 2^FLINT_BITS */
+        if (x >= (double) UWORD_MAX_PRIME)
+        {
+            x = (double) UWORD_MAX_PRIME;
+            p = UWORD_MAX_PRIME;
+        }
+        else
+        {
+            p = (ulong) x;
+        }
+        c = n_prime_pi(p);
+
+        if (c < n && n - c <= NTH_PRIME_SCAN)
+            break;
+
+        d = ((double) n - (double) c) * log(x);
+        if (c >= n)
+            d -= sqrt(x);
+        x += d;
+    }
+
+    n_primes_init(iter);
+    n_primes_jump_after(iter, p);
+
+    for ( ; c < n; c++)
+        p = n_primes_next(iter);
+
+    n_primes_clear(iter);
+
+    return p;
 }
 
 void n_nth_prime_bounds(mp_limb_t *lo, mp_limb_t *hi, ulong n)
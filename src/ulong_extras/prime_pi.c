@@ -35,6 +35,10 @@ ulong n_prime_pi(mp_limb_t n)
         return FLINT_PRIME_PI_ODD_LOOKUP[(n-1)/2];
     }
 
+    /* counting without listing the primes */
+    if (n >= FLINT_PRIME_PI_LMO_CUTOFF)
+        return _n_prime_pi_lmo(n);
+
     n_prime_pi_bounds(&low, &high, n);
     primes = n_primes_arr_readonly(high + 1);
 
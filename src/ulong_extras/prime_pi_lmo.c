@@ -0,0 +1,488 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <limits.h>
+#include "thread_support.h"
+#include "ulong_extras.h"
+
+/*
+    Prime counting by the method of Lagarias, Miller and Odlyzko, with the
+    special leaves handled by a segmented sieve as in Deleglise and Rivat.
+
+    With y >= x^(1/3) and a = pi(y) we have
+
+        pi(x) = phi(x, a) + a - 1 - P2(x, a),
+        phi(x, a) = sum_{m <= y} mu(m) floor(x/m)
+                  - sum_{b, m} mu(m) phi(x / (m p_b), b - 1),
+
+    where the second sum is over the special leaves y < m p_b, lpf(m) > p_b,
+    and P2(x, a) counts the products of two primes > y not exceeding x.
+    Both the special leaves and P2 only need values below x / y, which are
+    sieved in segments of about sqrt(x / y) bits. The segments are split
+    into chunks that are processed independently by the worker threads;
+    each chunk counts relative to its own start and the chunks are glued
+    together afterwards using prefix sums. The memory use is O(y) for the
+    small tables plus O(sqrt(x / y)) per thread.
+
+    Intermediate sums may exceed a limb, but all arithmetic is done modulo
+    2^FLINT_BITS and the final value pi(x) < 2^FLINT_BITS is exact.
+*/
+
+typedef struct
+{
+    ulong x;
+    ulong y;
+    ulong sqrtx;
+    ulong lo;               /* the sieved values lie in [lo, limit) */
+    ulong limit;
+    ulong seg_size;         /* bits per segment, a multiple of FLINT_BITS */
+    slong segs_per_chunk;
+    const unsigned int * primes;    /* the a primes <= y */
+    slong a;
+    const unsigned int * lpf;       /* least prime factor of m <= y */
+    const signed char * mu;         /* Moebius function of m <= y */
+
+    /* output for the special leaves, per chunk */
+    ulong * s2;
+    ulong * mu_sum;         /* num_chunks * a entries */
+    ulong * phi;            /* num_chunks * a entries */
+
+    /* output for P2, per chunk */
+    ulong * p2_sum;
+    ulong * p2_num;
+    ulong * count;
+}
+_lmo_args_t;
+
+/* number of set bits in positions [start, end) */
+static ulong
+_lmo_count_bits(const ulong * bits, ulong start, ulong end)
+{
+    ulong c, s, e, w;
+
+    if (start >= end)
+        return 0;
+
+    s = start / FLINT_BITS;
+    e = (end - 1) / FLINT_BITS;
+
+    if (s == e)
+    {
+        w = bits[s] >> (start % FLINT_BITS);
+        w &= (~UWORD(0)) >> (FLINT_BITS - 1 - (end - 1 - start));
+        return mpn_popcount(&w, 1);
+    }
+
+    w = bits[s] >> (start % FLINT_BITS);
+    c = mpn_popcount(&w, 1);
+
+    if (e > s + 1)
+        c += mpn_popcount(bits + s + 1, e - s - 1);
+
+    w = bits[e] & ((~UWORD(0)) >> (FLINT_BITS - 1 - ((end - 1) % FLINT_BITS)));
+    c += mpn_popcount(&w, 1);
+
+    return c;
+}
+
+static void
+_lmo_set_ones(ulong * bits, ulong len)
+{
+    ulong i, words = (len + FLINT_BITS - 1) / FLINT_BITS;
+
+    for (i = 0; i < words; i++)
+        bits[i] = ~UWORD(0);
+
+    if (len % FLINT_BITS != 0)
+        bits[words - 1] = (UWORD(1) << (len % FLINT_BITS)) - 1;
+}
+
+/* clears the multiples of p that are >= start */
+static void
+_lmo_cross_off(ulong * bits, ulong low, ulong len, ulong p, ulong start)
+{
+    ulong i;
+
+    if (start < low)
+        start = low;
+    if (start % p != 0)
+        start += p - start % p;
+
+    for (i = start - low; i < len; i += p)
+        bits[i / FLINT_BITS] &= ~(UWORD(1) << (i % FLINT_BITS));
+}
+
+/* bit i is set iff low + i is prime, for low >= 2 and len <= y^2 */
+static void
+_lmo_sieve_primes(ulong * bits, ulong low, ulong len, const unsigned int * primes, slong a)
+{
+    ulong p, high = low + len;
+    slong i;
+
+    _lmo_set_ones(bits, len);
+
+    for (i = 0; i < a; i++)
+    {
+        p = primes[i];
+
+        if (p * p >= high)
+            break;
+
+        _lmo_cross_off(bits, low, len, p, p * p);
+    }
+}
+
+/* the special leaf sieve keeps a count of the set bits per block */
+#define LMO_BLOCK_BITS (16 * FLINT_BITS)
+
+static void
+_lmo_s2_worker(slong t, void * _args)
+{
+    _lmo_args_t * args = (_lmo_args_t *) _args;
+    ulong x = args->x, y = args->y, seg = args->seg_size;
+    ulong low, high, len, p, m, min_m, max_m, v, i, k, c, s2, total, mask;
+    ulong * bits, * phi, * mu_sum, * counts;
+    slong j, b, a = args->a;
+
+    phi = args->phi + t * a;
+    mu_sum = args->mu_sum + t * a;
+    bits = flint_malloc(sizeof(ulong) * (seg / FLINT_BITS));
+    counts = flint_malloc(sizeof(ulong) * (seg / LMO_BLOCK_BITS + 1));
+    s2 = 0;
+
+    for (j = 0; j < args->segs_per_chunk; j++)
+    {
+        low = args->lo + (t * args->segs_per_chunk + j) * seg;
+        if (low >= args->limit)
+            break;
+        high = FLINT_MIN(low + seg, args->limit);
+        len = high - low;
+
+        _lmo_set_ones(bits, len);
+        for (k = 0; k * LMO_BLOCK_BITS < len; k++)
+            counts[k] = FLINT_MIN(LMO_BLOCK_BITS, len - k * LMO_BLOCK_BITS);
+        total = len;
+
+        for (b = 0; b < a; b++)
+        {
+            p = args->primes[b];
+
+            /* leaves m p with x / (m p) in [low, high), m p > y, m <= y */
+            max_m = FLINT_MIN(x / p / low, y);
+            if (p >= max_m)
+                break;
+            min_m = FLINT_MAX(x / p / high, y / p);
+
+            /* c is the number of set bits before block k */
+            k = 0;
+            c = 0;
+
+            if (p <= y / p)
+            {
+                for (m = max_m; m > min_m; m--)
+                {
+                    if (args->mu[m] != 0 && args->lpf[m] > p)
+                    {
+                        v = x / p / m - low + 1;
+
+                        while ((k + 1) * LMO_BLOCK_BITS <= v)
+                            c += counts[k++];
+
+                        v = c + _lmo_count_bits(bits, k * LMO_BLOCK_BITS, v);
+
+                        if (args->mu[m] > 0)
+                        {
+                            s2 -= phi[b] + v;
+                            mu_sum[b]++;
+                        }
+                        else
+                        {
+                            s2 += phi[b] + v;
+                            mu_sum[b]--;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                /* p^2 > y, so m must be a prime in (max(p, min_m), max_m] */
+                slong lo_i, hi_i, mid;
+
+                lo_i = b + 1;
+                hi_i = a;
+                while (lo_i < hi_i)
+                {
+                    mid = (lo_i + hi_i) / 2;
+                    if (args->primes[mid] <= max_m)
+                        lo_i = mid + 1;
+                    else
+                        hi_i = mid;
+                }
+
+                for (i = lo_i; i > (ulong) b + 1 && args->primes[i - 1] > min_m; i--)
+                {
+                    v = x / p / args->primes[i - 1] - low + 1;
+
+                    while ((k + 1) * LMO_BLOCK_BITS <= v)
+                        c += counts[k++];
+
+                    v = c + _lmo_count_bits(bits, k * LMO_BLOCK_BITS, v);
+
+                    s2 += phi[b] + v;
+                    mu_sum[b]--;
+                }
+            }
+
+            phi[b] += total;
+
+            /* cross off the multiples of p, updating the counts */
+            i = (low % p == 0) ? 0 : p - low % p;
+            for ( ; i < len; i += p)
+            {
+                mask = UWORD(1) << (i % FLINT_BITS);
+
+                if (bits[i / FLINT_BITS] & mask)
+                {
+                    bits[i / FLINT_BITS] &= ~mask;
+                    counts[i / LMO_BLOCK_BITS]--;
+                    total--;
+                }
+            }
+        }
+    }
+
+    args->s2[t] = s2;
+    flint_free(bits);
+    flint_free(counts);
+}
+
+static void
+_lmo_p2_worker(slong t, void * _args)
+{
+    _lmo_args_t * args = (_lmo_args_t *) _args;
+    ulong x = args->x, y = args->y, seg = args->seg_size;
+    ulong low, high, len, plo, phi, plen, palloc, pos, c, v, count, sum, num;
+    ulong * bits, * pbits;
+    slong i, j;
+
+    bits = flint_malloc(sizeof(ulong) * (seg / FLINT_BITS));
+    palloc = seg + 2 * FLINT_BITS;
+    pbits = flint_malloc(sizeof(ulong) * (palloc / FLINT_BITS));
+
+    count = sum = num = 0;
+
+    for (j = 0; j < args->segs_per_chunk; j++)
+    {
+        low = args->lo + (t * args->segs_per_chunk + j) * seg;
+        if (low >= args->limit)
+            break;
+        high = FLINT_MIN(low + seg, args->limit);
+        len = high - low;
+
+        _lmo_sieve_primes(bits, low, len, args->primes, args->a);
+
+        /* primes p in (plo, phi] have x / p in [low, high) */
+        phi = FLINT_MIN(args->sqrtx, x / low);
+        plo = FLINT_MAX(y, x / high);
+
+        if (phi > plo)
+        {
+            plen = phi - plo;
+
+            if (plen > palloc)
+            {
+                palloc = plen + FLINT_BITS;
+                pbits = flint_realloc(pbits, sizeof(ulong) * (palloc / FLINT_BITS + 1));
+            }
+
+            _lmo_sieve_primes(pbits, plo + 1, plen, args->primes, args->a);
+
+            pos = 0;
+            c = 0;
+
+            for (i = plen - 1; i >= 0; i--)
+            {
+                if ((pbits[i / FLINT_BITS] >> (i % FLINT_BITS)) & 1)
+                {
+                    v = x / (plo + 1 + i) - low + 1;
+                    c += _lmo_count_bits(bits, pos, v);
+                    pos = v;
+                    sum += count + c;
+                    num++;
+                }
+            }
+        }
+
+        count += _lmo_count_bits(bits, 0, len);
+    }
+
+    args->p2_sum[t] = sum;
+    args->p2_num[t] = num;
+    args->count[t] = count;
+
+    flint_free(bits);
+    flint_free(pbits);
+}
+
+ulong
+_n_prime_pi_lmo(ulong x)
+{
+    _lmo_args_t args;
+    unsigned int * primes, * lpf;
+    signed char * mu;
+    ulong y, i, j, p, s1, s2, p2, base, B, seg, num_segs, * prefix;
+    slong a, t, num_chunks, num_threads;
+    double alpha;
+
+    if (x < 64)
+        return n_prime_pi(x);
+
+    /* y = alpha x^(1/3) with y^3 >= x; the slowly growing factor alpha
+       balances the number of special leaves against the sieving work */
+    y = n_cbrt(x);
+    if (y * y * y < x)
+        y++;
+    alpha = log((double) x);
+    alpha = FLINT_MAX(1.0, alpha * alpha / 300.0);
+    y = FLINT_MIN((ulong) (y * alpha), n_sqrt(x));
+
+    /* tables for m <= y */
+    lpf = flint_calloc(y + 1, sizeof(unsigned int));
+    mu = flint_malloc(y + 1);
+    primes = flint_malloc(sizeof(unsigned int) * (y / 2 + 2));
+
+    for (i = 1; i <= y; i++)
+        mu[i] = 1;
+    lpf[1] = UINT_MAX;
+
+    a = 0;
+    for (i = 2; i <= y; i++)
+    {
+        if (lpf[i] != 0)
+            continue;
+
+        primes[a++] = i;
+
+        for (j = i; j <= y; j += i)
+        {
+            if (lpf[j] == 0)
+                lpf[j] = i;
+            mu[j] = -mu[j];
+        }
+
+        if (i <= y / i)
+            for (j = i * i; j <= y; j += i * i)
+                mu[j] = 0;
+    }
+
+    /* ordinary leaves */
+    s1 = 0;
+    for (i = 1; i <= y; i++)
+    {
+        if (mu[i] > 0)
+            s1 += x / i;
+        else if (mu[i] < 0)
+            s1 -= x / i;
+    }
+
+    args.x = x;
+    args.y = y;
+    args.sqrtx = n_sqrt(x);
+    args.primes = primes;
+    args.a = a;
+    args.lpf = lpf;
+    args.mu = mu;
+
+    /* all values to be sieved are < x / y + 1 */
+    args.limit = x / y + 1;
+    seg = FLINT_MAX(n_sqrt(args.limit), UWORD(1) << 15);
+    seg = ((seg + FLINT_BITS - 1) / FLINT_BITS) * FLINT_BITS;
+    args.seg_size = seg;
+
+    num_threads = flint_get_num_threads();
+
+    /* special leaves: values in [1, x / y] */
+    args.lo = 1;
+    num_segs = (args.limit - args.lo + seg - 1) / seg;
+    num_chunks = FLINT_MIN((ulong) (4 * num_threads), num_segs);
+    if (num_threads == 1)
+        num_chunks = 1;
+    args.segs_per_chunk = (num_segs + num_chunks - 1) / num_chunks;
+    num_chunks = (num_segs + args.segs_per_chunk - 1) / args.segs_per_chunk;
+
+    args.s2 = flint_malloc(sizeof(ulong) * num_chunks);
+    args.mu_sum = flint_calloc(num_chunks * a, sizeof(ulong));
+    args.phi = flint_calloc(num_chunks * a, sizeof(ulong));
+
+    flint_parallel_do(_lmo_s2_worker, &args, num_chunks, -1, FLINT_PARALLEL_DYNAMIC);
+
+    /* each chunk counted phi relative to its own start */
+    prefix = flint_calloc(a, sizeof(ulong));
+    s2 = 0;
+    for (t = 0; t < num_chunks; t++)
+    {
+        s2 += args.s2[t];
+
+        for (j = 0; j < (ulong) a; j++)
+        {
+            s2 -= args.mu_sum[t * a + j] * prefix[j];
+            prefix[j] += args.phi[t * a + j];
+        }
+    }
+
+    flint_free(prefix);
+    flint_free(args.s2);
+    flint_free(args.mu_sum);
+    flint_free(args.phi);
+
+    /* P2: primes in [y + 1, x / y] */
+    args.lo = y + 1;
+    num_segs = (args.limit > args.lo) ? (args.limit - args.lo + seg - 1) / seg : 0;
+    p2 = 0;
+    B = a;
+
+    if (num_segs != 0)
+    {
+        num_chunks = FLINT_MIN((ulong) (4 * num_threads), num_segs);
+        if (num_threads == 1)
+            num_chunks = 1;
+        args.segs_per_chunk = (num_segs + num_chunks - 1) / num_chunks;
+        num_chunks = (num_segs + args.segs_per_chunk - 1) / args.segs_per_chunk;
+
+        args.p2_sum = flint_malloc(sizeof(ulong) * num_chunks);
+        args.p2_num = flint_malloc(sizeof(ulong) * num_chunks);
+        args.count = flint_malloc(sizeof(ulong) * num_chunks);
+
+        flint_parallel_do(_lmo_p2_worker, &args, num_chunks, -1, FLINT_PARALLEL_DYNAMIC);
+
+        base = a;
+        for (t = 0; t < num_chunks; t++)
+        {
+            p2 += args.p2_sum[t] + args.p2_num[t] * base;
+            base += args.count[t];
+            B += args.p2_num[t];
+        }
+
+        flint_free(args.p2_sum);
+        flint_free(args.p2_num);
+        flint_free(args.count);
+    }
+
+    /* subtract sum_{a < b <= pi(sqrt(x))} (b - 1) */
+    p2 -= (B * (B - 1)) / 2 - ((ulong) a * (a - 1)) / 2;
+
+    flint_free(primes);
+    flint_free(lpf);
+    flint_free(mu);
+
+    p = s1 + s2;
+
+    return p + a - 1 - p2;
+}
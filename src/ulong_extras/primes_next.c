@@ -10,22 +10,44 @@
 */
 
 #include "ulong_extras.h"
+#include "longlong.h"
 
 ulong
 n_primes_next(n_primes_t iter)
 {
+    ulong len;
+    unsigned int c;
+
     if (iter->small_i < iter->small_num)
         return iter->small_primes[(iter->small_i)++];
 
     for (;;)
     {
         while (iter->sieve_i < iter->sieve_num)
-            if (iter->sieve[iter->sieve_i++] != 0)
-                return iter->sieve_a + 2 * (iter->sieve_i - 1);
+        {
+            c = iter->sieve[iter->sieve_i];
+
+            if (c != 0)
+            {
+                iter->sieve[iter->sieve_i] = c & (c - 1);
+                return iter->sieve_a + 30 * iter->sieve_i
+                    + flint_wheel30_residues[flint_ctz(c)];
+            }
+
+            iter->sieve_i++;
+        }
 
         if (iter->sieve_b == 0)
+        {
             n_primes_jump_after(iter, iter->small_primes[iter->small_num-1]);
+        }
         else
-            n_primes_jump_after(iter, iter->sieve_b);
+        {
+            /* consecutive blocks grow up to the maximum sieve size */
+            len = FLINT_MIN(2 * (iter->sieve_b - iter->sieve_a),
+                            30 * (ulong) (FLINT_SIEVE_MAX_BYTES - 2));
+            len = FLINT_MIN(len, UWORD_MAX - iter->sieve_b);
+            n_primes_sieve_range(iter, iter->sieve_b + 1, iter->sieve_b + len);
+        }
     }
 }
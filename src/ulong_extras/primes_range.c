@@ -0,0 +1,148 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "ulong_extras.h"
+#include "longlong.h"
+
+typedef struct
+{
+    ulong low;                      /* multiple of 30 */
+    ulong a;
+    ulong b;
+    slong total_bytes;
+    slong chunk_bytes;
+    const unsigned int * primes;
+    slong num_primes;
+    ulong ** res;
+    slong * num;
+}
+_primes_range_args_t;
+
+static void
+_n_primes_range_worker(slong t, void * _args)
+{
+    _primes_range_args_t * args = (_primes_range_args_t *) _args;
+    unsigned char * sieve;
+    ulong * res, low, p;
+    slong start, end, i, len, num, alloc;
+    unsigned int c;
+
+    start = t * args->chunk_bytes;
+    end = FLINT_MIN(start + args->chunk_bytes, args->total_bytes);
+
+    sieve = flint_malloc(FLINT_SIEVE_MAX_BYTES);
+    alloc = 16;
+    res = flint_malloc(sizeof(ulong) * alloc);
+    num = 0;
+
+    for ( ; start < end; start += len)
+    {
+        len = FLINT_MIN(FLINT_SIEVE_MAX_BYTES, end - start);
+        low = args->low + 30 * (ulong) start;
+
+        _n_sieve_wheel30(sieve, low, len, args->primes, args->num_primes);
+
+        for (i = 0; i < len; i++)
+        {
+            for (c = sieve[i]; c != 0; c &= c - 1)
+            {
+                p = low + 30 * (ulong) i + flint_wheel30_residues[flint_ctz(c)];
+
+                if (p < args->a || p > args->b)
+                    continue;
+
+                if (num == alloc)
+                {
+                    alloc *= 2;
+                    res = flint_realloc(res, sizeof(ulong) * alloc);
+                }
+
+                res[num++] = p;
+            }
+        }
+    }
+
+    flint_free(sieve);
+
+    args->res[t] = res;
+    args->num[t] = num;
+}
+
+ulong *
+n_primes_range(slong * num, ulong a, ulong b)
+{
+    _primes_range_args_t args;
+    n_primes_t iter;
+    ulong * res, bound;
+    slong i, t, num_chunks, num_threads, len, total;
+
+    total = 0;
+    res = flint_malloc(sizeof(ulong) * 3);
+
+    /* the wheel does not represent 2, 3 and 5 */
+    for (i = 0; i < 3; i++)
+        if (a <= flint_primes_small[i] && flint_primes_small[i] <= b)
+            res[total++] = flint_primes_small[i];
+
+    if (b < 7 || a > b)
+    {
+        *num = total;
+        return res;
+    }
+
+    a = FLINT_MAX(a, 7);
+    bound = n_sqrt(b) + 1;
+
+    n_primes_init(iter);
+    n_primes_extend_small(iter, bound);
+
+    args.low = a - a % 30;
+    args.a = a;
+    args.b = b;
+    args.total_bytes = (b - args.low) / 30 + 1;
+    args.primes = iter->small_primes;
+    for (args.num_primes = 0; iter->small_primes[args.num_primes] <= bound;
+                                                             args.num_primes++)
+        ;
+
+    /* hand out whole segments, a few per thread so that uneven chunks
+       still balance */
+    num_threads = flint_get_num_threads();
+    len = (args.total_bytes + FLINT_SIEVE_MAX_BYTES - 1) / FLINT_SIEVE_MAX_BYTES;
+    num_chunks = (num_threads == 1) ? 1 : FLINT_MIN(len, 4 * num_threads);
+    args.chunk_bytes = ((len + num_chunks - 1) / num_chunks) * FLINT_SIEVE_MAX_BYTES;
+    num_chunks = (args.total_bytes + args.chunk_bytes - 1) / args.chunk_bytes;
+
+    args.res = flint_malloc(sizeof(ulong *) * num_chunks);
+    args.num = flint_malloc(sizeof(slong) * num_chunks);
+
+    flint_parallel_do(_n_primes_range_worker, &args, num_chunks, -1, FLINT_PARALLEL_DYNAMIC);
+
+    /* concatenate in order */
+    len = total;
+    for (t = 0; t < num_chunks; t++)
+        len += args.num[t];
+
+    res = flint_realloc(res, sizeof(ulong) * FLINT_MAX(len, 1));
+
+    for (t = 0; t < num_chunks; t++)
+    {
+        for (i = 0; i < args.num[t]; i++)
+            res[total++] = args.res[t][i];
+        flint_free(args.res[t]);
+    }
+
+    flint_free(args.res);
+    flint_free(args.num);
+    n_primes_clear(iter);
+
+    *num = total;
+    return res;
+}
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
 #include "flint.h"
 #include "ulong_extras.h"
 
@@ -57,20 +58,151 @@ n_sieve_odd(char * sieve, ulong n, mp_limb_t a,
     }
 }
 
+/* Wheel modulo 30: bit j of byte i stands for 30 i + flint_wheel30_residues[j]. */
+const unsigned char flint_wheel30_residues[8] = { 1, 7, 11, 13, 17, 19, 23, 29 };
+
+/* bit of the residue r mod 30, or 8 if gcd(r, 30) > 1 */
+static const unsigned char wheel30_bit[30] =
+{
+    8, 0, 8, 8, 8, 8, 8, 1, 8, 8, 8, 2, 8, 3, 8, 8,
+    8, 4, 8, 5, 8, 8, 8, 6, 8, 8, 8, 8, 8, 7
+};
+
+/* Presieving pattern for 7, 11 and 13, with period 7 * 11 * 13 bytes. */
+#define WHEEL30_PATTERN_LEN 1001
+
+static const unsigned char wheel30_pattern[WHEEL30_PATTERN_LEN] =
+{
+    0xf1, 0xdf, 0xef, 0x7e, 0xb6, 0xdb, 0x3d, 0xf9, 0xd5, 0x6f, 0x5e, 0xf3, 0xeb, 0xa7, 0xfd, 0x9e,
+    0xee, 0x3c, 0xd7, 0xf3, 0xbb, 0xdd, 0x5b, 0xef, 0x6e, 0xe7, 0xb2, 0xbf, 0x7d, 0xde, 0xa7, 0x5e,
+    0xd7, 0xfb, 0xbd, 0x6d, 0xdf, 0xae, 0x6e, 0x75, 0xfb, 0xb7, 0xfc, 0x9f, 0xcb, 0x7e, 0xe3, 0xf9,
+    0x3e, 0xfd, 0x5d, 0xef, 0x76, 0xf7, 0xdb, 0xba, 0xbd, 0xcf, 0xef, 0x3a, 0xf5, 0x79, 0xbf, 0xf5,
+    0xcf, 0xc7, 0x7a, 0xf7, 0xea, 0xbf, 0x9c, 0xdf, 0x69, 0x7c, 0x77, 0xfb, 0x9f, 0xe9, 0xd7, 0xef,
+    0x7e, 0xb6, 0xbb, 0x1d, 0xfd, 0xd3, 0xed, 0x5e, 0xf3, 0xfb, 0xaf, 0xf5, 0x9e, 0xef, 0x7c, 0xb7,
+    0xd3, 0xbf, 0xd9, 0xd9, 0x6f, 0x6e, 0xf7, 0xaa, 0xb7, 0x7d, 0xdf, 0xe6, 0x3e, 0xd7, 0xfb, 0xbb,
+    0xed, 0x5f, 0xae, 0x7e, 0x65, 0xf3, 0xb7, 0xfd, 0xde, 0xab, 0x5e, 0xe7, 0xfb, 0xbc, 0x7d, 0x5d,
+    0xef, 0x66, 0xf7, 0xdb, 0xbb, 0xfc, 0x8f, 0xcf, 0x3e, 0xf3, 0x79, 0x3f, 0xf5, 0xdf, 0xcf, 0x72,
+    0xf7, 0xeb, 0xbe, 0xbc, 0xdf, 0x6d, 0x7a, 0xf5, 0x7b, 0x9f, 0xf9, 0xcf, 0xe7, 0x7e, 0xb6, 0xfa,
+    0x3d, 0xdd, 0xd7, 0xeb, 0x5c, 0x73, 0xfb, 0xaf, 0xed, 0x96, 0xef, 0x7c, 0xf6, 0xb3, 0x9f, 0xdd,
+    0xdb, 0xed, 0x6e, 0xf7, 0xba, 0xaf, 0x75, 0xdf, 0xe7, 0x7e, 0x97, 0xdb, 0xbf, 0xe9, 0xdd, 0x2e,
+    0x7e, 0x75, 0xeb, 0xb7, 0xfd, 0xdf, 0xea, 0x3e, 0xc7, 0xfb, 0xba, 0xfd, 0x5d, 0xef, 0x76, 0xe7,
+    0xd3, 0xbb, 0xfd, 0xce, 0xaf, 0x1e, 0xf7, 0x79, 0xbd, 0x75, 0xdf, 0xcf, 0x6a, 0xf7, 0xeb, 0xbf,
+    0xbc, 0x9f, 0x4d, 0x7e, 0xf3, 0xf9, 0x1f, 0xf9, 0xdf, 0xef, 0x76, 0xb6, 0xfb, 0x3c, 0xbd, 0xd7,
+    0xef, 0x5a, 0xf1, 0x7b, 0xaf, 0xfd, 0x8e, 0xe7, 0x7c, 0xf7, 0xf2, 0xbf, 0xdd, 0xdb, 0xeb, 0x6c,
+    0x77, 0xba, 0xbf, 0x6d, 0xd7, 0xe7, 0x7e, 0xd6, 0xbb, 0x9f, 0xed, 0xdb, 0xac, 0x7e, 0x75, 0xfb,
+    0xa7, 0xf5, 0xdf, 0xeb, 0x7e, 0xa7, 0xdb, 0xbe, 0xf9, 0x5d, 0x6f, 0x76, 0xf7, 0xcb, 0xb3, 0xfd,
+    0xcf, 0xee, 0x3e, 0xd7, 0x79, 0xbb, 0xf5, 0x5f, 0xcf, 0x7a, 0xe7, 0xe3, 0xbf, 0xbc, 0xde, 0x2d,
+    0x5e, 0xf7, 0xfb, 0x9d, 0x79, 0xdf, 0xef, 0x6e, 0xb6, 0xfb, 0x3d, 0xfc, 0x97, 0xcf, 0x5e, 0xf3,
+    0xf9, 0x2f, 0xfd, 0x9e, 0xef, 0x74, 0xf7, 0xf3, 0xbe, 0x9d, 0xdb, 0xef, 0x6a, 0xf5, 0x3a, 0xbf,
+    0x7d, 0xcf, 0xe7, 0x7e, 0xd7, 0xfa, 0xbf, 0xcd, 0xdf, 0xaa, 0x7c, 0x75, 0xfb, 0xb7, 0xed, 0xd7,
+    0xeb, 0x7e, 0xe6, 0xbb, 0x9e, 0xfd, 0x59, 0xed, 0x76, 0xf7, 0xdb, 0xab, 0xf5, 0xcf, 0xef, 0x3e,
+    0xb7, 0x59, 0xbf, 0xf1, 0xdd, 0x4f, 0x7a, 0xf7, 0xeb, 0xb7, 0xbc, 0xdf, 0x6c, 0x3e, 0xd7, 0xfb,
+    0x9b, 0xf9, 0x5f, 0xef, 0x7e, 0xa6, 0xf3, 0x3d, 0xfd, 0xd6, 0xaf, 0x5e, 0xf3, 0xfb, 0xad, 0x7d,
+    0x9e, 0xef, 0x6c, 0xf7, 0xf3, 0xbf, 0xdc, 0x9b, 0xcf, 0x6e, 0xf3, 0xb8, 0x3f, 0x7d, 0xdf, 0xe7,
+    0x76, 0xd7, 0xfb, 0xbe, 0xad, 0xdf, 0xae, 0x7a, 0x75, 0x7b, 0xb7, 0xfd, 0xcf, 0xe3, 0x7e, 0xe7,
+    0xfa, 0xbe, 0xdd, 0x5d, 0xeb, 0x74, 0x77, 0xdb, 0xbb, 0xed, 0xc7, 0xef, 0x3e, 0xf6, 0x39, 0x9f,
+    0xf5, 0xdb, 0xcd, 0x7a, 0xf7, 0xeb, 0xaf, 0xb4, 0xdf, 0x6d, 0x7e, 0xb7, 0xdb, 0x9f, 0xf9, 0xdd,
+    0x6f, 0x7e, 0xb6, 0xeb, 0x35, 0xfd, 0xd7, 0xee, 0x1e, 0xd3, 0xfb, 0xab, 0xfd, 0x1e, 0xef, 0x7c,
+    0xe7, 0xf3, 0xbf, 0xdd, 0xda, 0xaf, 0x4e, 0xf7, 0xba, 0xbd, 0x7d, 0xdf, 0xe7, 0x6e, 0xd7, 0xfb,
+    0xbf, 0xec, 0x9f, 0x8e, 0x7e, 0x71, 0xf9, 0x37, 0xfd, 0xdf, 0xeb, 0x76, 0xe7, 0xfb, 0xbe, 0xbd,
+    0x5d, 0xef, 0x72, 0xf5, 0x5b, 0xbb, 0xfd, 0xcf, 0xe7, 0x3e, 0xf7, 0x78, 0xbf, 0xd5, 0xdf, 0xcb,
+    0x78, 0x77, 0xeb, 0xbf, 0xac, 0xd7, 0x6d, 0x7e, 0xf6, 0xbb, 0x9f, 0xf9, 0xdb, 0xed, 0x7e, 0xb6,
+    0xfb, 0x2d, 0xf5, 0xd7, 0xef, 0x5e, 0xb3, 0xdb, 0xaf, 0xf9, 0x9c, 0x6f, 0x7c, 0xf7, 0xe3, 0xb7,
+    0xdd, 0xdb, 0xee, 0x2e, 0xd7, 0xba, 0xbb, 0x7d, 0x5f, 0xe7, 0x7e, 0xc7, 0xf3, 0xbf, 0xed, 0xde,
+    0xae, 0x5e, 0x75, 0xfb, 0xb5, 0x7d, 0xdf, 0xeb, 0x6e, 0xe7, 0xfb, 0xbe, 0xfc, 0x1d, 0xcf, 0x76,
+    0xf3, 0xd9, 0x3b, 0xfd, 0xcf, 0xef, 0x36, 0xf7, 0x79, 0xbe, 0xb5, 0xdf, 0xcf, 0x7a, 0xf5, 0x6b,
+    0xbf, 0xbc, 0xcf, 0x65, 0x7e, 0xf7, 0xfa, 0x9f, 0xd9, 0xdf, 0xeb, 0x7c, 0x36, 0xfb, 0x3d, 0xed,
+    0xd7, 0xef, 0x5e, 0xf2, 0xbb, 0x8f, 0xfd, 0x9a, 0xed, 0x7c, 0xf7, 0xf3, 0xaf, 0xd5, 0xdb, 0xef,
+    0x6e, 0xb7, 0x9a, 0xbf, 0x79, 0xdd, 0x67, 0x7e, 0xd7, 0xeb, 0xb7, 0xed, 0xdf, 0xae, 0x3e, 0x55,
+    0xfb, 0xb3, 0xfd, 0x5f, 0xeb, 0x7e, 0xe7, 0xf3, 0xbe, 0xfd, 0x5c, 0xaf, 0x56, 0xf7, 0xdb, 0xb9,
+    0x7d, 0xcf, 0xef, 0x2e, 0xf7, 0x79, 0xbf, 0xf4, 0x9f, 0xcf, 0x7a, 0xf3, 0xe9, 0x3f, 0xbc, 0xdf,
+    0x6d, 0x76, 0xf7, 0xfb, 0x9e, 0xb9, 0xdf, 0xef, 0x7a, 0xb4, 0x7b, 0x3d, 0xfd, 0xc7, 0xe7, 0x5e,
+    0xf3, 0xfa, 0xaf, 0xdd, 0x9e, 0xeb, 0x7c, 0x77, 0xf3, 0xbf, 0xcd, 0xd3, 0xef, 0x6e, 0xf6, 0xba,
+    0x9f, 0x7d, 0xdb, 0xe5, 0x7e, 0xd7, 0xfb, 0xaf, 0xe5, 0xdf, 0xae, 0x7e, 0x35, 0xdb, 0xb7, 0xf9,
+    0xdd, 0x6b, 0x7e, 0xe7, 0xeb, 0xb6, 0xfd, 0x5d, 0xee, 0x36, 0xd7, 0xdb, 0xbb, 0xfd, 0x4f, 0xef,
+    0x3e, 0xe7, 0x71, 0xbf, 0xf5, 0xde, 0x8f, 0x5a, 0xf7, 0xeb, 0xbd, 0x3c, 0xdf, 0x6d, 0x6e, 0xf7,
+    0xfb, 0x9f, 0xf8, 0x9f, 0xcf, 0x7e, 0xb2, 0xf9, 0x3d, 0xfd, 0xd7, 0xef, 0x56, 0xf3, 0xfb, 0xae,
+    0xbd, 0x9e, 0xef, 0x78, 0xf5, 0x73, 0xbf, 0xdd, 0xcb, 0xe7, 0x6e, 0xf7, 0xba, 0xbf, 0x5d, 0xdf,
+    0xe3, 0x7c, 0x57, 0xfb, 0xbf, 0xed, 0xd7, 0xae, 0x7e, 0x74, 0xbb, 0x97, 0xfd, 0xdb, 0xe9, 0x7e,
+    0xe7, 0xfb, 0xae, 0xf5, 0x5d, 0xef, 0x76, 0xb7, 0xdb, 0xbb, 0xf9, 0xcd, 0x6f, 0x3e, 0xf7, 0x69,
+    0xb7, 0xf5, 0xdf, 0xce, 0x3a, 0xd7, 0xeb, 0xbb, 0xbc, 0x5f, 0x6d, 0x7e, 0xe7, 0xf3, 0x9f, 0xf9,
+    0xde, 0xaf, 0x5e, 0xb6, 0xfb, 0x3d, 0x7d, 0xd7, 0xef, 0x4e, 0xf3, 0xfb, 0xaf, 0xfc, 0x9e, 0xcf,
+    0x7c, 0xf3, 0xf1, 0x3f, 0xdd, 0xdb, 0xef, 0x66, 0xf7, 0xba, 0xbe, 0x3d, 0xdf, 0xe7, 0x7a, 0xd5,
+    0x7b, 0xbf, 0xed, 0xcf, 0xa6, 0x7e, 0x75, 0xfa, 0xb7, 0xdd, 0xdf, 0xeb, 0x7c, 0x67, 0xfb, 0xbe,
+    0xed, 0x55, 0xef, 0x76, 0xf6, 0x9b, 0x9b, 0xfd, 0xcb, 0xed, 0x3e, 0xf7, 0x79, 0xaf, 0xf5, 0xdf,
+    0xcf, 0x7a, 0xb7, 0xcb, 0xbf, 0xb8, 0xdd, 0x6d, 0x7e, 0xf7, 0xeb, 0x97, 0xf9, 0xdf, 0xee, 0x3e,
+    0x96, 0xfb, 0x39, 0xfd, 0x57, 0xef, 0x5e, 0xe3, 0xf3, 0xaf, 0xfd, 0x9e, 0xaf, 0x5c, 0xf7, 0xf3,
+    0xbd, 0x5d, 0xdb, 0xef, 0x6e, 0xf7, 0xba, 0xbf, 0x7c, 0x9f, 0xc7, 0x7e, 0xd3, 0xf9, 0x3f, 0xed,
+    0xdf, 0xae, 0x76, 0x75, 0xfb, 0xb6, 0xbd, 0xdf, 0xeb, 0x7a, 0xe5, 0x7b, 0xbe, 0xfd, 0x4d, 0xe7,
+    0x76, 0xf7, 0xda, 0xbb, 0xdd, 0xcf, 0xeb, 0x3c, 0x77, 0x79, 0xbf, 0xe5, 0xd7, 0xcf, 0x7a, 0xf6,
+    0xab, 0x9f, 0xbc, 0xdb, 0x6d, 0x7e, 0xf7, 0xfb, 0x8f
+};
+
 void
-n_primes_sieve_range(n_primes_t iter, mp_limb_t a, mp_limb_t b)
+_n_sieve_wheel30(unsigned char * sieve, ulong low, slong len,
+    const unsigned int * primes, slong num_primes)
 {
-    mp_limb_t bound;
-    ulong len, odd_len;
+    ulong p, k, kmin, high, n, i, off;
+    slong j, b;
+    unsigned char mask;
 
-    /* a and b must be odd */
-    a += (a % 2 == 0);
-    b -= (b % 2 == 0);
+    /* copy the presieved pattern */
+    off = (low / 30) % WHEEL30_PATTERN_LEN;
+    for (i = 0; i < (ulong) len; )
+    {
+        n = FLINT_MIN(WHEEL30_PATTERN_LEN - off, len - i);
+        memcpy(sieve + i, wheel30_pattern + off, n);
+        i += n;
+        off = 0;
+    }
 
-    len = b - a + 2;
-    odd_len = len / 2;
+    /* last number represented by the sieve */
+    high = low + 30 * (ulong) len - 1;
 
-    if (a < 3 || b < a || len > FLINT_SIEVE_SIZE)
+    for (b = 0; b < num_primes; b++)
+    {
+        p = primes[b];
+
+        if (p <= 13)
+            continue;
+
+        if (p > high / p)
+            break;
+
+        kmin = FLINT_MAX(p, (low + p - 1) / p);
+
+        /* multiples p k with k in a fixed residue class mod 30 all lie on
+           the same bit, p bytes apart */
+        for (j = 0; j < 8; j++)
+        {
+            k = kmin + (flint_wheel30_residues[j] + 30 - kmin % 30) % 30;
+
+            if (k > high / p)
+                continue;
+
+            n = p * k;
+            mask = ~(UWORD(1) << wheel30_bit[n % 30]);
+
+            for (i = (n - low) / 30; i < (ulong) len; i += p)
+                sieve[i] &= mask;
+        }
+    }
+
+    /* 1 is not prime, while 7, 11 and 13 were removed by the pattern */
+    if (low == 0 && len > 0)
+        sieve[0] = (sieve[0] & 0xf0) | 0x0e;
+}
+
+void
+n_primes_sieve_range(n_primes_t iter, mp_limb_t a, mp_limb_t b)
+{
+    mp_limb_t low, bound, r;
+    slong len, num;
+
+    low = a - a % 30;
+    len = (b - low) / 30 + 1;
+
+    if (a < 7 || b < a || len > FLINT_SIEVE_MAX_BYTES)
     {
         flint_printf("invalid sieve range %wu,%wu!\n", a, b);
         flint_abort();
@@ -79,13 +211,26 @@ n_primes_sieve_range(n_primes_t iter, mp_limb_t a, mp_limb_t b)
     bound = n_sqrt(b) + 1;
 
     if (iter->sieve == NULL)
-        iter->sieve = flint_malloc(FLINT_SIEVE_SIZE / 2 * sizeof(char));
+        iter->sieve = flint_malloc(FLINT_SIEVE_MAX_BYTES * sizeof(unsigned char));
 
     n_primes_extend_small(iter, bound);
-    n_sieve_odd(iter->sieve, len, a, iter->small_primes, bound);
+
+    for (num = 0; iter->small_primes[num] <= bound; num++)
+        ;
+
+    _n_sieve_wheel30(iter->sieve, low, len, iter->small_primes, num);
+
+    /* clear the numbers outside [a, b] in the end bytes */
+    for (r = 0; r < a - low; r++)
+        if (wheel30_bit[r] != 8)
+            iter->sieve[0] &= ~(1 << wheel30_bit[r]);
+
+    for (r = b - (low + 30 * (len - 1)) + 1; r < 30; r++)
+        if (wheel30_bit[r] != 8)
+            iter->sieve[len - 1] &= ~(1 << wheel30_bit[r]);
 
     iter->sieve_i = 0;
-    iter->sieve_num = odd_len;
-    iter->sieve_a = a;
+    iter->sieve_num = len;
+    iter->sieve_a = low;
     iter->sieve_b = b;
 }
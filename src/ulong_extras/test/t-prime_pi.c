@@ -15,6 +15,10 @@
 int main(void)
 {
     int n;
+    slong iter;
+    ulong x, p;
+    const ulong pi_pow10[] = { 0, 4, 25, 168, 1229, 9592, 78498, 664579,
+        5761455, 50847534, UWORD(455052511) };
 
     FLINT_TEST_INIT(state);
 
@@ -43,6 +47,51 @@ int main(void)
         }
     }
 
+    /* combinatorial method against the table */
+    for (iter = 0; iter < 200 * FLINT_MIN(10, flint_test_multiplier()); iter++)
+    {
+        x = 64 + n_randint(state, FLINT_PRIME_PI_LMO_CUTOFF - 64);
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        if (_n_prime_pi_lmo(x) != n_prime_pi(x))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("x = %wu, lmo = %wu, table = %wu\n", x,
+                _n_prime_pi_lmo(x), n_prime_pi(x));
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    for (n = 1; n <= (FLINT64 ? 10 : 9); n++)
+    {
+        x = n_pow(10, n);
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        if (n_prime_pi(x) != pi_pow10[n])
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("pi(10^%d) = %wu\n", n, n_prime_pi(x));
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    /* nth prime above the table cutoff */
+    for (iter = 0; iter < 20 * FLINT_MIN(10, flint_test_multiplier()); iter++)
+    {
+        x = FLINT_PRIME_PI_LMO_CUTOFF / 16 + n_randint(state, UWORD(1) << 22);
+        p = n_nth_prime(x);
+
+        if (!n_is_prime(p) || n_prime_pi(p) != x)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wu, p_n = %wu\n", x, p);
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
     FLINT_TEST_CLEANUP(state);
     flint_printf("PASS\n");
     return 0;
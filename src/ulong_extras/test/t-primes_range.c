@@ -0,0 +1,87 @@
+/*
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    slong iter;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("primes_range....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 300 * flint_test_multiplier(); iter++)
+    {
+        ulong a, b, p, r, * res;
+        slong i, num;
+
+        r = n_randint(state, 100);
+
+        if (r == 0)
+        {
+            /* several sieve segments, split between threads */
+            a = n_randint(state, UWORD(1) << 30);
+            b = a + (UWORD(1) << 21) + n_randint(state, UWORD(1) << 21);
+        }
+        else if (r < 34)
+        {
+            a = n_randint(state, 100);
+            b = a + n_randint(state, 100);
+        }
+        else if (r < 67)
+        {
+            a = n_randint(state, UWORD(1) << 24);
+            b = a + n_randint(state, UWORD(1) << 18);
+        }
+        else
+        {
+            a = n_randtest_bits(state, 1 + n_randint(state, FLINT_BITS - 20));
+            b = a + n_randint(state, UWORD(1) << 16);
+        }
+
+        flint_set_num_threads(1 + n_randint(state, 5));
+
+        res = n_primes_range(&num, a, b);
+
+        /* check against n_is_prime and n_nextprime, which do not use the
+           sieve: consecutive entries are consecutive primes, and the first
+           and last entries are the extreme primes in [a, b] */
+        p = (a == 0) ? 2 : n_nextprime(a - 1, 1);
+
+        for (i = 0; i < num; i++)
+        {
+            if (res[i] != p || !n_is_prime(res[i]) || res[i] < a || res[i] > b)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("a = %wu, b = %wu, i = %wd, res[i] = %wu, p = %wu\n", a, b, i, res[i], p);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            p = n_nextprime(p, 1);
+        }
+
+        if (p <= b)
+        {
+            flint_printf("FAIL (count):\n");
+            flint_printf("a = %wu, b = %wu, num = %wd, missing p = %wu\n", a, b, num, p);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(res);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}